@@ -0,0 +1,78 @@
+// Collision benchmark
+// Times point and pair tests of every Collidable type.
+#include <Ace/Ace.h>
+
+#include <Ace/Collidable.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace ace;
+
+static const UInt32 Count = 256u;
+
+template <typename ShapeType>
+void Benchmark(const char* name, const std::vector<ShapeType>& shapes)
+{
+    const float frequency = static_cast<float>(Time::GetPerformanceFrequency());
+    UInt32 hits = 0u;
+
+    UInt64 start = Time::GetPerformanceCounter();
+    for (const auto& shape : shapes)
+    {
+        for (UInt32 i = 0u; i < Count; ++i)
+        {
+            hits += shape.IsColliding(Vector2(i * 0.25f - 32.f, (i % 16u) * 0.5f - 4.f)) ? 1u : 0u;
+        }
+    }
+    const float pointTime = (Time::GetPerformanceCounter() - start) / frequency;
+
+    start = Time::GetPerformanceCounter();
+    for (const auto& a : shapes)
+    {
+        for (const auto& b : shapes)
+        {
+            hits += Collidable::IsColliding(a, b) ? 1u : 0u;
+        }
+    }
+    const float pairTime = (Time::GetPerformanceCounter() - start) / frequency;
+
+    const float tests = static_cast<float>(Count * Count);
+    std::cout << name
+        << ": point " << (pointTime / tests) * 1e9f << " ns"
+        << ", pair " << (pairTime / tests) * 1e9f << " ns"
+        << " (" << hits << " hits)\n";
+}
+
+int main(int, char**)
+{
+    ace::Init();
+
+    std::vector<Circle> circles;
+    std::vector<Rectangle> rectangles;
+    std::vector<Triangle> triangles;
+    std::vector<Polygon> polygons;
+
+    const Vector2 triangle[3]{ { -1.f, -1.f }, { 1.f, -1.f }, { 0.f, 1.f } };
+    const std::vector<Vector2> hexagon{
+        { 1.f, 0.f }, { 0.5f, 0.87f }, { -0.5f, 0.87f }, { -1.f, 0.f }, { -0.5f, -0.87f }, { 0.5f, -0.87f }
+    };
+
+    for (UInt32 i = 0u; i < Count; ++i)
+    {
+        const Vector2 position(i * 0.25f - 32.f, (i % 16u) * 0.5f - 4.f);
+        const Matrix2 rotation(Matrix2::Rotation(i * 7.f));
+        circles.emplace_back(1.f, position);
+        rectangles.emplace_back(Vector2(1.f, 0.5f), position, rotation);
+        triangles.emplace_back(triangle, position, rotation);
+        polygons.emplace_back(hexagon, position, rotation);
+    }
+
+    Benchmark("Circle", circles);
+    Benchmark("Rectangle", rectangles);
+    Benchmark("Triangle", triangles);
+    Benchmark("Polygon", polygons);
+
+    ace::Quit();
+    return 0;
+}
@@ -0,0 +1,67 @@
+// Texture load benchmark
+// Compares loading sprite atlases from PNG against baked textures.
+//
+// Bake the atlases first, then pass both versions:
+//   acetex atlas.png atlas.acetex
+//   TextureLoadBenchmark atlas.png atlas.acetex
+#include <Ace/Ace.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ace;
+
+static const UInt32 Rounds = 8u;
+
+// Loads every file once per round, returns the average time of a round in milliseconds.
+static float Benchmark(const std::vector<std::string>& paths)
+{
+    const float frequency = static_cast<float>(Time::GetPerformanceFrequency());
+
+    const UInt64 start = Time::GetPerformanceCounter();
+    for (UInt32 round = 0u; round < Rounds; ++round)
+    {
+        for (const auto& path : paths)
+        {
+            Texture texture(File(Path(path, true)));
+        }
+    }
+    return (Time::GetPerformanceCounter() - start) / frequency / Rounds * 1000.f;
+}
+
+int main(int argc, char** argv)
+{
+    ace::Init();
+
+    // The uploads need a context.
+    ace::Window window("TextureLoadBenchmark", 64, 64);
+
+    std::vector<std::string> images;
+    std::vector<std::string> baked;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        (Texture::IsBaked(Path(argv[i], true)) ? baked : images).push_back(argv[i]);
+    }
+
+    if (images.empty() && baked.empty())
+    {
+        std::cout << "Usage: TextureLoadBenchmark <atlas.png>... <atlas.acetex>...\n";
+        ace::Quit();
+        return 1;
+    }
+
+    const float imageTime = Benchmark(images);
+    const float bakedTime = Benchmark(baked);
+
+    std::cout << "Decoded: " << images.size() << " files, " << imageTime << " ms\n";
+    std::cout << "Baked:   " << baked.size() << " files, " << bakedTime << " ms\n";
+    if (bakedTime > 0.f)
+    {
+        std::cout << "Speedup: " << imageTime / bakedTime << "x\n";
+    }
+
+    ace::Quit();
+    return 0;
+}
@@ -1,10 +1,13 @@
 #include <Ace/Accelerometer.h>
 #include <Ace/Animation.h>
+#include <Ace/AssetCache.h>
+#include <Ace/AssetLoader.h>
 #include <Ace/Audio.h>
 #include <Ace/BaseComponent.h>
 #include <Ace/Camera.h>
 #include <Ace/Event.h>
 #include <Ace/Font.h>
+#include <Ace/GlyphAtlas.h>
 #include <Ace/GraphicsDevice.h>
 #include <Ace/Image.h>
 #include <Ace/IntTypes.h>
@@ -13,10 +16,12 @@
 #include <Ace/Module.h>
 #include <Ace/Mouse.h>
 #include <Ace/Platform.h>
+#include <Ace/Snapshot.h>
 #include <Ace/Sprite.h>
 #include <Ace/SpriteManager.h>
 #include <Ace/SpriteSheet.h>
 #include <Ace/StandardMaterial.h>
+#include <Ace/TextBatch.h>
 #include <Ace/Time.h>
 #include <Ace/Touch.h>
 #include <Ace/UserInterface.h>
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Ace/ArchiveFormat.h>
+#include <Ace/File.h>
+#include <Ace/IntTypes.h>
+#include <Ace/Path.h>
+
+#include <string>
+
+namespace ace
+{
+
+    /**
+        @brief Mounted packed asset archives, built with the acepack tool.
+        Once mounted, File resolves read-only paths inside the archive before the file system.
+        Entries are relative to the base path, e.g. Path("assets/a.png") finds "assets/a.png".
+        Later mounts take precedence, so a patch archive can override entries.
+        Mount at startup, lookups are not synchronized with mounting.
+    */
+    class Archive final
+    {
+    public:
+
+        /**
+            @brief Mounts an archive. The file is memory mapped where possible and stays mapped until unmounted.
+            @param[in] path Path of the archive.
+            @return True if the archive is valid.
+        */
+        static bool Mount(const Path& path);
+
+        /**
+            @brief Unmounts every archive. Views returned by Find stay valid.
+        */
+        static void UnmountAll();
+
+        /**
+            @param[in] path Full path, as returned by Path::GetPath.
+            @return True if a mounted archive contains the path.
+        */
+        static bool Contains(const std::string& path);
+
+        /**
+            @brief Looks up a path from the mounted archives.
+            Uncompressed entries point straight into the archive mapping, compressed ones are decompressed.
+            @param[in] path Full path, as returned by Path::GetPath.
+            @return View of the entry, empty if not found.
+        */
+        static File::View Find(const std::string& path);
+
+        /**
+            @return Number of mounted archives.
+        */
+        static UInt32 GetMountCount();
+
+    private:
+
+        Archive() = delete;
+    };
+
+}
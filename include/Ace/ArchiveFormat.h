@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Ace/IntTypes.h>
+
+namespace ace
+{
+    /**
+        On-disk layout of a packed asset archive, shared by the engine and the acepack tool.
+        All fields are little endian, offsets are from the start of the archive.
+
+        ArchiveHeader
+        UInt32 buckets[bucketCount]     Open addressed hash table, entry index + 1 or 0 when empty.
+        ArchiveEntry entries[entryCount]
+        char names[namesSize]           Relative paths with '/' separators, not null terminated.
+        blobs                           Each aligned to ArchiveAlignment.
+    */
+
+    static const UInt32 ArchiveMagic = 0x50454341u; // "ACEP"
+    static const UInt32 ArchiveVersion = 1u;
+    static const UInt32 ArchiveAlignment = 16u;
+
+    enum ArchiveFlags : UInt32
+    {
+        ArchiveNone = 0u,
+        ArchiveLZ4 = 1u << 0u,  /** Blob is a single LZ4 block, size is the decompressed size. */
+    };
+
+    struct ArchiveHeader final
+    {
+        UInt32 magic;
+        UInt32 version;
+        UInt32 entryCount;
+        UInt32 bucketCount;     /** Power of two. */
+        UInt32 namesOffset;
+        UInt32 namesSize;
+        UInt32 reserved[2];
+    };
+
+    struct ArchiveEntry final
+    {
+        UInt32 hash;
+        UInt32 nameOffset;
+        UInt32 nameLength;
+        UInt32 offset;
+        UInt32 size;
+        UInt32 packedSize;
+        UInt32 flags;
+        UInt32 reserved;
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 32u, "ArchiveHeader layout changed");
+    static_assert(sizeof(ArchiveEntry) == 32u, "ArchiveEntry layout changed");
+
+    /**
+        @brief FNV-1a hash of an archive path.
+    */
+    inline UInt32 ArchiveHash(const char* path, const UInt32 length)
+    {
+        UInt32 hash = 2166136261u;
+        for (UInt32 i = 0u; i < length; ++i)
+        {
+            hash = (hash ^ static_cast<UInt8>(path[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+}
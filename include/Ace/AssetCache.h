@@ -0,0 +1,152 @@
+#pragma once
+
+#include <Ace/IntTypes.h>
+#include <Ace/Path.h>
+
+#include <memory>
+#include <string>
+
+namespace ace
+{
+    class AudioClip;
+    class Font;
+    class Image;
+    class SpriteSheet;
+    struct Texture;
+
+    /**
+        @brief Shared registry of decoded assets.
+        Assets are keyed by type and interned, normalized path, so the same file requested from
+        several places is decoded and uploaded once. Entries only referenced by the cache are
+        evicted least recently used first when the cache grows over its memory budget.
+        Thread safe, except that Texture misses must be resolved on the render thread.
+    */
+    class AssetCache final
+    {
+    public:
+
+        typedef UInt32 PathID;
+
+        struct Stats final
+        {
+            UInt32 hits;
+            UInt32 misses;
+            UInt32 evictions;
+            UInt32 entries;
+            UInt64 bytes;
+
+            Stats();
+        };
+
+        /**
+            @brief Normalizes the path (separators, "." and "..") and interns it.
+            @return ID shared by every spelling of the same path.
+        */
+        static PathID Intern(const std::string& path);
+
+        /**
+            @return Normalized path of an interned ID.
+        */
+        static std::string GetPath(const PathID id);
+
+        /**
+            @brief Returns the cached asset, loading it on a miss.
+            Supported types: Image, Texture, SpriteSheet, Font and AudioClip.
+            @param[in] path Path of the asset file.
+            @return Shared asset, never null.
+        */
+        template <typename AssetType>
+        static std::shared_ptr<AssetType> Get(const Path& path);
+
+        /**
+            @return Cached asset or null. Does not load.
+        */
+        template <typename AssetType>
+        static std::shared_ptr<AssetType> Find(const Path& path);
+
+        /**
+            @brief Sets the approximate memory the cache may hold on to, 256MB by default.
+            Assets still referenced outside the cache are never evicted.
+        */
+        static void SetBudget(const UInt64 bytes);
+
+        static UInt64 GetBudget();
+
+        /**
+            @brief Evicts least recently used entries until under budget. Called by ace::Update.
+        */
+        static void Update();
+
+        /**
+            @brief Drops every entry. Assets still referenced elsewhere stay alive. Called by ace::Quit.
+        */
+        static void Clear();
+
+        static Stats GetStats();
+
+        static void ResetStats();
+
+    private:
+
+        template <typename AssetType>
+        static UInt32 TypeID()
+        {
+            static const UInt32 id = NextTypeID();
+            return id;
+        }
+
+        template <typename AssetType>
+        static std::shared_ptr<AssetType> Create(const Path& path);
+
+        template <typename AssetType>
+        static UInt64 SizeOf(const AssetType& asset);
+
+        static UInt32 NextTypeID();
+
+        /**
+            @return Cached entry or null. Moves the entry to the front of the LRU list.
+        */
+        static std::shared_ptr<void> FindEntry(const UInt32 type, const PathID path, const bool countStats);
+
+        /**
+            @return Inserted asset, or the one another thread inserted first.
+        */
+        static std::shared_ptr<void> InsertEntry(const UInt32 type, const PathID path, const std::shared_ptr<void>& asset, const UInt64 size);
+
+        AssetCache() = delete;
+    };
+
+    template <> std::shared_ptr<Image> AssetCache::Create<Image>(const Path& path);
+    template <> std::shared_ptr<Texture> AssetCache::Create<Texture>(const Path& path);
+    template <> std::shared_ptr<SpriteSheet> AssetCache::Create<SpriteSheet>(const Path& path);
+    template <> std::shared_ptr<Font> AssetCache::Create<Font>(const Path& path);
+    template <> std::shared_ptr<AudioClip> AssetCache::Create<AudioClip>(const Path& path);
+
+    template <> UInt64 AssetCache::SizeOf<Image>(const Image& asset);
+    template <> UInt64 AssetCache::SizeOf<Texture>(const Texture& asset);
+    template <> UInt64 AssetCache::SizeOf<SpriteSheet>(const SpriteSheet& asset);
+    template <> UInt64 AssetCache::SizeOf<Font>(const Font& asset);
+    template <> UInt64 AssetCache::SizeOf<AudioClip>(const AudioClip& asset);
+
+    template <typename AssetType>
+    std::shared_ptr<AssetType> AssetCache::Get(const Path& path)
+    {
+        const PathID id = Intern(path.GetPath());
+
+        std::shared_ptr<void> asset = FindEntry(TypeID<AssetType>(), id, true);
+        if (asset == nullptr)
+        {
+            // Loaded without holding the lock, a racing thread's copy wins on insert.
+            const std::shared_ptr<AssetType> created = Create<AssetType>(path);
+            asset = InsertEntry(TypeID<AssetType>(), id, created, SizeOf(*created));
+        }
+        return std::static_pointer_cast<AssetType>(asset);
+    }
+
+    template <typename AssetType>
+    std::shared_ptr<AssetType> AssetCache::Find(const Path& path)
+    {
+        return std::static_pointer_cast<AssetType>(FindEntry(TypeID<AssetType>(), Intern(path.GetPath()), false));
+    }
+
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <Ace/Audio.h>
+#include <Ace/Font.h>
+#include <Ace/Image.h>
+#include <Ace/IntTypes.h>
+#include <Ace/Macros.h>
+#include <Ace/Path.h>
+#include <Ace/SpriteSheet.h>
+#include <Ace/Texture.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace ace
+{
+
+    /**
+        @brief Handle to an asset loaded by the AssetLoader.
+        Cheap to copy, all copies refer to the same asset.
+    */
+    template <typename AssetType>
+    class AssetHandle final
+    {
+        friend class AssetLoader;
+
+        struct State
+        {
+            std::shared_ptr<AssetType> asset;
+            std::atomic<bool> ready;
+
+            State() : asset(), ready(false)
+            {
+
+            }
+        };
+
+        std::shared_ptr<State> m_state;
+
+    public:
+
+        AssetHandle() : m_state()
+        {
+
+        }
+
+        /**
+            @return True if the handle refers to a load request.
+        */
+        inline bool IsValid() const
+        {
+            return m_state != nullptr;
+        }
+
+        /**
+            @return True once the asset is loaded and, for GPU assets, uploaded.
+        */
+        inline bool IsReady() const
+        {
+            return m_state != nullptr && m_state->ready.load(std::memory_order_acquire);
+        }
+
+        /**
+            @brief Blocks until the asset is ready. Processes GPU uploads while waiting,
+            so it must be called from the render thread.
+        */
+        void Wait() const;
+
+        /**
+            @return True if the handle is ready without an asset, such as a load dropped by AssetLoader::Quit.
+        */
+        inline bool HasFailed() const
+        {
+            return IsReady() && m_state->asset == nullptr;
+        }
+
+        /**
+            @return Loaded asset. Must be ready and not failed.
+        */
+        inline AssetType& Get()
+        {
+            return *m_state->asset;
+        }
+
+        inline const AssetType& Get() const
+        {
+            return *m_state->asset;
+        }
+
+        inline operator bool() const
+        {
+            return IsReady();
+        }
+    };
+
+    /**
+        @brief Loads assets on background threads.
+        File reads and decoding run on a pool of worker threads. GPU uploads are queued for the
+        render thread and run from Update() within a per-frame time budget.
+    */
+    class AssetLoader final
+    {
+    public:
+
+        typedef std::function<void()> Job;
+
+        /**
+            @brief Starts the worker threads. Called by ace::Init.
+            @param[in] threads Number of workers, 0 uses one less than the number of CPU cores.
+        */
+        static void Init(UInt32 threads = 0u);
+
+        /**
+            @brief Finishes queued loads and stops the worker threads. Called by ace::Quit.
+            Pending GPU uploads are dropped, their handles become ready and failed.
+        */
+        static void Quit();
+
+        /**
+            @brief Runs queued GPU uploads until the budget is used. Called by ace::Update.
+            At least one upload runs per call so loading always progresses.
+        */
+        static void Update();
+
+        /**
+            @brief Sets the time Update() may spend on GPU uploads per frame.
+            @param[in] milliseconds Upload budget, 2ms by default.
+        */
+        static void SetUploadBudget(const float milliseconds);
+
+        /**
+            @return Number of loads not yet finished, including pending uploads.
+        */
+        static UInt32 GetPendingCount();
+
+        /**
+            @brief Blocks until every queued load is finished. Must be called from the render thread.
+        */
+        static void WaitAll();
+
+        /**
+            @brief Queues an asset load.
+            Supported types: Image, Texture, SpriteSheet, Font and AudioClip.
+            @param[in] path Path of the asset file.
+            @return Handle that becomes ready once the asset is loaded.
+        */
+        template <typename AssetType>
+        static AssetHandle<AssetType> Load(const Path& path);
+
+        /**
+            @brief Queues a job for the worker threads.
+        */
+        static void Run(const Job& job);
+
+        /**
+            @brief Queues a job for the render thread, run by Update().
+        */
+        static void RunOnRenderThread(const Job& job);
+
+    private:
+
+        template <typename> friend class AssetHandle;
+
+        /**
+            @brief Loads the asset on a worker and publishes it.
+        */
+        template <typename AssetType>
+        static AssetHandle<AssetType> Queue(const std::function<std::shared_ptr<AssetType>()>& load);
+
+        /**
+            @brief Decodes on a worker, then creates the asset from the decoded data on the render thread.
+        */
+        template <typename AssetType, typename DecodeType>
+        static AssetHandle<AssetType> Queue(const std::function<std::shared_ptr<DecodeType>()>& decode, const std::function<std::shared_ptr<AssetType>(const DecodeType&)>& upload);
+
+        /**
+            @brief Queues a job for the render thread, drop runs instead if Quit discards it.
+        */
+        static void RunOnRenderThread(const Job& job, const Job& drop);
+
+        static void Begin();
+        static void Finish();
+
+        /**
+            @brief Runs all queued uploads, sleeps briefly if there were none.
+        */
+        static void Pump();
+
+        AssetLoader() = delete;
+    };
+
+    template <> AssetHandle<Image> AssetLoader::Load<Image>(const Path& path);
+    template <> AssetHandle<Texture> AssetLoader::Load<Texture>(const Path& path);
+    template <> AssetHandle<SpriteSheet> AssetLoader::Load<SpriteSheet>(const Path& path);
+    template <> AssetHandle<Font> AssetLoader::Load<Font>(const Path& path);
+    template <> AssetHandle<AudioClip> AssetLoader::Load<AudioClip>(const Path& path);
+
+    template <typename AssetType>
+    void AssetHandle<AssetType>::Wait() const
+    {
+        while (m_state != nullptr && !IsReady())
+        {
+            AssetLoader::Pump();
+        }
+    }
+
+    template <typename AssetType>
+    AssetHandle<AssetType> AssetLoader::Queue(const std::function<std::shared_ptr<AssetType>()>& load)
+    {
+        AssetHandle<AssetType> handle;
+        handle.m_state = std::make_shared<typename AssetHandle<AssetType>::State>();
+
+        const auto state = handle.m_state;
+        Begin();
+        Run([state, load]()
+        {
+            state->asset = load();
+            state->ready.store(true, std::memory_order_release);
+            Finish();
+        });
+        return handle;
+    }
+
+    template <typename AssetType, typename DecodeType>
+    AssetHandle<AssetType> AssetLoader::Queue(const std::function<std::shared_ptr<DecodeType>()>& decode, const std::function<std::shared_ptr<AssetType>(const DecodeType&)>& upload)
+    {
+        AssetHandle<AssetType> handle;
+        handle.m_state = std::make_shared<typename AssetHandle<AssetType>::State>();
+
+        const auto state = handle.m_state;
+        Begin();
+        Run([state, decode, upload]()
+        {
+            const std::shared_ptr<DecodeType> decoded = decode();
+
+            RunOnRenderThread([state, decoded, upload]()
+            {
+                state->asset = upload(*decoded);
+                state->ready.store(true, std::memory_order_release);
+                Finish();
+            },
+            [state]()
+            {
+                // Ready without an asset, waiters return and see the load failed.
+                state->ready.store(true, std::memory_order_release);
+                Finish();
+            });
+        });
+        return handle;
+    }
+
+}
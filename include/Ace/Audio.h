@@ -11,6 +11,29 @@
 
 namespace ace
 {
+	/**
+	@brief When an AudioClip decodes its file.
+	Clips loaded from the same path share one decoded sample, whichever mode they use.
+	*/
+	enum class AudioDecode : UInt8
+	{
+		Immediate,		/** In the constructor, on the calling thread. */
+		Background,		/** On an AssetLoader worker, plays before it finishes start once it does. */
+		OnFirstPlay,	/** On an AssetLoader worker when the clip is first played. */
+	};
+
+	/**
+	@brief Where Audio plays clips.
+	Streams always play on OpenAL sources, so they are silent without a device.
+	*/
+	enum class AudioBackend : UInt8
+	{
+		OpenAL,		/** Every voice on its own OpenAL source. */
+		Mixer,		/** Clips mixed in software into one OpenAL stream, up to AudioMixer::MaxVoices at once. */
+		Null,		/** Clips mixed in software and discarded, without a device. For servers and tests. */
+		WavFile,	/** Clips mixed in software and written to a 16-bit stereo WAV file, without a device. */
+	};
+
 	class IAudioSample
 	{
 		friend class Audio;
@@ -28,7 +51,7 @@ namespace ace
 		float volume;
 		float pitch;
 		bool loop;
-		
+		UInt32 priority;
 
 	public:
 
@@ -85,15 +108,17 @@ namespace ace
 		bool IsPlaying();
 
 		/**
-		@brief Sets the priority of the specified clip.
+		@brief Sets the priority used by the next Play.
+		When every voice is taken, a new clip replaces the least audible voice of equal or lower priority,
+		or is not played at all. Streams default to 128, clips to 0.
 		*/
-		//void SetPriority(UInt32);
+		void SetPriority(UInt32 priority);
 
 		/**
 		@brief Returns the clip priority.
 		@return Priority
 		*/
-		//UInt32 GetPriority();
+		UInt32 GetPriority();
 
 		/**
 		@brief Sets  audio position for the specified source
@@ -118,7 +143,10 @@ namespace ace
 	public:
 
 		AudioClip();
-		AudioClip(const File& file, float volume = 1.0f, bool isPaused = true, bool loop = false);
+		/**
+		@brief Loads an Ogg Vorbis or PCM WAV clip. Stereo clips up to 5 seconds are mixed down to mono.
+		*/
+		AudioClip(const File& file, float volume = 1.0f, bool isPaused = true, bool loop = false, AudioDecode decode = AudioDecode::Immediate);
 
 
 		/**
@@ -127,6 +155,11 @@ namespace ace
 		*/
 		void Fade(float duration, float endVolume);
 
+		/**
+		@brief Limits how many instances of this clip play at once, 0 for no limit.
+		Playing one more replaces the oldest instance.
+		*/
+		void SetMaxInstances(UInt32 count);
 
 		virtual void Play();
 
@@ -186,15 +219,26 @@ namespace ace
 		}
 	};
 
+	/**
+		@brief Audio playback on its own thread.
+		Calls from the game thread are queued without locking and wake the audio thread, which sleeps while nothing plays.
+		Getters return the state the audio thread published last. Call it from a single game thread.
+	*/
 	class Audio
 	{
 		friend class AudioClip;
 	public:
 		/**
-			@brief Inits Audio.
+			@brief Inits Audio with the OpenAL backend.
 		*/
 		static void Init(bool = false);
 
+		/**
+			@brief Inits Audio.
+			@param[in] outputPath File the WavFile backend writes, ignored by the others.
+		*/
+		static void Init(AudioBackend backend, const char* outputPath = nullptr);
+
 		/**
 			@brief Quits Audio.
 		*/
@@ -218,6 +262,7 @@ namespace ace
 
 		/**
 			@brief Updates the all clips.
+			Called by the audio thread, applies the queued commands first.
 		*/
 		static void Update();
 
@@ -236,6 +281,26 @@ namespace ace
 		*/
 		static void PlayAudio(AudioStream& stream);
 
+		/**
+			@brief Starts the clip when the audio clock reaches time, for starts in step with music.
+			A start the audio thread reaches late skips the samples it missed, so it stays in phase.
+			@param[in] AudioClip&, time on the audio clock in seconds, see GetTime.
+		*/
+		static void PlayAudioAt(AudioClip& clip, double time);
+
+		/**
+			@brief Starts the stream when the audio clock reaches time.
+			@param[in] AudioStream&, time on the audio clock in seconds, see GetTime.
+		*/
+		static void PlayAudioAt(AudioStream& stream, double time);
+
+		/**
+			@brief Returns the audio clock, seconds since Init.
+			Independent of the game's frame time, fades and scheduled starts run on it.
+			@return Time
+		*/
+		static double GetTime();
+
 		/**
 			@brief Sets 3D audio position for the specified source.
 			@param[in] AudioClip&, Vector3 pos
@@ -269,18 +334,36 @@ namespace ace
 			@param[in] IAudioEffect
 		*/
 		static void AddEffect(IAudioEffect* effect);
-		
+
+		/**
+			@brief Voices farther than this from the listener are silent and do not hold an OpenAL source.
+			@param[in] distance
+		*/
+		static void SetCullDistance(float distance);
+
+		/**
+			@return Number of playing voices, audible or virtual.
+		*/
+		static UInt32 GetVoiceCount();
+
+		/**
+			@return Number of voices holding an OpenAL source.
+		*/
+		static UInt32 GetRealVoiceCount();
+
 
 	private:
 		
 		static Audio& GetAudio();
 
+		static void ProcessCommands();
+
 		ACE_DISABLE_COPY(Audio)
 
 		Audio();
 		~Audio();
 
-		std::vector<AudioClip> clips;
+		// Audio thread only.
 		std::vector<IAudioEffect*> effects;
 	
 	};
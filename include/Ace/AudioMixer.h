@@ -0,0 +1,153 @@
+#pragma once
+
+#include <Ace/IntTypes.h>
+
+#include <memory>
+#include <vector>
+
+namespace ace
+{
+
+    /**
+        @brief Decoded 16-bit PCM, mono or interleaved stereo. Shared by every voice playing it.
+    */
+    struct PCMBuffer final
+    {
+        std::vector<Int16> samples;
+        UInt32 frames;
+        UInt32 channels;
+        UInt32 frequency;
+
+        PCMBuffer() : samples(), frames(0u), channels(1u), frequency(44100u)
+        {
+
+        }
+    };
+
+    /**
+        @brief Software mixer behind the Mixer, Null and WavFile audio backends, also usable on its own.
+        Voices are resampled by pitch with linear interpolation, positional mono voices are panned and
+        attenuated relative to the listener, and gain changes are ramped over one block so fades do not click.
+        Mixing runs in float, four samples at a time with SSE2 or NEON where available. Not thread safe.
+    */
+    class AudioMixer final
+    {
+    public:
+
+        static const UInt32 MaxVoices = 256u;
+
+        /**
+            @brief Frames mixed per pass, gain ramps span one block.
+        */
+        static const UInt32 BlockFrames = 256u;
+
+        /**
+            @param[in] frequency Output sample rate.
+        */
+        explicit AudioMixer(UInt32 frequency = 44100u);
+
+        /**
+            @brief Starts a voice at the beginning of buffer.
+            @return Voice index, -1 if every voice is playing or the buffer is empty.
+        */
+        Int32 Play(const std::shared_ptr<const PCMBuffer>& buffer, float gain, float pitch, bool loop, bool paused = false);
+
+        void Stop(Int32 voice);
+
+        /**
+            @return True until the voice is stopped or reaches the end of a non-looping buffer.
+        */
+        bool IsPlaying(Int32 voice) const;
+
+        void SetPaused(Int32 voice, bool paused);
+
+        void SetGain(Int32 voice, float gain);
+
+        /**
+            @brief Pitches below 0.01, including negative ones, are raised to 0.01.
+        */
+        void SetPitch(Int32 voice, float pitch);
+
+        void SetLoop(Int32 voice, bool loop);
+
+        /**
+            @param[in] seconds Playback position in the buffer.
+        */
+        void SetElapsedTime(Int32 voice, double seconds);
+
+        double GetElapsedTime(Int32 voice) const;
+
+        /**
+            @brief Makes a mono voice positional. Stereo voices are never panned, like in OpenAL.
+            @param[in] position x, y and z in world units.
+        */
+        void SetPosition(Int32 voice, const float* position);
+
+        /**
+            @brief Positional voices are panned by their direction from the listener and
+            attenuated by inverse distance beyond one unit.
+        */
+        void SetListener(const float* position, const float* forward, const float* up);
+
+        void SetMasterGain(float gain);
+
+        /**
+            @brief Mixes the next frames of every playing voice.
+            @param[out] output frames * 2 interleaved stereo samples.
+        */
+        void Mix(Int16* output, UInt32 frames);
+
+        UInt32 GetFrequency() const;
+
+        /**
+            @return Number of playing voices, paused ones included.
+        */
+        UInt32 GetVoiceCount() const;
+
+    private:
+
+        struct Voice
+        {
+            std::shared_ptr<const PCMBuffer> buffer;
+            double position;    // In buffer frames.
+            float pitch;
+            float gain;
+            bool active;
+            bool paused;
+            bool loop;
+            bool positional;
+            float location[3];
+
+            // Per channel gains, ramped from current to target over a block.
+            float current[2];
+            float target[2];
+        };
+
+        Voice* Find(Int32 voice);
+        const Voice* Find(Int32 voice) const;
+
+        void UpdateTarget(Voice& voice) const;
+
+        /**
+            @brief Resamples up to frames of voice into m_scratch.
+            @return Frames written, fewer if a non-looping voice ended.
+        */
+        UInt32 Resample(Voice& voice, UInt32 frames);
+
+        void MixBlock(UInt32 frames);
+
+        UInt32 m_frequency;
+        UInt32 m_voiceCount;
+        float m_masterGain;
+
+        float m_listener[3];
+        float m_right[3];
+
+        std::vector<Voice> m_voices;
+
+        // Planar accumulators and resampled channels, BlockFrames each.
+        std::vector<float> m_mix[2];
+        std::vector<float> m_scratch[2];
+    };
+
+}
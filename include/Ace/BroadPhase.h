@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Ace/Collidable.h>
+#include <Ace/IntTypes.h>
+
+#include <vector>
+
+namespace ace
+{
+
+    /**
+        @brief Sort and sweep broad-phase.
+        Generates candidate pairs from overlapping AABBs. Layer masks, static and sleeping flags
+        are checked before the bounding boxes, so filtered pairs cost a couple of bit operations.
+    */
+    class BroadPhase final
+    {
+    public:
+
+        struct Pair final
+        {
+            Collidable* a;
+            Collidable* b;
+
+            /**
+                @brief Proxies returned by Add for a and b.
+            */
+            UInt32 proxyA;
+            UInt32 proxyB;
+        };
+
+        BroadPhase();
+        ~BroadPhase();
+
+        /**
+            @brief Adds a Collidable to the broad-phase.
+            @param[in, out] collidable Must outlive the broad-phase or be removed before destruction.
+            @param[in] updateAABB Computes the AABB immediately. Pass false if the caller keeps it up to date.
+            @return Proxy reported in pairs, counted from 0 after construction or Clear().
+            Lets callers index their own data without storing anything in the Collidable.
+        */
+        UInt32 Add(Collidable& collidable, bool updateAABB = true);
+
+        /**
+            @brief Removes a Collidable from the broad-phase. No effect if it was not added.
+        */
+        void Remove(Collidable& collidable);
+
+        /**
+            @brief Removes all Collidables and pairs.
+        */
+        void Clear();
+
+        /**
+            @brief Refreshes AABBs of awake Collidables and rebuilds the pair list.
+            @param[in] updateAABBs Pass false if the caller keeps the AABBs up to date.
+            @return Candidate pairs for the narrow-phase.
+        */
+        const std::vector<Pair>& Update(bool updateAABBs = true);
+
+        /**
+            @return Candidate pairs generated by the last Update().
+        */
+        inline const std::vector<Pair>& GetPairs() const
+        {
+            return m_pairs;
+        }
+
+        /**
+            @return Number of Collidables in the broad-phase.
+        */
+        inline UInt32 Size() const
+        {
+            return static_cast<UInt32>(m_collidables.size());
+        }
+
+    private:
+
+        struct Proxy final
+        {
+            Collidable* collidable;
+            UInt32 proxy;
+        };
+
+        std::vector<Proxy> m_collidables;
+        std::vector<Pair> m_pairs;
+        UInt32 m_nextProxy;
+
+    };
+
+}
@@ -9,15 +9,67 @@
 
 namespace ace
 {
+    class Image;
+
     using math::Matrix2;
     using math::Vector2;
 
+    /**
+        @brief Contact data produced by the narrow-phase.
+    */
+    struct Manifold final
+    {
+        /**
+            @brief Unit normal pointing from the first Collidable towards the second.
+        */
+        Vector2 normal;
+
+        /**
+            @brief Contact points in world space, valid up to count.
+        */
+        Vector2 points[2u];
+
+        /**
+            @brief Penetration depth of each contact point.
+        */
+        float depths[2u];
+
+        UInt8 count;
+
+        Manifold();
+    };
+
+    /**
+        @brief Concrete type of a Collidable, checked instead of casting in the narrow-phase.
+    */
+    enum class CollidableType : UInt8
+    {
+        Circle,
+        Rectangle,
+        Triangle,
+        Polygon
+    };
+
     struct Collidable
     {
+        /**
+            @brief Default collision layer, every Collidable belongs to it unless told otherwise.
+        */
+        static const UInt32 DefaultLayer = 1u << 0u;
 
-        Collidable(const Vector2& position, const Matrix2& rotation = Matrix2::Identity());
+        /**
+            @brief Mask that accepts all 32 collision layers.
+        */
+        static const UInt32 AllLayers = 0xFFFFFFFFu;
+
+        Collidable(CollidableType type, const Vector2& position, const Matrix2& rotation = Matrix2::Identity());
         virtual ~Collidable() = 0;
 
+        inline CollidableType GetType() const
+        {
+            return m_type;
+        }
+
 
         // Vector2 GetGlobalPosition() const;
         inline const Vector2& GetLocalPosition() const
@@ -40,6 +92,124 @@ namespace ace
         }
 
 
+        /**
+            @return Layer bits this Collidable belongs to.
+        */
+        inline UInt32 GetLayer() const
+        {
+            return m_layer;
+        }
+
+        /**
+            @brief Sets the layer bits this Collidable belongs to. Usually a single bit.
+            @param[in] layer Category bits, e.g. 1u << 3u.
+        */
+        inline void SetLayer(const UInt32 layer)
+        {
+            m_layer = layer;
+        }
+
+        /**
+            @return Layer bits this Collidable is tested against.
+        */
+        inline UInt32 GetMask() const
+        {
+            return m_mask;
+        }
+
+        /**
+            @brief Sets the layers this Collidable is tested against.
+            @param[in] mask Bitwise OR of the accepted layers. AllLayers by default.
+        */
+        inline void SetMask(const UInt32 mask)
+        {
+            m_mask = mask;
+        }
+
+        /**
+            @return True if the Collidable never moves.
+        */
+        inline bool IsStatic() const
+        {
+            return m_isStatic;
+        }
+
+        /**
+            @brief Marks the Collidable as static geometry. Static-vs-static pairs are never generated.
+            @warning Static Collidables don't refresh their AABB automatically, call UpdateAABB() after moving one.
+        */
+        inline void SetStatic(const bool isStatic)
+        {
+            m_isStatic = isStatic;
+        }
+
+        /**
+            @return True if the Collidable is sleeping.
+        */
+        inline bool IsSleeping() const
+        {
+            return m_isSleeping;
+        }
+
+        /**
+            @brief Puts the Collidable to sleep or wakes it up. Sleeping Collidables only pair with awake ones.
+        */
+        inline void SetSleeping(const bool isSleeping)
+        {
+            m_isSleeping = isSleeping;
+        }
+
+        /**
+            @return True if the Collidable is neither static nor sleeping.
+        */
+        inline bool IsAwake() const
+        {
+            return !m_isStatic && !m_isSleeping;
+        }
+
+        /**
+            @return User pointer, e.g. owner of the Collidable. Nullptr by default.
+        */
+        inline void* GetUserData() const
+        {
+            return m_userData;
+        }
+
+        /**
+            @brief Attaches a user pointer to the Collidable. Not owned.
+        */
+        inline void SetUserData(void* userData)
+        {
+            m_userData = userData;
+        }
+
+        /**
+            @return Bounding box computed by the last UpdateAABB() call.
+        */
+        inline const AABB& GetAABB() const
+        {
+            return m_aabb;
+        }
+
+        /**
+            @brief Recomputes the world space bounding box.
+        */
+        virtual void UpdateAABB();
+
+        /**
+            @brief Cheap pair filter, checked before any AABB or narrow-phase work.
+            @param[in] a An object derived from Collidable.
+            @param[in] b An object derived from Collidable.
+            @return True if the layers and masks accept each other and at least one of them is awake.
+        */
+        static inline bool CanCollide(const Collidable& a, const Collidable& b)
+        {
+            return
+                (a.m_layer & b.m_mask) != 0u &&
+                (b.m_layer & a.m_mask) != 0u &&
+                (a.IsAwake() || b.IsAwake());
+        }
+
         /**
             @return Global vertices of the collidable.
         */
@@ -60,6 +230,15 @@ namespace ace
         */
         static bool IsColliding(const Collidable& a, const Collidable& b);
 
+        /**
+            @brief Checks if the Collidables are touching and computes the contact data.
+            @param[in] a An object derived from Collidable.
+            @param[in] b An object derived from Collidable.
+            @param[out] manifold Contact normal, points and depths. Untouched if there is no contact.
+            @return True if the Collidables are touching or overlapping.
+        */
+        static bool GetManifold(const Collidable& a, const Collidable& b, Manifold& manifold);
+
         /**
             @brief Rotate the collidables vertices around its center by deg degrees.
             Modifies the objects vertices and resets the rotation, making the new orientation stay on until another call to this method.
@@ -71,6 +250,13 @@ namespace ace
         AABB m_aabb;
         Matrix2 m_rotation;
         Vector2 m_position;
+
+        UInt32 m_layer;
+        UInt32 m_mask;
+        CollidableType m_type;
+        bool m_isStatic;
+        bool m_isSleeping;
+        void* m_userData;
     };
 
 
@@ -88,6 +274,7 @@ namespace ace
 
         std::vector<Vector2> GetVertices() const final override;
         void Rotate(float deg) final override;
+        void UpdateAABB() final override;
     };
 
 
@@ -124,4 +311,78 @@ namespace ace
         void Rotate(float deg) final override;
     };
 
+
+    /**
+        @brief Convex polygon with up to MaxVertices vertices.
+        Local vertices and face normals are kept as structure of arrays, padded to a multiple of four,
+        so projections run four lanes at a time without branches.
+    */
+    class Polygon final : public Collidable
+    {
+    public:
+
+        static const UInt32 MaxVertices = 16u;
+
+        /**
+            @brief Builds the convex hull of the points.
+            @param[in] points Points relative to position, any order. Hulls with more than MaxVertices vertices are simplified.
+            @param[in] position Position of the polygon.
+            @param[in] rotation Rotation of the polygon.
+        */
+        Polygon(const std::vector<Vector2>& points, const Vector2& position, const Matrix2& rotation = Matrix2::Identity());
+
+        /**
+            @brief Builds a polygon from the opaque pixels of a sprite.
+            @param[in] image Image with an alpha channel. Images without alpha produce a rectangle.
+            @param[in] scale World units per pixel.
+            @param[in] position Position of the polygon, the image is centered on it.
+            @param[in] alphaThreshold Pixels with alpha at or above this are solid.
+        */
+        static Polygon FromImage(const Image& image, const float scale, const Vector2& position, const UInt8 alphaThreshold = 128u);
+
+        bool IsColliding(const Vector2& point) const override;
+
+        /**
+            @brief Separating axis test using the precomputed local normals.
+            @return True if the polygons are touching or overlapping.
+        */
+        static bool IsColliding(const Polygon& a, const Polygon& b);
+
+        /**
+            @return Number of vertices, without padding.
+        */
+        inline UInt32 GetVertexCount() const
+        {
+            return m_count;
+        }
+
+        /**
+            @return index'th vertex relative to position, before rotation.
+        */
+        inline Vector2 GetVertex(const UInt32 index) const
+        {
+            return Vector2(m_x[index], m_y[index]);
+        }
+
+        std::vector<Vector2> GetVertices() const final override;
+        void Rotate(float deg) final override;
+        void UpdateAABB() final override;
+
+    private:
+
+        void SetVertices(const std::vector<Vector2>& hull);
+
+        alignas(16) float m_x[MaxVertices];
+        alignas(16) float m_y[MaxVertices];
+        alignas(16) float m_normalX[MaxVertices];
+        alignas(16) float m_normalY[MaxVertices];
+
+        // Extent of the polygon on its own i'th normal.
+        alignas(16) float m_min[MaxVertices];
+        alignas(16) float m_max[MaxVertices];
+
+        UInt32 m_count;
+        UInt32 m_padded;
+    };
+
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Ace/Collidable.h>
+#include <Ace/IntTypes.h>
+#include <Ace/Vector2.h>
+
+#include <vector>
+
+namespace ace
+{
+    using math::Vector2;
+
+    /**
+        @brief Collidable stored as a component.
+        The shape is placed by the CollisionSystem from the owner's Transform::model.
+    */
+    template <typename ShapeType>
+    struct Collider
+    {
+        typedef ShapeType Shape;
+
+        /**
+            @brief Shape in world space. Position and rotation are overwritten on sync.
+        */
+        ShapeType shape;
+
+        /**
+            @brief Offset from the owner's origin, rotated along with the owner.
+        */
+        Vector2 offset;
+
+        /**
+            @brief Transform::version of the owner at the last sync.
+        */
+        UInt32 version;
+
+        Collider(const ShapeType& shape, const Vector2& offset) :
+            shape(shape),
+            offset(offset),
+            version(~0u)
+        {
+
+        }
+
+        /**
+            @brief Forces a sync on the next CollisionSystem::Update, e.g. after changing the offset.
+        */
+        inline void SetDirty()
+        {
+            version = ~0u;
+        }
+    };
+
+    struct CircleCollider final : public Collider<Circle>
+    {
+        /**
+            @brief Circle collider component.
+            @param[in] radius Radius of the circle.
+            @param[in] offset Offset from the owner's origin.
+        */
+        CircleCollider(const float radius, const Vector2& offset = Vector2()) :
+            Collider<Circle>(Circle(radius, offset), offset)
+        {
+
+        }
+    };
+
+    struct BoxCollider final : public Collider<Rectangle>
+    {
+        /**
+            @brief Box collider component.
+            @param[in] extents Half width and half height of the box.
+            @param[in] offset Offset from the owner's origin.
+        */
+        BoxCollider(const Vector2& extents, const Vector2& offset = Vector2()) :
+            Collider<Rectangle>(Rectangle(extents, offset), offset)
+        {
+
+        }
+    };
+
+    struct PolygonCollider final : public Collider<Polygon>
+    {
+        /**
+            @brief Convex polygon collider component.
+            @param[in] points Points around the owner's origin, the convex hull is used.
+            @param[in] offset Offset from the owner's origin.
+        */
+        PolygonCollider(const std::vector<Vector2>& points, const Vector2& offset = Vector2()) :
+            Collider<Polygon>(Polygon(points, offset), offset)
+        {
+
+        }
+    };
+
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Ace/BroadPhase.h>
+#include <Ace/EntityManager.h>
+#include <Ace/Macros.h>
+
+#include <vector>
+
+namespace ace
+{
+
+    enum class ContactEventType
+    {
+        Begin,
+        Stay,
+        End
+    };
+
+    /**
+        @brief Broadcasted through EventManager<ContactEvent> by CollisionSystem::Update.
+    */
+    struct ContactEvent
+    {
+        ContactEventType type;
+
+        /**
+            @brief Entities owning the colliders, valid while the event is delivered.
+            Nullptr for Collidables added with CollisionSystem::Add.
+            End events are only sent while both entities exist and both Collidables are still added.
+        */
+        EntityHandle* a;
+        EntityHandle* b;
+
+        /**
+            @brief Colliding shapes. Nullptr for End events, the components may have moved or been removed.
+        */
+        const Collidable* colliderA;
+        const Collidable* colliderB;
+    };
+
+    /**
+        @brief Drives collider components.
+        Syncs CircleCollider, BoxCollider and PolygonCollider poses from Transform::model, feeds the broad-phase,
+        runs the narrow-phase and broadcasts ContactEvents. Colliders of the same entity never collide with each other.
+        Contacts found by Update are also the ones PhysicsWorld solves.
+    */
+    class CollisionSystem
+    {
+    public:
+
+        /**
+            @brief Runs a single collision pass over all collider components and added Collidables.
+            Call after Scene::Update so model matrices are up to date.
+        */
+        static void Update();
+
+        /**
+            @brief Adds a Collidable that is not a component, such as level geometry.
+            Its AABB is refreshed while it is awake, like in BroadPhase.
+            @param[in, out] collidable Must be removed before it is destroyed.
+        */
+        static void Add(Collidable& collidable);
+
+        /**
+            @brief Removes a Collidable added with Add. No effect if it was not added.
+        */
+        static void Remove(Collidable& collidable);
+
+    private:
+
+        friend class PhysicsWorld;
+
+        /**
+            @brief Syncs the first collider of the entity, circles before boxes before polygons, if its pose is stale.
+            @param[out] offset Offset of the collider.
+            @return Shape of the collider, until its pool changes. Nullptr if the entity has no collider.
+        */
+        static Collidable* FindCollider(EntityHandle& entity, Vector2& offset);
+
+        bool Resolve(const UInt32 id, const void* handle, EntityManager* manager, EntityHandle*& entity) const;
+
+        struct Proxy
+        {
+            Collidable* collidable;
+            const void* handle;
+            EntityHandle* entity;
+        };
+
+        // Kept across frames, entities are only referenced by id until they are resolved again.
+        // Added Collidables have id 0, no manager and are their own handle.
+        struct Contact
+        {
+            UInt32 idA;
+            UInt32 idB;
+            const void* handleA;
+            const void* handleB;
+            EntityManager* managerA;
+            EntityManager* managerB;
+
+            // Only valid in the frame the contact was found.
+            EntityHandle* a;
+            EntityHandle* b;
+            const Collidable* colliderA;
+            const Collidable* colliderB;
+
+            inline bool operator<(const Contact& other) const
+            {
+                if (idA != other.idA) return idA < other.idA;
+                if (handleA != other.handleA) return handleA < other.handleA;
+                if (idB != other.idB) return idB < other.idB;
+                return handleB < other.handleB;
+            }
+        };
+
+        template <typename ColliderType>
+        void Gather();
+
+        static CollisionSystem& GetInstance();
+
+        CollisionSystem();
+        ~CollisionSystem();
+
+        ACE_DISABLE_COPY(CollisionSystem)
+
+        BroadPhase m_broadPhase;
+
+        // Added with Add, sorted by address.
+        std::vector<Collidable*> m_collidables;
+
+        std::vector<Proxy> m_proxies;
+        std::vector<Contact> m_contacts;
+        std::vector<Contact> m_previous;
+    };
+
+}
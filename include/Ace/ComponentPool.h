@@ -45,6 +45,8 @@ namespace ace
         friend class EntityManager;
         friend struct EntityManager::ComponentHandle<CompType>;
         friend class SpriteManager;
+        friend class CollisionSystem;
+        friend class Snapshot;
 
         std::vector<CompType> m_components;
         std::vector<EntityManager::ComponentHandle<CompType>*> m_handles;
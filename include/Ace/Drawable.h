@@ -6,8 +6,10 @@
 #include <Ace/SpriteSheet.h>
 
 #include <Ace/Path.h>
+#include <Ace/TileGrid.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 
@@ -58,6 +60,20 @@ namespace ace
         SpriteSheet& GetSpriteSheet();
         const SpriteSheet& GetSpriteSheet() const;
 
+        /**
+            @brief Rebuilds the collision grid from a tile layer or an object group.
+            Every non-empty tile, or every cell covered by an object's bounds, becomes solid.
+            On load the grid is built from all layers with the bool property "collision" set to true.
+            @param[in] layer Name of the layer.
+            @return False if the layer was not found or the map is not orthogonal.
+        */
+        bool BuildCollisionGrid(const std::string& layer);
+
+        /**
+            @return Collision grid in the same world space as the tile sprites.
+        */
+        const TileGrid& GetCollisionGrid() const;
+
         virtual void Draw() const;
 
 		tmx::Map& GetMap();
@@ -14,8 +14,15 @@ namespace ace
         Transform transform;
         EntityManager* manager;
 
+        /**
+            @brief Unique among the entities created while the program runs, never reused. Never 0.
+            Systems keep IDs across frames and resolve them with EntityManager::FindEntity.
+        */
+        const UInt32 id;
+
     private:
 
+        friend class Snapshot;
 
         std::forward_list<EntityHandle*> m_children;
         EntityManager::ComponentBaseHandle* m_first;
@@ -11,6 +11,7 @@ namespace ace
     class EntityManager
     {
         friend class SpriteManager;
+        friend class Snapshot;
 
     public:
 
@@ -233,6 +234,15 @@ namespace ace
         }
 
 
+        /**
+        @brief Retrieves the entity with the given id.
+        @param[in] id EntityHandle::id of the target entity.
+        @param[in, out] manager Manager of the target entity. Default manager if not specified.
+        @return Returns pointer to the entity. Nullptr if it has been destroyed or is not managed by 'manager'.
+        */
+        static EntityHandle* FindEntity(const UInt32 id, EntityManager& manager = DefaultManager());
+
+
         /**
         @brief Retrieves amount of entities managed by the 'manager'.
         @param[in, out] manager EntityManager. Default manager if not specified.
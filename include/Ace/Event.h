@@ -22,8 +22,29 @@ namespace ace
 
 	public:
 
+		/**
+			@brief Polls SDL and dispatches the Input phase.
+			Mouse motion, finger motion and accelerometer samples are coalesced into one event per mouse,
+			finger and axis per frame, carrying the summed deltas and the last position or value.
+		*/
 		static void Update();
 
+		/**
+			@brief Queues every motion and accelerometer sample as its own event instead, as SDL reported them.
+			Off by default. The polled states are the same either way.
+		*/
+		static void SetRawMotion(bool raw);
+
+		/**
+			@return Mouse input of the last Update.
+		*/
+		static const MouseState& GetMouseState();
+
+		/**
+			@return Fingers on the screen after the last Update.
+		*/
+		static const TouchState& GetTouchState();
+
 	};
 
 
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <Ace/Assert.h>
+#include <Ace/IntTypes.h>
+
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 
@@ -9,16 +13,138 @@ namespace ace
     template <typename ParamT>
     class EventBase;
 
+    /**
+    @brief Points in the frame where queued events are dispatched.
+    */
+    enum class EventPhase : UInt8
+    {
+        Input,      /** End of Event::Update, after SDL events are polled. */
+        Update      /** End of ace::Update, after entities are updated. */
+    };
+
+    static const UInt32 EventPhaseCount = 2u;
+
+    /**
+    @brief Every sub-type of an event passes the filter.
+    */
+    static const UInt32 AllEventTypes = ~0u;
+
+    /**
+    @brief Sub-types that fit in a filter, each has its own bit.
+    */
+    static const UInt32 MaxEventSubtypes = 32u;
+
+    /**
+    @brief Filter bit of a sub-type. Sub-types past the last bit share it instead of shifting out of range.
+    */
+    inline UInt32 EventSubtypeBit(UInt32 subtype)
+    {
+        ACE_ASSERT(subtype < MaxEventSubtypes, "Event sub-type %u does not fit in a filter", subtype);
+        return 1u << (subtype < MaxEventSubtypes ? subtype : MaxEventSubtypes - 1u);
+    }
+
+    /**
+    @brief Filter bit of an event sub-type, such as MouseEventType::Motion. Combine with |.
+    */
+    template <typename TypeT>
+    inline UInt32 EventMask(TypeT type)
+    {
+        return EventSubtypeBit(static_cast<UInt32>(type));
+    }
+
+    /**
+    @brief Sub-type of an event, read from its type member. Events without one have a single sub-type.
+    */
+    template <typename ParamT, typename = void>
+    struct EventSubtype
+    {
+        static UInt32 Get(const ParamT&)
+        {
+            return 0u;
+        }
+    };
+
+    template <typename ParamT>
+    struct EventSubtype<ParamT, decltype(void(std::declval<ParamT>().type))>
+    {
+        static UInt32 Get(const ParamT& param)
+        {
+            return static_cast<UInt32>(param.type);
+        }
+    };
+
+    /**
+    @brief Dispatches the queues of every event type in one phase.
+    */
+    class EventDispatcher final
+    {
+    public:
+
+        /**
+        @brief Dispatches events queued for phase, of every type, in the order they were queued per type.
+        */
+        static void Dispatch(EventPhase phase)
+        {
+            // Indexed, a listener may use a new event type and register it.
+            auto& dispatchers = GetDispatchers();
+            for (UInt32 i = 0u; i < dispatchers.size(); ++i)
+            {
+                dispatchers[i](phase);
+            }
+        }
+
+        /**
+        @brief Called once per event type by its EventManager.
+        */
+        static void Register(void (*dispatch)(EventPhase))
+        {
+            GetDispatchers().emplace_back(dispatch);
+        }
+
+    private:
+
+        static std::vector<void (*)(EventPhase)>& GetDispatchers()
+        {
+            static std::vector<void (*)(EventPhase)> dispatchers;
+            return dispatchers;
+        }
+    };
+
+    /**
+    @brief Listeners and queued events of one event type.
+    Listeners are called by descending priority, in registration order within a priority.
+    Adding or removing listeners while an event is delivered takes effect once it has been delivered.
+    Queues keep their capacity, steady state dispatch does not allocate.
+    */
     template <typename ParamT>
     class EventManager
     {
+        struct Listener
+        {
+            EventBase<ParamT>* event;
+            Int32 priority;
+            UInt32 filter;
+        };
+
+        std::vector<Listener> m_events;
+
+        // Listeners added while delivering, inserted afterwards.
+        std::vector<Listener> m_added;
 
-        std::vector<EventBase<ParamT>*> m_events;
+        // Queued per phase, and the batch being dispatched per phase.
+        std::vector<ParamT> m_queues[EventPhaseCount];
+        std::vector<ParamT> m_batches[EventPhaseCount];
+
+        UInt32 m_depth;
+        bool m_hasRemoved;
 
         EventManager() :
-            m_events()
+            m_events(),
+            m_added(),
+            m_depth(0u),
+            m_hasRemoved(false)
         {
-
+            EventDispatcher::Register(&EventManager::Dispatch);
         }
 
         ~EventManager()
@@ -26,6 +152,54 @@ namespace ace
 
         }
 
+        void Insert(const Listener& listener)
+        {
+            m_events.insert(std::upper_bound(
+                m_events.begin(), m_events.end(), listener,
+                [](const Listener& a, const Listener& b){return a.priority > b.priority; }
+            ), listener);
+        }
+
+        void Deliver(const ParamT& param)
+        {
+            const UInt32 mask = EventSubtypeBit(EventSubtype<ParamT>::Get(param));
+
+            // Indexed and size checked each time, the vector does not change size while delivering.
+            ++m_depth;
+            for (UInt32 i = 0u; i < m_events.size(); ++i)
+            {
+                const Listener& listener = m_events[i];
+                if (listener.event != nullptr && (listener.filter & mask) != 0u)
+                {
+                    listener.event->OnEvent(param);
+                }
+            }
+
+            if (--m_depth == 0u)
+            {
+                Flush();
+            }
+        }
+
+        void Flush()
+        {
+            if (m_hasRemoved)
+            {
+                //Remove-erase
+                m_events.erase(std::remove_if(
+                    m_events.begin(), m_events.end(),
+                    [](const Listener& e){return e.event == nullptr; }
+                ), m_events.end());
+                m_hasRemoved = false;
+            }
+
+            for (const Listener& listener : m_added)
+            {
+                Insert(listener);
+            }
+            m_added.clear();
+        }
+
     public:
 
         /**
@@ -41,10 +215,22 @@ namespace ace
         /**
         @brief Add event to container.
         @param[in, out] evnt Event to add to container.
+        @param[in] priority Higher priorities receive events first.
+        @param[in] filter EventMask of the sub-types to receive.
         */
-        static void Add(EventBase<ParamT>& evnt)
+        static void Add(EventBase<ParamT>& evnt, Int32 priority = 0, UInt32 filter = AllEventTypes)
         {
-            EventManager::GetInstance().m_events.emplace_back(&evnt);
+            auto& m = EventManager::GetInstance();
+
+            const Listener listener = { &evnt, priority, filter };
+            if (m.m_depth != 0u)
+            {
+                m.m_added.emplace_back(listener);
+            }
+            else
+            {
+                m.Insert(listener);
+            }
         }
 
         /**
@@ -55,24 +241,71 @@ namespace ace
         {
             auto& m = EventManager::GetInstance();
 
+            m.m_added.erase(std::remove_if(
+                m.m_added.begin(), m.m_added.end(),
+                [&evnt](const Listener& e){return e.event == &evnt; }
+            ), m.m_added.end());
+
+            // Cleared now so it is never called again, erased once delivery is done.
+            if (m.m_depth != 0u)
+            {
+                for (Listener& listener : m.m_events)
+                {
+                    if (listener.event == &evnt)
+                    {
+                        listener.event = nullptr;
+                        m.m_hasRemoved = true;
+                    }
+                }
+                return;
+            }
+
             //Remove-erase
             m.m_events.erase(std::remove_if(
                 m.m_events.begin(), m.m_events.end(),
-                [&evnt](EventBase<ParamT>* e){return e == &evnt; }
+                [&evnt](const Listener& e){return e.event == &evnt; }
             ), m.m_events.end());
         }
 
-
         /**
-        @brief Broadcast to all events listening to ParamT.
+        @brief Broadcast to all events listening to ParamT, immediately.
         @param[in, out] param Parameter to broadcast.
         */
         static void Broadcast(ParamT param)
         {
-            for (auto& itr : EventManager<ParamT>::GetInstance().m_events)
+            EventManager::GetInstance().Deliver(param);
+        }
+
+        /**
+        @brief Queues param until phase is dispatched.
+        Events queued while their phase is dispatched wait for its next dispatch.
+        */
+        static void Enqueue(const ParamT& param, EventPhase phase = EventPhase::Update)
+        {
+            EventManager::GetInstance().m_queues[static_cast<UInt32>(phase)].emplace_back(param);
+        }
+
+        /**
+        @brief Broadcasts the events queued for phase. Called by EventDispatcher::Dispatch.
+        */
+        static void Dispatch(EventPhase phase)
+        {
+            auto& m = EventManager::GetInstance();
+            auto& queue = m.m_queues[static_cast<UInt32>(phase)];
+            auto& batch = m.m_batches[static_cast<UInt32>(phase)];
+
+            if (queue.empty() || !batch.empty())
+            {
+                return;
+            }
+
+            // Swapped, both keep their capacity.
+            batch.swap(queue);
+            for (const ParamT& param : batch)
             {
-                itr->OnEvent(param);
+                m.Deliver(param);
             }
+            batch.clear();
         }
 
     };
@@ -85,10 +318,12 @@ namespace ace
 
         /**
         @brief Event lives until its parenting object dies
+        @param[in] priority Higher priorities receive events first.
+        @param[in] filter EventMask of the sub-types to receive, such as EventMask(MouseEventType::Motion).
         */
-        EventBase()
+        EventBase(Int32 priority = 0, UInt32 filter = AllEventTypes)
         {
-            EventManager<ParamT>::Add(*this);
+            EventManager<ParamT>::Add(*this, priority, filter);
         }
 
         /**
@@ -97,4 +97,35 @@ namespace ace
 		Int16 value;
 	};
 
+	/**
+		@brief Mouse input of the last frame, polled with Event::GetMouseState.
+	*/
+	struct MouseState
+	{
+		Vector2 position;		// Last position in window pixels.
+		Vector2 delta;			// Motion summed over the frame.
+		float wheel;			// Vertical scroll summed over the frame.
+		UInt32 buttons;			// SDL_BUTTON mask.
+		UInt32 samples;			// Motion events SDL reported during the frame.
+	};
+
+	static const UInt32 MaxTouchFingers = 10u;
+
+	/**
+		@brief Fingers on the screen after the last frame, polled with Event::GetTouchState.
+	*/
+	struct TouchState
+	{
+		struct Finger
+		{
+			UInt32 fingerID;
+			Vector2 position;	// Normalized, 0 to 1.
+			Vector2 delta;		// Motion summed over the frame.
+			float pressure;
+		};
+
+		UInt32 count;
+		Finger fingers[MaxTouchFingers];
+	};
+
 }
\ No newline at end of file
@@ -11,6 +11,29 @@ namespace ace
 		struct FileImpl;
 	public:
 
+		/**
+			@brief Read-only, reference counted view of the whole file.
+			Backed by a memory mapping where available, otherwise by a buffer. Not null terminated.
+		*/
+		struct View final
+		{
+			std::shared_ptr<const UInt8> data;
+			UInt32 size;
+			bool isMapped;
+
+			View();
+
+			inline const UInt8* Get() const
+			{
+				return data.get();
+			}
+
+			inline operator bool() const
+			{
+				return data.get() != nullptr;
+			}
+		};
+
 		const Path path;
 
 		/**
@@ -44,6 +67,13 @@ namespace ace
 		*/
 		std::shared_ptr<UInt8> ReadAll() const;
 
+		/**
+			@brief Maps the whole file to memory without copying it. Falls back to ReadAll where mmap is not available.
+			The view stays valid after the File is destroyed.
+			@return View of the file, empty on failure
+		*/
+		View Map() const;
+
 		/**
 			@brief Read all text data from file to buffer
 			@return Buffer with data in it
@@ -88,6 +88,49 @@ namespace ace
 		*/
 		void GetTextBuffer(Buffer&, const char* text, float scale = 0.75f, float xPos = -75.0f, float yPos = 0.0f);
 
+		/**
+			@brief Rasterizes a single glyph, used by GlyphAtlas.
+			@param[in] codepoint Unicode codepoint
+			@param[in] pixelHeight Font size in pixels
+			@param[out] pixels Single channel coverage, glyph.w * glyph.h bytes
+			@param[out] glyph Size and metrics of the glyph, x and y are left as zero
+			@return False if the font has no glyph for the codepoint, the missing glyph is rasterized then.
+		*/
+		bool RasterizeGlyph(UInt32 codepoint, float pixelHeight, std::vector<UInt8>& pixels, Glyph& glyph) const;
+
+		/**
+			@brief Rasterizes a single glyph as a signed distance field, used by GlyphAtlas.
+			Values above 128 are inside the glyph, each pixel of distance changes the value by 128 / spread.
+			@param[in] codepoint Unicode codepoint
+			@param[in] pixelHeight Font size in pixels the field is generated for
+			@param[in] spread Largest distance stored in pixels, also the padding around the glyph
+			@param[out] pixels Single channel distances, glyph.w * glyph.h bytes
+			@param[out] glyph Size and metrics of the glyph including the padding, x and y are left as zero
+			@return False if the font has no glyph for the codepoint, the missing glyph is rasterized then.
+		*/
+		bool RasterizeGlyphSDF(UInt32 codepoint, float pixelHeight, UInt32 spread, std::vector<UInt8>& pixels, Glyph& glyph) const;
+
+		/**
+			@return Distance from the baseline to the top of the tallest glyph in pixels.
+		*/
+		float GetAscent(float pixelHeight) const;
+
+		/**
+			@return Distance between two baselines in pixels.
+		*/
+		float GetLineHeight(float pixelHeight) const;
+
+		/**
+			@return Kerning adjustment between two codepoints in pixels.
+		*/
+		float GetKerning(UInt32 first, UInt32 second, float pixelHeight) const;
+
+		/**
+			@brief Decodes the next UTF-8 codepoint and advances text past it.
+			@return Codepoint, 0 at the end of the string and U+FFFD for invalid sequences.
+		*/
+		static UInt32 DecodeUTF8(const char*& text);
+
 
         /**
         @brief Returns constant raw font data and sets its size to 'size'
@@ -95,12 +138,6 @@ namespace ace
         @return Constant raw font data
         */
         const UInt8* GetBuffer(UInt32& size) const;
-        /**
-            @brief Returns raw font data and sets its size to 'size'
-            @param[in, out] size Size of the buffer
-            @return Raw font data
-        */
-        UInt8* GetBuffer(UInt32& size);
 
 
 		/**
@@ -118,11 +155,13 @@ namespace ace
 		std::vector<Glyph>ASCII;
 		std::vector<Glyph>::iterator it = ASCII.begin();
 
+		//Reused by GetTextBuffer
+		std::vector<Vertex> m_vertices;
+
 		//Sharedpointers
 		struct FontInfo;
 		std::shared_ptr<FontInfo> m_info;
-		std::shared_ptr<UInt8> m_buffer;
-        UInt32 m_bufferSize;
+		File::View m_buffer;
 
 	};
 }
\ No newline at end of file
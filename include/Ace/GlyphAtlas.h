@@ -0,0 +1,121 @@
+#pragma once
+
+#include <Ace/Font.h>
+#include <Ace/IntTypes.h>
+#include <Ace/Texture.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ace
+{
+
+    /**
+        @brief How GlyphAtlas rasterizes glyphs.
+    */
+    enum class GlyphMode : UInt8
+    {
+        Coverage,       /** One bitmap per codepoint and pixel height, sharpest at small sizes. */
+        DistanceField,  /** One signed distance field per codepoint, scales to any size. Needs TextMaterial(GlyphMode::DistanceField). */
+    };
+
+    /**
+        @brief Single channel texture of glyphs, rasterized on demand.
+        Glyphs of any codepoint and pixel height are packed into the same texture with a skyline packer,
+        so text of several sizes can be drawn with one texture and one draw call. See TextBatch.
+    */
+    class GlyphAtlas final
+    {
+    public:
+
+        /**
+            @param[in] font Font to rasterize glyphs from.
+            @param[in] width Width of the atlas texture in pixels.
+            @param[in] height Height of the atlas texture in pixels.
+            @param[in] mode Coverage bitmaps or distance fields.
+            @param[in] fieldPixelHeight Font size distance fields are generated at.
+            @param[in] fieldSpread Largest distance stored in a distance field, in pixels at fieldPixelHeight.
+        */
+        GlyphAtlas(const Font& font, UInt32 width = 512u, UInt32 height = 512u, GlyphMode mode = GlyphMode::Coverage,
+            float fieldPixelHeight = 32.f, UInt32 fieldSpread = 4u);
+
+        /**
+            @brief Finds a glyph, rasterizing and packing it on first use.
+            Pixel heights are rounded to whole pixels, distance fields ignore them.
+            @return Glyph in atlas pixels, nullptr if the atlas is full. Valid until Clear.
+            Glyphs that did not fit are not rasterized again until Clear.
+            Scale its size and metrics by GetGlyphScale.
+        */
+        const Glyph* GetGlyph(UInt32 codepoint, float pixelHeight);
+
+        /**
+            @return Scale from atlas glyph metrics to a font size, 1 for coverage glyphs.
+        */
+        float GetGlyphScale(float pixelHeight) const;
+
+        /**
+            @return Change of a distance field value per pixel at fieldPixelHeight, 0 for coverage glyphs.
+        */
+        float GetFieldGradient() const;
+
+        GlyphMode GetMode() const;
+
+        /**
+            @brief Uploads the atlas if glyphs were added since the last upload.
+            Called by TextBatch before drawing.
+        */
+        void Update();
+
+        /**
+            @brief Removes every glyph, for example when the atlas fills up after a language change.
+        */
+        void Clear();
+
+        const Font& GetFont() const;
+
+        const Texture& GetTexture() const;
+
+        UInt32 GetWidth() const;
+
+        UInt32 GetHeight() const;
+
+        /**
+            @return Number of cached glyphs.
+        */
+        UInt32 GetGlyphCount() const;
+
+    private:
+
+        struct SkylineNode
+        {
+            UInt32 x;
+            UInt32 y;
+            UInt32 width;
+        };
+
+        bool Pack(UInt32 width, UInt32 height, UInt32& x, UInt32& y);
+
+        Font m_font;
+        UInt32 m_width;
+        UInt32 m_height;
+
+        GlyphMode m_mode;
+        float m_fieldPixelHeight;
+        UInt32 m_fieldSpread;
+
+        std::vector<SkylineNode> m_skyline;
+        std::unordered_map<UInt32, Glyph> m_glyphs;
+
+        // Keys of glyphs that did not fit.
+        std::unordered_set<UInt32> m_dropped;
+
+        std::vector<UInt8> m_pixels;
+        std::vector<UInt8> m_scratch;
+
+        Texture m_texture;
+        bool m_dirty;
+        bool m_full;
+    };
+
+}
@@ -10,6 +10,7 @@
 #include <Ace/Material.h>
 #include <Ace/Texture.h>
 #include <Ace/Framebuffer.h>
+#include <Ace/RenderStats.h>
 
 #include <Ace/Sprite.h>
 #include <Ace/Drawable.h>
@@ -51,6 +52,8 @@ namespace ace
 	*/
 	class GraphicsDevice
 	{
+		friend class SpriteManager;
+
 	public:
 
 		/*
@@ -75,11 +78,21 @@ namespace ace
 		static void Clear(const Color32& color, ClearFlags clear = ClearFlags::ALL);
 		
 		/**
-			@brief Present Graphics Context
+			@brief Present Graphics Context, ends the frame of GetStats.
 			@param[in] window
 		*/
 		static void Present(Window& window);
 
+		/**
+			@return Counters of the last presented frame.
+		*/
+		static const RenderStats& GetStats();
+
+		/**
+			@return Counters of the frame in progress.
+		*/
+		static const RenderStats& GetFrameStats();
+
 		/**
 			@brief Sets Viewport
 			@param[in] width
@@ -239,8 +252,9 @@ namespace ace
 			@param[in] width
 			@param[in] height
 			@param[in] format Pixel Format
+			@param[in] level Mipmap level
 		*/
-		static void UpdateTexture(Texture&, const UInt8* pixels, UInt32 w, UInt32 h, PixelFormat format);
+		static void UpdateTexture(Texture&, const UInt8* pixels, UInt32 w, UInt32 h, PixelFormat format, UInt32 level = 0u);
 
 		/**
 			@brief Set Texture
@@ -269,6 +283,12 @@ namespace ace
 
 	private:
 
+		// Backend independent, see RenderStats.cpp.
+		static RenderStats& CountStats();
+		static void CountDraw(UInt32 vertices, UInt32 indices);
+		static void CountUpload(UInt32 bytes);
+		static void EndStatsFrame();
+
         static void SetUniforms();
         static void ApplyUniform(const char* name, const void* data, UniformType uniform, UInt32 elements = 1);
 
@@ -12,18 +12,86 @@ namespace ace
 	{
 	public:
 
+		/**
+			@brief Reusable memory for documents.
+			Documents allocate from one buffer, Reset() frees everything at once and keeps the memory
+			for the next document. The buffer grows to the largest document seen.
+		*/
+		class Arena
+		{
+		public:
+
+			/**
+				@param[in] capacity Initial size of the buffer in bytes
+			*/
+			Arena(UInt32 capacity = 1u << 20u);
+			~Arena();
+
+			/**
+				@brief Frees every value allocated from the arena.
+				Documents using the arena must not be used afterwards.
+			*/
+			void Reset();
+
+			/**
+				@return Bytes allocated since the last reset
+			*/
+			UInt32 GetSize() const;
+
+			/**
+				@return Bytes reserved
+			*/
+			UInt32 GetCapacity() const;
+
+			rapidjson::MemoryPoolAllocator<>* GetAllocator();
+
+		private:
+			Arena(const Arena&) = delete;
+			Arena& operator=(const Arena&) = delete;
+
+			std::unique_ptr<char[]> m_buffer;
+			UInt32 m_capacity;
+			std::unique_ptr<rapidjson::MemoryPoolAllocator<>> m_allocator;
+		};
+
 		rapidjson::Document document;
 
 		Json();
 
-		// TODO: ParseString method.
+		/**
+			@brief Allocates the document from an arena, which must outlive this.
+		*/
+		Json(Arena& arena);
 
 		bool ParseString(const std::string& string);
 		
+		/**
+			@brief Parses a file, strings are copied from the mapped file into the document.
+		*/
 		bool Parse(const File& file);
+
+		/**
+			@brief Parses a file in-situ. The file is read into a buffer owned by this Json and
+			strings point into the buffer instead of being copied.
+		*/
+		bool ParseInsitu(const File& file);
+
+		/**
+			@brief Parses a buffer in-situ. The buffer is modified and must outlive the document.
+			@param[in,out] buffer Null terminated JSON
+		*/
+		bool ParseInsitu(char* buffer);
 		
-		void Write(Path path);
+		/**
+			@brief Writes the document straight to a file through a small buffer.
+			@param[in] path File to overwrite
+			@param[in] pretty Indent the output
+			@return True if succesful
+		*/
+		bool Write(const Path& path, bool pretty = false) const;
 
+	private:
+		std::shared_ptr<char> m_buffer;
 	};
 
-}
\ No newline at end of file
+}
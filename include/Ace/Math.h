@@ -36,6 +36,7 @@ namespace ace
         float Acos(float);
         float Asin(float);
         float Atan(float);
+        float Atan2(float y, float x);
         inline bool IsBetween(float value, float min, float max)
         {
             return min <= value && value <= max;
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <Ace/Collidable.h>
+#include <Ace/EntityManager.h>
+#include <Ace/IntTypes.h>
+#include <Ace/Macros.h>
+#include <Ace/Vector2.h>
+
+#include <utility>
+#include <vector>
+
+namespace ace
+{
+    using math::Vector2;
+
+    /**
+        @brief Fixed timestep 2D rigid body world.
+        Semi-implicit Euler integration, sequential impulse contact solver with warm starting
+        and island sleeping. Bodies are stored as structure of arrays, the Collidables are
+        moved to follow their bodies after every step.
+        Contacts come from CollisionSystem, call Step after CollisionSystem::Update. Steps within a frame
+        refine the manifolds of those contacts, pairs that start touching are picked up by the next update.
+        Bodies of entities write their pose to the entity's Transform after every Step.
+    */
+    class PhysicsWorld final
+    {
+    public:
+
+        typedef UInt32 BodyID;
+
+        static const BodyID InvalidBody = 0xFFFFFFFFu;
+
+        /**
+            @brief PhysicsWorld constructor.
+            @param[in] gravity Gravity acceleration.
+            @param[in] timeStep Length of a single simulation step in seconds.
+        */
+        PhysicsWorld(const Vector2& gravity = Vector2(0.f, -9.81f), const float timeStep = 1.f / 60.f);
+        ~PhysicsWorld();
+
+        /**
+            @brief Creates a rigid body driving the Collidable and adds it to CollisionSystem.
+            @param[in, out] shape Must outlive the body. Its current position and rotation become the initial pose.
+            @param[in] mass Mass of the body. Zero creates a static body.
+            @param[in] velocity Initial linear velocity.
+            @return ID of the body.
+        */
+        BodyID CreateBody(Collidable& shape, const float mass, const Vector2& velocity = Vector2());
+
+        /**
+            @brief Creates a rigid body driving the entity through its collider component.
+            The first collider is used, see CollisionSystem. The pose is read from Transform::model and written to
+            Transform::position and rotation, so the entity should not have a transformed parent.
+            The body is destroyed by the first Step after the entity or its collider is.
+            @param[in, out] entity Entity with a CircleCollider, BoxCollider or PolygonCollider.
+            @param[in] mass Mass of the body. Zero creates a static body.
+            @param[in] velocity Initial linear velocity.
+            @return ID of the body. InvalidBody if the entity has no collider.
+        */
+        BodyID CreateBody(EntityHandle& entity, const float mass, const Vector2& velocity = Vector2());
+
+        /**
+            @brief Destroys a body, the Collidable or entity is left where it is.
+        */
+        void DestroyBody(const BodyID body);
+
+        /**
+            @brief Advances the simulation in fixed steps.
+            @param[in] deltaTime Elapsed time, accumulated until a full step is available.
+            @return Number of steps taken.
+        */
+        UInt32 Step(const float deltaTime);
+
+        /**
+            @return Position of the body.
+        */
+        Vector2 GetPosition(const BodyID body) const;
+
+        /**
+            @brief Teleports the body and wakes it up.
+        */
+        void SetPosition(const BodyID body, const Vector2& position);
+
+        /**
+            @return Rotation of the body in degrees.
+        */
+        float GetAngle(const BodyID body) const;
+
+        /**
+            @return Linear velocity of the body.
+        */
+        Vector2 GetVelocity(const BodyID body) const;
+
+        /**
+            @brief Sets the linear velocity and wakes the body up.
+        */
+        void SetVelocity(const BodyID body, const Vector2& velocity);
+
+        /**
+            @return Angular velocity of the body in radians per second.
+        */
+        float GetAngularVelocity(const BodyID body) const;
+
+        /**
+            @brief Sets the angular velocity in radians per second and wakes the body up.
+        */
+        void SetAngularVelocity(const BodyID body, const float velocity);
+
+        /**
+            @brief Applies a force for the next step and wakes the body up.
+        */
+        void ApplyForce(const BodyID body, const Vector2& force);
+
+        /**
+            @brief Applies an impulse at a world point and wakes the body up.
+        */
+        void ApplyImpulse(const BodyID body, const Vector2& impulse, const Vector2& point);
+
+        /**
+            @brief Sets contact material of the body.
+            @param[in] restitution Bounciness, 0 to 1. Pairs use the larger value.
+            @param[in] friction Coulomb friction coefficient. Pairs use the geometric mean.
+        */
+        void SetMaterial(const BodyID body, const float restitution, const float friction);
+
+        /**
+            @return True if the body is asleep.
+        */
+        bool IsSleeping(const BodyID body) const;
+
+        /**
+            @brief Wakes the body up.
+        */
+        void Wake(const BodyID body);
+
+        /**
+            @brief Sets number of velocity iterations per step. 8 by default.
+        */
+        inline void SetIterations(const UInt32 iterations)
+        {
+            m_iterations = iterations;
+        }
+
+        inline const Vector2& GetGravity() const
+        {
+            return m_gravity;
+        }
+
+        inline void SetGravity(const Vector2& gravity)
+        {
+            m_gravity = gravity;
+        }
+
+        /**
+            @return Number of bodies in the world.
+        */
+        inline UInt32 BodyCount() const
+        {
+            return static_cast<UInt32>(m_shapes.size());
+        }
+
+    private:
+
+        struct ContactPoint
+        {
+            Vector2 rA;
+            Vector2 rB;
+            float normalImpulse;
+            float tangentImpulse;
+            float normalMass;
+            float tangentMass;
+            float bias;
+        };
+
+        struct ContactConstraint
+        {
+            UInt32 a;
+            UInt32 b;
+            BodyID idA;
+            BodyID idB;
+            Vector2 normal;
+            float friction;
+            ContactPoint points[2u];
+            UInt8 count;
+
+            inline bool operator<(const ContactConstraint& other) const
+            {
+                return idA < other.idA || (idA == other.idA && idB < other.idB);
+            }
+        };
+
+        BodyID AddBody(Collidable& shape, const float mass, const Vector2& velocity, EntityHandle* entity, const Vector2& offset);
+        void Refresh();
+        void WriteTransforms();
+        UInt32 FindBody(const Collidable* shape) const;
+        void SubStep(const float h);
+        void Collide(const float h);
+        void Solve();
+        void UpdateSleep(const float h);
+        void SyncShape(const UInt32 index);
+        void SetAwake(const UInt32 index, const bool awake);
+        UInt32 FindRoot(UInt32 index);
+
+        ACE_DISABLE_COPY(PhysicsWorld)
+
+        // Bodies, structure of arrays indexed by dense body index.
+        std::vector<float> m_positionX;
+        std::vector<float> m_positionY;
+        std::vector<float> m_angle;
+        std::vector<float> m_velocityX;
+        std::vector<float> m_velocityY;
+        std::vector<float> m_angularVelocity;
+        std::vector<float> m_forceX;
+        std::vector<float> m_forceY;
+        std::vector<float> m_inverseMass;
+        std::vector<float> m_inverseInertia;
+        std::vector<float> m_active;
+        std::vector<float> m_restitution;
+        std::vector<float> m_friction;
+        std::vector<float> m_sleepTime;
+        std::vector<Collidable*> m_shapes;
+        std::vector<BodyID> m_ids;
+
+        // Entity bodies, id 0 and no manager for bodies of Collidables.
+        // Shapes and handles of entity bodies are looked up again by every Step, components move between frames.
+        std::vector<UInt32> m_entityIDs;
+        std::vector<EntityManager*> m_managers;
+        std::vector<EntityHandle*> m_entities;
+        std::vector<Vector2> m_offsets;
+
+        // Shape to dense index, sorted by shape. Rebuilt by every Step.
+        std::vector<std::pair<const Collidable*, UInt32>> m_lookup;
+
+        // BodyID to dense index.
+        std::vector<UInt32> m_indices;
+        std::vector<BodyID> m_freeIDs;
+
+        std::vector<ContactConstraint> m_contacts;
+        std::vector<ContactConstraint> m_previousContacts;
+        std::vector<UInt32> m_islands;
+
+        Vector2 m_gravity;
+        float m_timeStep;
+        float m_accumulator;
+        UInt32 m_iterations;
+    };
+
+}
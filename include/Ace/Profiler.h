@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Ace/IntTypes.h>
+#include <Ace/Macros.h>
+
+namespace ace
+{
+
+    /**
+        @brief CPU profiler for scoped zones, captured per thread and exported as Chrome trace JSON.
+        Zones are recorded with ACE_PROFILE_SCOPE, which compiles to nothing unless ACE_PROFILE is defined
+        (ACERBA_PROFILE in CMake). Each thread writes its zones to its own ring buffer without locking,
+        the oldest zones of a thread are overwritten once its ring is full.
+        Open the exported file in chrome://tracing or Perfetto.
+    */
+    class Profiler final
+    {
+    public:
+
+        /**
+            @brief Starts recording zones on every thread, zones from earlier captures are dropped.
+        */
+        static void BeginCapture();
+
+        /**
+            @brief Stops recording and writes the captured zones.
+            @param[in] path Chrome trace JSON file to write.
+            @return False if the file could not be written.
+        */
+        static bool EndCapture(const char* path);
+
+        static bool IsCapturing();
+
+        /**
+            @brief Names the calling thread in exported traces.
+            @param[in] name String literal or other string that outlives the profiler.
+        */
+        static void SetThreadName(const char* name);
+
+        /**
+            @brief Opens a zone on the calling thread, use ACE_PROFILE_SCOPE instead.
+            @param[in] name String literal or other string that outlives the profiler.
+            @return True if the zone is recorded and must be closed with End.
+        */
+        static bool Begin(const char* name);
+
+        /**
+            @brief Closes the innermost zone opened by Begin on the calling thread.
+        */
+        static void End();
+
+    private:
+
+        Profiler() = delete;
+    };
+
+    /**
+        @brief Zone from construction to destruction.
+    */
+    class ProfileScope final
+    {
+    public:
+
+        explicit ProfileScope(const char* name) : m_isRecorded(Profiler::Begin(name))
+        {
+
+        }
+
+        ~ProfileScope()
+        {
+            if (m_isRecorded)
+            {
+                Profiler::End();
+            }
+        }
+
+    private:
+
+        const bool m_isRecorded;
+
+        ACE_DISABLE_COPY(ProfileScope)
+    };
+
+}
+
+#define ACE_PROFILE_JOIN_IMPL(a, b) a##b
+#define ACE_PROFILE_JOIN(a, b) ACE_PROFILE_JOIN_IMPL(a, b)
+
+#if ACE_PROFILE
+    /// Profiles the rest of the enclosing scope as a zone called name.
+    #define ACE_PROFILE_SCOPE(name) ::ace::ProfileScope ACE_PROFILE_JOIN(aceProfileScope, __LINE__)(name)
+    /// Names the calling thread in exported traces.
+    #define ACE_PROFILE_THREAD(name) ::ace::Profiler::SetThreadName(name)
+#else
+    #define ACE_PROFILE_SCOPE(name)
+    #define ACE_PROFILE_THREAD(name)
+#endif
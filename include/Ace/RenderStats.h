@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Ace/IntTypes.h>
+
+namespace ace
+{
+
+    /**
+        @brief Work submitted to the GPU during one frame, counted by GraphicsDevice.
+        A frame ends at GraphicsDevice::Present.
+    */
+    struct RenderStats
+    {
+        UInt32 drawCalls;
+        UInt32 vertices;        // Vertex count of non-indexed draws, and of sprites.
+        UInt32 indices;
+
+        /**
+            @brief Bytes passed to BufferData, BufferSubData and UpdateTexture.
+        */
+        UInt32 bytesUploaded;
+
+        UInt32 programBinds;
+        UInt32 textureBinds;    // Binds for drawing, not the binds of texture uploads.
+        UInt32 uniformUploads;
+
+        /**
+            @brief Sprites drawn in SpriteManager batches, and sprites it skipped.
+            SpriteManager has no view culling yet, skipped sprites belong to another scene.
+        */
+        UInt32 spritesBatched;
+        UInt32 spritesCulled;
+
+        RenderStats() : drawCalls(0u), vertices(0u), indices(0u), bytesUploaded(0u), programBinds(0u),
+            textureBinds(0u), uniformUploads(0u), spritesBatched(0u), spritesCulled(0u)
+        {
+
+        }
+    };
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Ace/IntTypes.h>
+
+#include <atomic>
+#include <utility>
+
+namespace ace
+{
+
+    /**
+        @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+        Neither side ever blocks, Push fails when the queue is full.
+        @tparam T Movable and default constructible element.
+        @tparam Capacity Power of two, one slot is kept free.
+    */
+    template <typename T, UInt32 Capacity>
+    class SPSCQueue final
+    {
+        static_assert(Capacity >= 2u && (Capacity & (Capacity - 1u)) == 0u, "Capacity must be a power of two");
+
+    public:
+
+        SPSCQueue() : m_head(0u), m_tail(0u)
+        {
+
+        }
+
+        /**
+            @brief Producer only.
+            @return False if the queue is full, value is left untouched then.
+        */
+        bool Push(T&& value)
+        {
+            const UInt32 tail = m_tail.load(std::memory_order_relaxed);
+            const UInt32 next = (tail + 1u) & (Capacity - 1u);
+
+            if (next == m_head.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            m_slots[tail] = std::move(value);
+            m_tail.store(next, std::memory_order_release);
+            return true;
+        }
+
+        /**
+            @brief Consumer only.
+            @return False if the queue is empty.
+        */
+        bool Pop(T& value)
+        {
+            const UInt32 head = m_head.load(std::memory_order_relaxed);
+
+            if (head == m_tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            value = std::move(m_slots[head]);
+            // Releases resources held by the slot now, not when it is reused.
+            m_slots[head] = T();
+            m_head.store((head + 1u) & (Capacity - 1u), std::memory_order_release);
+            return true;
+        }
+
+        /**
+            @return True if the queue looked empty, exact only on the consumer thread.
+        */
+        bool IsEmpty() const
+        {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+
+    private:
+
+        // Head and tail on their own cache lines, the threads only share them on Push and Pop.
+        alignas(64) std::atomic<UInt32> m_head;
+        alignas(64) std::atomic<UInt32> m_tail;
+        alignas(64) T m_slots[Capacity];
+
+        SPSCQueue(const SPSCQueue&) = delete;
+        SPSCQueue& operator=(const SPSCQueue&) = delete;
+    };
+
+}
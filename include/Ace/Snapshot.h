@@ -0,0 +1,345 @@
+#pragma once
+
+#include <Ace/Component.h>
+#include <Ace/ComponentPool.h>
+#include <Ace/EntityHandle.h>
+#include <Ace/EntityManager.h>
+#include <Ace/IntTypes.h>
+#include <Ace/Path.h>
+
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ace
+{
+
+    /**
+        @brief Versioned binary snapshots of entities, for saving and loading.
+        Every registered component pool is stored as one contiguous blob and loaded back with a
+        single copy, the hierarchy is stored as index arrays. Unregistered component types are not saved.
+        Types are identified by their registered name, register them the same way before saving and loading.
+
+        Quicksaves can store a delta against a base snapshot instead of a full one, see Diff and Patch.
+
+        For a Scene, pass its root: Snapshot::Capture(scene.GetRoot()).
+    */
+    class Snapshot final
+    {
+    public:
+
+        /**
+            @brief Appends data to a snapshot, used by component serializers.
+        */
+        class Writer final
+        {
+        public:
+
+            Writer(std::vector<UInt8>& data);
+
+            void Write(const void* data, UInt32 size);
+
+            template <typename T>
+            void Write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Write members of non trivially copyable types one by one");
+                Write(&value, sizeof(T));
+            }
+
+            void WriteString(const std::string& string);
+
+            /**
+                @brief Pads with zeros to a multiple of 16 bytes.
+            */
+            void Align();
+
+            UInt32 Tell() const;
+
+            /**
+                @brief Overwrites a previously written 32 bit value.
+            */
+            void Patch(UInt32 offset, UInt32 value);
+
+        private:
+            std::vector<UInt8>& m_data;
+        };
+
+        /**
+            @brief Reads data from a snapshot, used by component serializers. Every read is bounds checked.
+        */
+        class Reader final
+        {
+        public:
+
+            Reader(const UInt8* data, UInt32 size);
+
+            bool Read(void* data, UInt32 size);
+
+            template <typename T>
+            bool Read(T& value)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Read members of non trivially copyable types one by one");
+                return Read(&value, sizeof(T));
+            }
+
+            bool ReadString(std::string& string);
+
+            /**
+                @return Pointer to the next size bytes without copying, nullptr if out of bounds.
+            */
+            const UInt8* Skip(UInt32 size);
+
+            /**
+                @brief Skips padding up to a multiple of 16 bytes.
+            */
+            bool Align();
+
+            UInt32 Tell() const;
+
+        private:
+            const UInt8* m_data;
+            UInt32 m_size;
+            UInt32 m_offset;
+        };
+
+        template <typename CompType>
+        using SaveFunc = void(*)(const CompType&, Writer&);
+
+        template <typename CompType>
+        using LoadFunc = bool(*)(CompType&, Reader&);
+
+        /**
+            @brief Registers a trivially copyable component type, saved as a raw blob.
+            @param[in] name Name identifying the type in snapshots.
+        */
+        template <typename CompType>
+        static void Register(const std::string& name);
+
+        /**
+            @brief Registers a component type with serializers, for types that can not be copied as bytes.
+            @param[in] name Name identifying the type in snapshots.
+            @param[in] save Writes one component.
+            @param[in] load Reads one default constructed component, returns false on invalid data.
+        */
+        template <typename CompType>
+        static void Register(const std::string& name, SaveFunc<CompType> save, LoadFunc<CompType> load);
+
+        /**
+            @brief Captures every entity of a manager.
+            @return Snapshot data
+        */
+        static std::vector<UInt8> Capture(EntityManager& manager = EntityManager::DefaultManager());
+
+        /**
+            @brief Captures the descendants of root, not root itself.
+            @return Snapshot data
+        */
+        static std::vector<UInt8> Capture(EntityHandle* root);
+
+        /**
+            @brief Creates the entities of a snapshot in a manager, next to the existing ones.
+            @return False if the data is not a valid snapshot, nothing is created then.
+        */
+        static bool Restore(const UInt8* data, UInt32 size, EntityManager& manager = EntityManager::DefaultManager());
+
+        /**
+            @brief Creates the entities of a snapshot as descendants of parent.
+            @return False if the data is not a valid snapshot, nothing is created then.
+        */
+        static bool Restore(const UInt8* data, UInt32 size, EntityHandle* parent);
+
+        /**
+            @brief Writes snapshot or delta data to a file.
+        */
+        static bool Save(const Path& path, const std::vector<UInt8>& data);
+
+        /**
+            @brief Restores a snapshot file, memory mapped where possible.
+            @param[in] parent Parent of the restored entities, nullptr for the default manager.
+        */
+        static bool Load(const Path& path, EntityHandle* parent = nullptr);
+
+        /**
+            @brief Restores a delta file on top of its base snapshot file.
+            @param[in] parent Parent of the restored entities, nullptr for the default manager.
+        */
+        static bool Load(const Path& deltaPath, const Path& basePath, EntityHandle* parent = nullptr);
+
+        /**
+            @brief Creates a delta holding the blocks of current that differ from base.
+            Small when the entity and component counts have not changed since base.
+        */
+        static std::vector<UInt8> Diff(const std::vector<UInt8>& base, const std::vector<UInt8>& current);
+
+        /**
+            @brief Applies a delta created by Diff to its base.
+            @param[out] result The snapshot the delta was created from.
+            @return False if the delta is invalid or was created from a different base.
+        */
+        static bool Patch(const UInt8* base, UInt32 baseSize, const UInt8* delta, UInt32 deltaSize, std::vector<UInt8>& result);
+
+    private:
+
+        struct Context
+        {
+            std::vector<EntityHandle*> entities;
+            std::unordered_map<const EntityHandle*, UInt32> indices;
+        };
+
+        struct TypeInfo
+        {
+            std::string name;
+            UInt32 hash;
+            UInt32 elementSize;
+            void(*save)(UInt32 hash, const Context& context, Writer& writer);
+            bool(*load)(const Context& context, const UInt32* owners, UInt32 count, const UInt8* data, UInt32 size);
+        };
+
+        template <typename CompType>
+        struct Serializer
+        {
+            static SaveFunc<CompType> save;
+            static LoadFunc<CompType> load;
+        };
+
+        static void AddType(const std::string& name, UInt32 elementSize,
+            void(*save)(UInt32, const Context&, Writer&),
+            bool(*load)(const Context&, const UInt32*, UInt32, const UInt8*, UInt32));
+
+        static std::vector<TypeInfo>& GetTypes();
+
+        static void Collect(EntityHandle* entity, std::vector<EntityHandle*>& entities);
+        static std::vector<UInt8> Write(const std::vector<EntityHandle*>& entities);
+        static bool Restore(const UInt8* data, UInt32 size, EntityManager& manager, EntityHandle* parent);
+
+        static UInt32 BeginPool(Writer& writer, UInt32 hash, UInt32 elementSize, const std::vector<UInt32>& owners);
+        static void EndPool(Writer& writer, UInt32 header, UInt32 dataStart);
+
+        static void Attach(EntityHandle* entity, EntityManager::ComponentBaseHandle* handle);
+
+        template <typename CompType>
+        static void SavePool(UInt32 hash, const Context& context, Writer& writer);
+
+        template <typename CompType>
+        static bool LoadPool(const Context& context, const UInt32* owners, UInt32 count, const UInt8* data, UInt32 size);
+
+        Snapshot() = delete;
+    };
+
+    template <typename CompType>
+    Snapshot::SaveFunc<CompType> Snapshot::Serializer<CompType>::save = nullptr;
+
+    template <typename CompType>
+    Snapshot::LoadFunc<CompType> Snapshot::Serializer<CompType>::load = nullptr;
+
+    template <typename CompType>
+    void Snapshot::Register(const std::string& name)
+    {
+        static_assert(std::is_trivially_copyable<CompType>::value && !std::is_pointer<CompType>::value,
+            "Component type is not trivially copyable, register it with serializers");
+
+        Serializer<CompType>::save = nullptr;
+        Serializer<CompType>::load = nullptr;
+        AddType(name, sizeof(CompType), &SavePool<CompType>, &LoadPool<CompType>);
+    }
+
+    template <typename CompType>
+    void Snapshot::Register(const std::string& name, SaveFunc<CompType> save, LoadFunc<CompType> load)
+    {
+        Serializer<CompType>::save = save;
+        Serializer<CompType>::load = load;
+        // Element size 0 marks serialized pools.
+        AddType(name, 0u, &SavePool<CompType>, &LoadPool<CompType>);
+    }
+
+    template <typename CompType>
+    void Snapshot::SavePool(const UInt32 hash, const Context& context, Writer& writer)
+    {
+        const auto& pool = EntityManager::ComponentPool<CompType>::GetPool();
+        const SaveFunc<CompType> save = Serializer<CompType>::save;
+
+        std::vector<UInt32> owners;
+        std::vector<UInt32> selected;
+        owners.reserve(pool.m_handles.size());
+        selected.reserve(pool.m_handles.size());
+
+        for (UInt32 i = 0u; i < pool.m_handles.size(); ++i)
+        {
+            const auto itr = context.indices.find(pool.m_handles[i]->entity);
+            if (itr != context.indices.end())
+            {
+                owners.push_back(itr->second);
+                selected.push_back(i);
+            }
+        }
+
+        const UInt32 header = BeginPool(writer, hash, save ? 0u : sizeof(CompType), owners);
+        const UInt32 dataStart = writer.Tell();
+
+        if (save != nullptr)
+        {
+            for (const auto itr : selected)
+            {
+                save(pool.m_components[itr], writer);
+            }
+        }
+        else if (selected.size() == pool.m_components.size())
+        {
+            // Whole pool belongs to the snapshot, one copy.
+            writer.Write(pool.m_components.data(), static_cast<UInt32>(selected.size() * sizeof(CompType)));
+        }
+        else
+        {
+            for (const auto itr : selected)
+            {
+                writer.Write(&pool.m_components[itr], sizeof(CompType));
+            }
+        }
+
+        EndPool(writer, header, dataStart);
+    }
+
+    template <typename CompType>
+    bool Snapshot::LoadPool(const Context& context, const UInt32* owners, const UInt32 count, const UInt8* data, const UInt32 size)
+    {
+        auto& pool = EntityManager::ComponentPool<CompType>::GetPool();
+        const LoadFunc<CompType> load = Serializer<CompType>::load;
+        const UInt32 first = static_cast<UInt32>(pool.m_components.size());
+
+        if (load != nullptr)
+        {
+            pool.m_components.reserve(first + count);
+
+            Reader reader(data, size);
+            for (UInt32 i = 0u; i < count; ++i)
+            {
+                CompType component;
+                if (!load(component, reader))
+                {
+                    pool.m_components.resize(first);
+                    return false;
+                }
+                pool.m_components.push_back(component);
+            }
+        }
+        else
+        {
+            // Size checked by Restore.
+            // Snapshot blobs are 16 byte aligned, this is a single memcpy for trivially copyable types.
+            const CompType* components = reinterpret_cast<const CompType*>(data);
+            pool.m_components.insert(pool.m_components.end(), components, components + count);
+        }
+
+        pool.m_handles.reserve(first + count);
+        for (UInt32 i = 0u; i < count; ++i)
+        {
+            EntityHandle* entity = context.entities[owners[i]];
+            auto* handle = new EntityManager::ComponentHandle<CompType>(entity, first + i);
+            pool.m_handles.push_back(handle);
+            Attach(entity, handle);
+        }
+        return true;
+    }
+
+}
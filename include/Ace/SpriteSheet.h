@@ -24,9 +24,12 @@ namespace ace
 		struct SpriteData
 		{
 			/**
-				@brief SpriteName SpriteName
+				@brief Name of the sprite, stored in the sheet.
+				@see GetSpriteName
 			*/
-			std::string SpriteName;
+			UInt32 nameOffset;
+			UInt32 nameLength;
+			UInt32 nameHash;
 
             /**
             @brief sprite location
@@ -74,14 +77,40 @@ namespace ace
 		const SpriteData* GetSprite(UInt32 index) const;
 		SpriteData* GetSprite(UInt32 index);
 
+		/**
+			@return Name of the sprite
+			@param[in] sprite Sprite of this sheet
+		*/
+		std::string GetSpriteName(const SpriteData& sprite) const;
+
         /**
             @brief Adds Sprite to SpriteSheet
             @param[in] name, unique name of sprite
             @param[in] location, (non normalized) location of sprite
         */
-        void AddSprite(std::string name, const Rect& location);
+        void AddSprite(const std::string& name, const Rect& location);
+
+        /**
+            @brief Reserves space for sprites before adding them.
+            @param[in] count Amount of sprites
+            @param[in] nameBytes Total length of the sprite names
+        */
+        void Reserve(UInt32 count, UInt32 nameBytes = 0u);
 
 	private:
+		struct Parser;
+
+		void AddSprite(const char* name, UInt32 length, const Rect& location);
+		void UpdateTexcoord(SpriteData& sprite) const;
+		UInt32 FindSprite(const char* name, UInt32 length) const;
+		void Rehash(UInt32 bucketCount);
+
 		std::vector<SpriteData> sprites;
+
+		// Sprite names back to back, SpriteData points into this.
+		std::string m_names;
+
+		// Open addressed name lookup, sprite index + 1 or 0 when empty.
+		std::vector<UInt32> m_buckets;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Ace/Buffer.h>
+#include <Ace/Color.h>
+#include <Ace/GlyphAtlas.h>
+#include <Ace/TextMaterial.h>
+#include <Ace/Vector2.h>
+
+#include <vector>
+
+namespace ace
+{
+
+    /**
+        @brief Builds the vertices of many labels into one buffer, drawn with a single draw call.
+        Clear and refill the batch every frame, the vertex storage is kept between frames.
+
+        Positions are in pixels with y up, scale them to the world with TextMaterial::scale.
+        With a distance field atlas the position w component holds the edge smoothing of the glyph.
+    */
+    class TextBatch final
+    {
+    public:
+
+        /**
+            @param[in] atlas Glyphs of every label, must outlive the batch.
+        */
+        TextBatch(GlyphAtlas& atlas);
+
+        /**
+            @brief Appends a label.
+            @param[in] text UTF-8 text, may contain new lines.
+            @param[in] position Top left corner of the first line.
+            @param[in] pixelHeight Font size in pixels.
+            @param[in] color Vertex color.
+        */
+        void Add(const char* text, const Vector2& position, float pixelHeight, const Color32& color = Color32(1, 1, 1, 1));
+
+        /**
+            @return Size of a label in pixels, without adding it. Glyphs are added to the atlas.
+        */
+        Vector2 Measure(const char* text, float pixelHeight);
+
+        /**
+            @brief Removes every label, keeping the allocations.
+        */
+        void Clear();
+
+        /**
+            @brief Uploads the atlas and the vertices and draws every label.
+        */
+        void Draw(TextMaterial& material);
+
+        UInt32 GetVertexCount() const;
+
+        const std::vector<Vertex>& GetVertices() const;
+
+    private:
+
+        GlyphAtlas& m_atlas;
+        std::vector<Vertex> m_vertices;
+        Buffer m_buffer;
+    };
+
+}
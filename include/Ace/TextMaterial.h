@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Ace/Material.h>
+#include <Ace/Color.h>
+#include <Ace/GlyphAtlas.h>
+
+#include <Ace/Matrix4.h>
+
+#include <Ace/GraphicsDevice.h>
+
+namespace ace
+{
+    struct TextMaterialProperties : public Material::MaterialProperties
+    {
+        Vector2 scale, position;
+
+        math::Matrix4 model;
+
+        /**
+            @brief Screen pixels per text pixel, sharpens or softens distance field edges.
+        */
+        float pixelScale;
+
+        /**
+            @brief Single channel glyph atlas, set by TextBatch::Draw.
+        */
+        mutable Texture glyphs;
+
+        TextMaterialProperties() : scale(1, 1), position(0, 0), model(math::Matrix4::Identity()), pixelScale(1)
+        {
+
+        }
+
+        inline virtual void Apply(const Material& material) const
+        {
+            material.Uniform("Scale", scale);
+            material.Uniform("Position", position);
+            material.Uniform("Model", model);
+            material.Uniform("PixelScale", pixelScale);
+            GraphicsDevice::SetMaterial(material);
+            GraphicsDevice::SetTexture(glyphs, "Glyphs", 0);
+        }
+    };
+
+    /**
+        @brief Material for TextBatch.
+        The atlas holds coverage or distances in its only channel, the color comes from the vertices.
+    */
+    class TextMaterial : public MaterialPropertyWrapper<TextMaterialProperties>
+    {
+    public:
+
+        /**
+            @param[in] mode Must match the GlyphMode of the atlases drawn with it.
+        */
+        TextMaterial(GlyphMode mode = GlyphMode::Coverage) : MaterialPropertyWrapper(nullptr, new TextMaterialProperties()), m_mode(mode)
+        {
+            Init();
+            Apply();
+        }
+
+    protected:
+
+        const GlyphMode m_mode;
+
+        virtual void Init() const
+        {
+            Shader vert, frag;
+            vert.Create(
+            "#version 100                                                   \n"
+            "attribute vec4 a_position;                                     \n"
+            "attribute vec2 a_uv;                                           \n"
+            "attribute vec4 a_color;                                        \n"
+            "                                                               \n"
+            "varying vec4 o_c;                                              \n"
+            "varying vec2 o_uv;                                             \n"
+            "varying float o_smoothing;                                     \n"
+            "                                                               \n"
+            "uniform vec2 Position;                                         \n"
+            "uniform vec2 Scale;                                            \n"
+            "uniform mat4 Model;                                            \n"
+            "uniform mat4 VP;                                               \n"
+            "uniform float PixelScale;                                      \n"
+            "                                                               \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   o_c = a_color;                                              \n"
+            "   o_uv = a_uv;                                                \n"
+            "   o_smoothing = a_position.w / PixelScale;                    \n"
+            "                                                               \n"
+            "   vec4 pos = vec4(a_position.xyz, 1);                         \n"
+            "   pos.xy = pos.xy * Scale + Position;                         \n"
+            "                                                               \n"
+            "   gl_Position = VP * Model * pos;                             \n"
+            "}                                                              \n"
+            , ShaderType::Vertex);
+
+            // Luminance on GLES and red on desktop GL, both are in the red channel.
+            static const char* coverage =
+            "#version 100                                                   \n"
+            "precision mediump float;                                       \n"
+            "varying lowp vec4 o_c;                                         \n"
+            "varying mediump vec2 o_uv;                                     \n"
+            "                                                               \n"
+            "uniform sampler2D Glyphs;                                      \n"
+            "                                                               \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   float coverage = texture2D(Glyphs, o_uv).r;                 \n"
+            "   gl_FragColor = vec4(o_c.rgb, o_c.a * coverage);             \n"
+            "}                                                              \n";
+
+            // The edge is at 0.5, blended over about one screen pixel.
+            static const char* distanceField =
+            "#version 100                                                   \n"
+            "precision mediump float;                                       \n"
+            "varying lowp vec4 o_c;                                         \n"
+            "varying mediump vec2 o_uv;                                     \n"
+            "varying mediump float o_smoothing;                             \n"
+            "                                                               \n"
+            "uniform sampler2D Glyphs;                                      \n"
+            "                                                               \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   float field = texture2D(Glyphs, o_uv).r;                    \n"
+            "   float coverage = smoothstep(0.5 - o_smoothing, 0.5 + o_smoothing, field);    \n"
+            "   gl_FragColor = vec4(o_c.rgb, o_c.a * coverage);             \n"
+            "}                                                              \n";
+
+            frag.Create(m_mode == GlyphMode::DistanceField ? distanceField : coverage, ShaderType::Fragment);
+
+            InitImpl(GraphicsDevice::CreateMaterial(vert, frag));
+        }
+    };
+}
@@ -28,6 +28,12 @@ namespace ace
 			Creates texture from a image.
 		*/
 		Texture(const Image& image);
+
+		/**
+			@brief Initialization Constructor
+			Creates texture from a baked texture or an image file.
+		*/
+		Texture(const File& file);
 		~Texture();
 
 		/**
@@ -36,6 +42,15 @@ namespace ace
 		*/
 		bool Create(const Image& image);
 
+		/**
+			@brief Create Texture from a file.
+			Baked textures, written by the acetex tool, are mapped and every level is uploaded as is.
+			Other files are decoded as an Image.
+			@param[in] file Texture or image file.
+			@return True if the file is valid.
+		*/
+		bool Create(const File& file);
+
 		/**
 			@brief Create Texture from parameters.
 			@param[in] pixels Pixel Data
@@ -46,6 +61,12 @@ namespace ace
 		*/
 		bool Create(const UInt8* pixels, UInt32 width, UInt32 height, PixelFormat format, float pixelScale = 1000);
 
+		/**
+			@param[in] path Path of the file.
+			@return True if the path has the baked texture extension, ".acetex".
+		*/
+		static bool IsBaked(const Path& path);
+
 	protected:
 		virtual void Init() const;
 	};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Ace/IntTypes.h>
+
+namespace ace
+{
+    /**
+        On-disk layout of a baked texture, shared by the engine and the acetex tool.
+        All fields are little endian, offsets are from the start of the file.
+
+        TextureFileHeader
+        TextureFileLevel levels[levelCount]     Level 0 is the full size image.
+        pixels                                  Each level aligned to TextureFileAlignment, rows tightly packed.
+    */
+
+    static const UInt32 TextureFileMagic = 0x54454341u; // "ACET"
+    static const UInt32 TextureFileVersion = 1u;
+    static const UInt32 TextureFileAlignment = 16u;
+    static const UInt32 TextureFileMaxLevels = 16u;
+
+    enum TextureCompression : UInt32
+    {
+        TextureUncompressed = 0u,
+        TextureETC2 = 1u,       /** Reserved, not supported yet. */
+        TextureASTC4x4 = 2u,    /** Reserved, not supported yet. */
+    };
+
+    struct TextureFileHeader final
+    {
+        UInt32 magic;
+        UInt32 version;
+        UInt32 width;
+        UInt32 height;
+        UInt32 format;          /** PixelFormat */
+        UInt32 compression;     /** TextureCompression */
+        UInt32 levelCount;
+        float scale;            /** Pixels per unit, see Image::scale. */
+        UInt8 minFiltering;     /** FilteringModes */
+        UInt8 magFiltering;     /** FilteringModes */
+        UInt8 wrapModes;        /** WrapModes */
+        UInt8 mipmaps;
+        UInt32 reserved[3];
+    };
+
+    struct TextureFileLevel final
+    {
+        UInt32 offset;
+        UInt32 size;
+        UInt32 width;
+        UInt32 height;
+    };
+
+    static_assert(sizeof(TextureFileHeader) == 48u, "TextureFileHeader layout changed");
+    static_assert(sizeof(TextureFileLevel) == 16u, "TextureFileLevel layout changed");
+
+}
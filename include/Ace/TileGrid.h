@@ -0,0 +1,165 @@
+#pragma once
+
+#include <Ace/AABB.h>
+#include <Ace/IntTypes.h>
+#include <Ace/Raycast.h>
+#include <Ace/Vector2.h>
+
+#include <vector>
+
+namespace ace
+{
+    using math::Vector2;
+
+    /**
+        @brief Solid / empty bitmap of square cells for static level geometry.
+        One bit per cell, so a 1000x1000 tile level costs ~122KB instead of a collider per tile.
+        Queries only visit the cells they touch. Cells outside the grid are empty.
+        Cell (0, 0) is the bottom left cell, y grows up.
+    */
+    class TileGrid final
+    {
+    public:
+
+        struct Hit final
+        {
+            Vector2 position;
+            Vector2 normal;
+            float distance;
+            Int32 x;
+            Int32 y;
+
+            Hit();
+        };
+
+        TileGrid();
+
+        /**
+            @brief TileGrid constructor, all cells empty.
+            @param[in] width Number of columns.
+            @param[in] height Number of rows.
+            @param[in] origin World position of the bottom left corner.
+            @param[in] cellSize Width and height of a cell in world units.
+        */
+        TileGrid(const UInt32 width, const UInt32 height, const Vector2& origin, const float cellSize);
+
+        /**
+            @brief Resizes the grid and clears all cells.
+        */
+        void Reset(const UInt32 width, const UInt32 height, const Vector2& origin, const float cellSize);
+
+        /**
+            @return True if the cell is solid. False outside the grid.
+        */
+        inline bool IsSolid(const Int32 x, const Int32 y) const
+        {
+            return IsInside(x, y) && (m_bits[Word(x, y)] & Bit(x)) != 0u;
+        }
+
+        /**
+            @brief Marks a cell solid or empty. No effect outside the grid.
+        */
+        void SetSolid(const Int32 x, const Int32 y, const bool solid = true);
+
+        /**
+            @return True if the point is inside a solid cell.
+        */
+        bool IsColliding(const Vector2& point) const;
+
+        /**
+            @return True if the AABB overlaps a solid cell. Touching edges do not count.
+        */
+        bool IsColliding(const AABB& aabb) const;
+
+        /**
+            @brief Walks the cells along the ray, stops at the first solid cell.
+            @param[in] ray Ray to cast.
+            @param[in] length Maximum distance.
+            @param[out] hit Entry point, surface normal and cell of the hit.
+            @return True if a solid cell was hit. A ray starting inside a solid cell hits at distance 0.
+        */
+        bool Raycast(const ace::Raycast& ray, const float length, Hit& hit) const;
+
+        /**
+            @brief Moves a box along X and then Y, stopping at the first solid cell on each axis.
+            @param[in] aabb Box at the start of the motion, assumed not to overlap solid cells.
+            @param[in] motion Desired displacement.
+            @param[out] normal Optional. Sum of the normals of the surfaces hit, zero if none.
+            @return Displacement that can be applied without entering solid cells.
+        */
+        Vector2 Sweep(const AABB& aabb, const Vector2& motion, Vector2* normal = nullptr) const;
+
+        /**
+            @brief Merges solid cells into as few rectangles as possible, e.g. for static physics bodies.
+            @return World space boxes covering every solid cell exactly once.
+        */
+        std::vector<AABB> Merge() const;
+
+        /**
+            @return Cell containing the world position. May be outside the grid.
+        */
+        void GetCell(const Vector2& position, Int32& x, Int32& y) const;
+
+        /**
+            @return World space box of the cell.
+        */
+        AABB GetCellBounds(const Int32 x, const Int32 y) const;
+
+        inline UInt32 GetWidth() const
+        {
+            return m_width;
+        }
+
+        inline UInt32 GetHeight() const
+        {
+            return m_height;
+        }
+
+        inline const Vector2& GetOrigin() const
+        {
+            return m_origin;
+        }
+
+        inline float GetCellSize() const
+        {
+            return m_cellSize;
+        }
+
+        /**
+            @return Size of the bitmap in bytes.
+        */
+        inline UInt32 GetMemoryUsage() const
+        {
+            return static_cast<UInt32>(m_bits.size() * sizeof(UInt32));
+        }
+
+        inline bool IsInside(const Int32 x, const Int32 y) const
+        {
+            return static_cast<UInt32>(x) < m_width && static_cast<UInt32>(y) < m_height;
+        }
+
+    private:
+
+        inline UInt32 Word(const Int32 x, const Int32 y) const
+        {
+            return y * m_stride + (x >> 5);
+        }
+
+        inline static UInt32 Bit(const Int32 x)
+        {
+            return 1u << (x & 31);
+        }
+
+        bool IsRowSolid(const Int32 y, Int32 x0, Int32 x1) const;
+
+        std::vector<UInt32> m_bits;
+        UInt32 m_width;
+        UInt32 m_height;
+        UInt32 m_stride;
+        Vector2 m_origin;
+        float m_cellSize;
+        float m_inverseCellSize;
+
+    };
+
+}
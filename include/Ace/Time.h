@@ -34,12 +34,53 @@ namespace ace
 		static UInt64 GetPerformanceFrequency();
 
 		/**
-			@brief Returns elapsed time since the game last updated.
+			@brief Returns elapsed time since the game last updated, smoothed over a few frames.
+			Frames longer than a quarter second, such as after a breakpoint, count as a quarter second.
 			@return Delta Time
 		*/
 		static float DeltaTime();
 
+		/**
+			@brief Returns elapsed time since the game last updated, unsmoothed but clamped like DeltaTime.
+			@return Delta Time
+		*/
+		static float RawDeltaTime();
+
+		/**
+			@brief Consumes one fixed step of the time accumulated by Update.
+			Call in a loop after ace::Update and advance the simulation by GetFixedTimeStep per call.
+			At most eight steps accumulate, a slower simulation falls behind instead of spiralling.
+			@return True while a step is due.
+		*/
+		static bool FixedUpdate();
+
+		/**
+			@brief Sets the fixed step length, 1/60 seconds by default.
+			@param[in] seconds Step length, positive.
+		*/
+		static void SetFixedTimeStep(float seconds);
+
+		static float GetFixedTimeStep();
 
+		/**
+			@brief Returns how far between the last two fixed steps the current frame is, from 0 to 1.
+			Interpolate rendered state from the previous step to the last one by it.
+			@return Interpolation alpha
+		*/
+		static float GetAlpha();
+
+		/**
+			@brief Limits Update to a number of frames per second, sleeping for most of the wait and
+			spinning only for the last couple of milliseconds. 0 disables the limit, the default.
+			@param[in] framesPerSecond Frame rate limit.
+		*/
+		static void SetFrameLimit(float framesPerSecond);
+
+		static float GetFrameLimit();
+
+		/**
+			@brief Starts a frame: waits for the frame limit, then measures the delta time and accumulates it for FixedUpdate.
+		*/
 		static void Update();
 		
 		struct WaitTime
@@ -14,6 +14,12 @@ namespace ace
         Quaternion rotation;
         Vector3 scale;
 
+        /**
+            @brief Incremented every time Scene::Update changes the model matrix.
+            Systems can compare against a stored value to skip unchanged transforms.
+        */
+        UInt32 version;
+
 
         /**
             @brief Transform class, XYZ-coodrinates
@@ -29,7 +35,8 @@ namespace ace
             model(Matrix4::Identity()),
             position(position),
             rotation(rotation),
-            scale(scale)
+            scale(scale),
+            version(0u)
         {
 
         }
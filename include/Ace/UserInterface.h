@@ -47,8 +47,9 @@ namespace ace
             @brief Creates and shows default Acerba debug information. Doesn't need to be places in a group.
             @param[in] size Size of the group in pixels.
             @param[in] position Position of the group in pixels.
+            @param[in] renderStats Also shows GraphicsDevice::GetStats of the last frame.
         */
-        static void Debug(const Vector2* size = nullptr, const Vector2* position = nullptr);
+        static void Debug(const Vector2* size = nullptr, const Vector2* position = nullptr, bool renderStats = false);
 
         /**
             @brief Initializes UI to use target window.
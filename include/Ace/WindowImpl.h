@@ -17,13 +17,13 @@ namespace ace
 
 	void SetGLStatus(bool ok);
 
-	struct Window::WindowImpl : public EventBase<Event::SDLEventArg>
+	struct Window::WindowImpl : public EventBase<WindowEvent>
 	{
 		SDL_Window* sdlWindow;
 		SDL_GLContext context;
 		bool isClosed;
 
-		WindowImpl(const char* title, UInt16 w, UInt16 h) : sdlWindow(SDL_CreateWindow(title, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, w, h, SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE)), isClosed(false)
+		WindowImpl(const char* title, UInt16 w, UInt16 h) : EventBase(0, EventMask(WindowEventType::Close) | EventMask(WindowEventType::Resized)), sdlWindow(SDL_CreateWindow(title, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, w, h, SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE)), isClosed(false)
 		{
 			// "Pre" Init
 
@@ -60,24 +60,21 @@ namespace ace
 			SDL_GL_DeleteContext(context);
 		}
 
-		virtual void OnEvent(Event::SDLEventArg eventArg)
+		virtual void OnEvent(WindowEvent windowEvent)
 		{
-			if (eventArg.event.type == SDL_WINDOWEVENT)
+			switch (windowEvent.type)
 			{
-				switch (eventArg.event.window.event)
-				{
 
-				case SDL_WINDOWEVENT_CLOSE:
-					isClosed = true;
-					break;
+			case WindowEventType::Close:
+				isClosed = true;
+				break;
 
-				case SDL_WINDOWEVENT_RESIZED:
-					GraphicsDevice::Viewport(eventArg.event.window.data1, eventArg.event.window.data2);
-					break;
+			case WindowEventType::Resized:
+				GraphicsDevice::Viewport(windowEvent.data1, windowEvent.data2);
+				break;
 
-				default:
-					break;
-				}
+			default:
+				break;
 			}
 		}
 	};
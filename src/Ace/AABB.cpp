@@ -15,9 +15,9 @@ namespace ace
         for (const auto& vertex : c.GetVertices())
         {
             if (vertex.x < min.x) min.x = vertex.x;
-            else if (max.x < vertex.x) max.x = vertex.x;
+            if (max.x < vertex.x) max.x = vertex.x;
             if (vertex.y < min.y) min.y = vertex.y;
-            else if (max.y < vertex.y) max.y = vertex.y;
+            if (max.y < vertex.y) max.y = vertex.y;
         }
     }
 
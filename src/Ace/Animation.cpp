@@ -6,17 +6,10 @@
 #include <Ace/Time.h>
 
 #include <algorithm>
+#include <unordered_map>
 
 namespace ace
 {
-	Int32 animationExists(const std::vector<Animation::AnimationData>& anim, const std::string& name)
-	{
-		for (Int32 i = 0; i < anim.size(); ++i)
-			if (anim[i].animation == name)
-				return i;
-		return -1;
-	}
-
 	static UInt32 GetNameIndex(const std::string& name)
 	{
 		static const char s_numbers[] = {
@@ -58,28 +51,29 @@ namespace ace
 		m_currentAnimation(nullptr)
 
 	{
+		// Animation index by name, a linear search per frame is quadratic for large sheets.
+		std::unordered_map<std::string, UInt32> indices;
+
 		m_animations.reserve(sheet.GetSpriteCount());
-		for (UInt16 i = 0u; i < sheet.GetSpriteCount(); ++i)
+		for (UInt32 i = 0u; i < sheet.GetSpriteCount(); ++i)
 		{
+			// 1. Parse Sprite Name (no index)
+			// 2. Group Sprites by Name. (+ index)
+			// 3. Store Groups (animations) inside vector
 			const SpriteSheet::SpriteData& sprite = *sheet.GetSprite(i);
-			const std::string name = sprite.SpriteName.substr(0, GetNameIndex(sprite.SpriteName));
+			std::string name = sheet.GetSpriteName(sprite);
+			name.resize(GetNameIndex(name));
 
-			Int32 index = animationExists(m_animations, name);
-
-			if (index == -1)
+			const auto result = indices.emplace(name, static_cast<UInt32>(m_animations.size()));
+			if (result.second)
 			{
-				index = m_animations.size();
 				m_animations.emplace_back(AnimationData(name));
 			}
 
-			m_animations[index].frames.emplace_back(sprite);
-
-			m_spriteSheet = sheet.image;
-
-			// 1. Parse Sprite Name (no index)
-			// 2. Group Sprites by Name. (+ index) 
-			// 3. Store Groups (animations) inside vector
+			m_animations[result.first->second].frames.push_back(sprite);
 		}
+
+		m_spriteSheet = sheet.image;
 	}
 
 	Animation::~Animation()
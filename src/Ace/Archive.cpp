@@ -0,0 +1,261 @@
+#include <Ace/Archive.h>
+#include <Ace/Log.h>
+
+#include <cstring> // memcpy, memcmp
+#include <vector>
+
+namespace ace
+{
+    struct MountedArchive
+    {
+        File::View view;
+        const ArchiveHeader* header;
+        const UInt32* buckets;
+        const ArchiveEntry* entries;
+        const char* names;
+        std::string root;
+    };
+
+    static std::vector<MountedArchive> g_archives;
+
+    // LZ4 block format decoder, the output size is known from the entry.
+    static bool DecompressLZ4(const UInt8* source, const UInt32 sourceSize, UInt8* destination, const UInt32 destinationSize)
+    {
+        const UInt8* in = source;
+        const UInt8* const inEnd = source + sourceSize;
+        UInt8* out = destination;
+        UInt8* const outEnd = destination + destinationSize;
+
+        while (in < inEnd)
+        {
+            const UInt32 token = *in++;
+
+            UInt32 literals = token >> 4u;
+            if (literals == 15u)
+            {
+                UInt8 extra;
+                do
+                {
+                    if (in >= inEnd) return false;
+                    extra = *in++;
+                    literals += extra;
+                } while (extra == 255u);
+            }
+
+            if (literals > static_cast<UInt32>(inEnd - in) || literals > static_cast<UInt32>(outEnd - out))
+            {
+                return false;
+            }
+            std::memcpy(out, in, literals);
+            in += literals;
+            out += literals;
+
+            // The last sequence has literals only.
+            if (in >= inEnd)
+            {
+                break;
+            }
+
+            if (inEnd - in < 2)
+            {
+                return false;
+            }
+            const UInt32 offset = in[0] | (in[1] << 8u);
+            in += 2;
+
+            if (offset == 0u || offset > static_cast<UInt32>(out - destination))
+            {
+                return false;
+            }
+
+            UInt32 length = (token & 15u) + 4u;
+            if ((token & 15u) == 15u)
+            {
+                UInt8 extra;
+                do
+                {
+                    if (in >= inEnd) return false;
+                    extra = *in++;
+                    length += extra;
+                } while (extra == 255u);
+            }
+
+            if (length > static_cast<UInt32>(outEnd - out))
+            {
+                return false;
+            }
+
+            // Byte by byte, the match may overlap the output.
+            const UInt8* match = out - offset;
+            for (UInt32 i = 0u; i < length; ++i)
+            {
+                out[i] = match[i];
+            }
+            out += length;
+        }
+        return out == outEnd;
+    }
+
+    static const ArchiveEntry* FindEntry(const MountedArchive& archive, const std::string& path)
+    {
+        if (path.size() <= archive.root.size() || path.compare(0u, archive.root.size(), archive.root) != 0)
+        {
+            return nullptr;
+        }
+
+        const char* name = path.c_str() + archive.root.size();
+        const UInt32 length = static_cast<UInt32>(path.size() - archive.root.size());
+        const UInt32 hash = ArchiveHash(name, length);
+        const UInt32 mask = archive.header->bucketCount - 1u;
+
+        // Linear probing, the packer keeps the table at most half full.
+        UInt32 bucket = hash & mask;
+        for (UInt32 probe = 0u; probe < archive.header->bucketCount; ++probe, bucket = (bucket + 1u) & mask)
+        {
+            const UInt32 index = archive.buckets[bucket];
+            if (index == 0u)
+            {
+                return nullptr;
+            }
+
+            const ArchiveEntry& entry = archive.entries[index - 1u];
+            if (entry.hash == hash && entry.nameLength == length && std::memcmp(archive.names + entry.nameOffset, name, length) == 0)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    static const ArchiveEntry* FindEntry(const std::string& path, const MountedArchive*& owner)
+    {
+        for (auto itr = g_archives.rbegin(); itr != g_archives.rend(); ++itr)
+        {
+            const ArchiveEntry* entry = FindEntry(*itr, path);
+            if (entry != nullptr)
+            {
+                owner = &*itr;
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    bool Archive::Mount(const Path& path)
+    {
+        File file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        MountedArchive archive;
+        archive.view = file.Map();
+
+        const UInt8* data = archive.view.Get();
+        const UInt32 size = archive.view.size;
+        archive.header = reinterpret_cast<const ArchiveHeader*>(data);
+
+        if (size < sizeof(ArchiveHeader) || archive.header->magic != ArchiveMagic || archive.header->version != ArchiveVersion)
+        {
+            Logger::LogError("Archive: Not a valid archive: %s", path.GetPath().c_str());
+            return false;
+        }
+
+        const ArchiveHeader& header = *archive.header;
+        const UInt32 tableSize = size - static_cast<UInt32>(sizeof(ArchiveHeader));
+
+        // Bounds are checked as a > size || b > size - a, sums of untrusted fields may wrap.
+        if (header.bucketCount == 0u || (header.bucketCount & (header.bucketCount - 1u)) != 0u ||
+            header.entryCount >= header.bucketCount || header.bucketCount > tableSize / sizeof(UInt32) ||
+            header.entryCount > (tableSize - header.bucketCount * sizeof(UInt32)) / sizeof(ArchiveEntry) ||
+            header.namesOffset > size || header.namesSize > size - header.namesOffset)
+        {
+            Logger::LogError("Archive: Corrupted table of contents: %s", path.GetPath().c_str());
+            return false;
+        }
+
+        archive.buckets = reinterpret_cast<const UInt32*>(data + sizeof(ArchiveHeader));
+        archive.entries = reinterpret_cast<const ArchiveEntry*>(archive.buckets + header.bucketCount);
+        archive.names = reinterpret_cast<const char*>(data + header.namesOffset);
+        archive.root = Path("").GetPath();
+
+        // Lookups index entries by bucket without checking.
+        for (UInt32 i = 0u; i < header.bucketCount; ++i)
+        {
+            if (archive.buckets[i] > header.entryCount)
+            {
+                Logger::LogError("Archive: Corrupted bucket %u: %s", i, path.GetPath().c_str());
+                return false;
+            }
+        }
+
+        for (UInt32 i = 0u; i < header.entryCount; ++i)
+        {
+            const ArchiveEntry& entry = archive.entries[i];
+            // Stored entries are returned as views of the mapping, their size must be what is packed.
+            if (entry.offset > size || entry.packedSize > size - entry.offset ||
+                ((entry.flags & ArchiveLZ4) == 0u && entry.size != entry.packedSize) ||
+                entry.nameOffset > header.namesSize || entry.nameLength > header.namesSize - entry.nameOffset)
+            {
+                Logger::LogError("Archive: Corrupted entry %u: %s", i, path.GetPath().c_str());
+                return false;
+            }
+        }
+
+        g_archives.push_back(std::move(archive));
+        return true;
+    }
+
+    void Archive::UnmountAll()
+    {
+        g_archives.clear();
+    }
+
+    bool Archive::Contains(const std::string& path)
+    {
+        const MountedArchive* owner = nullptr;
+        return FindEntry(path, owner) != nullptr;
+    }
+
+    File::View Archive::Find(const std::string& path)
+    {
+        File::View view;
+
+        const MountedArchive* owner = nullptr;
+        const ArchiveEntry* entry = FindEntry(path, owner);
+        if (entry == nullptr)
+        {
+            return view;
+        }
+
+        const UInt8* blob = owner->view.Get() + entry->offset;
+
+        if ((entry->flags & ArchiveLZ4) == 0u)
+        {
+            // Aliases the archive mapping, which stays alive as long as the view.
+            view.data = std::shared_ptr<const UInt8>(owner->view.data, blob);
+            view.size = entry->size;
+            view.isMapped = owner->view.isMapped;
+            return view;
+        }
+
+        UInt8* buffer = new UInt8[entry->size];
+        if (!DecompressLZ4(blob, entry->packedSize, buffer, entry->size))
+        {
+            Logger::LogError("Archive: Failed to decompress: %s", path.c_str());
+            delete[] buffer;
+            return view;
+        }
+
+        view.data = std::shared_ptr<const UInt8>(buffer, std::default_delete<const UInt8[]>());
+        view.size = entry->size;
+        return view;
+    }
+
+    UInt32 Archive::GetMountCount()
+    {
+        return static_cast<UInt32>(g_archives.size());
+    }
+
+}
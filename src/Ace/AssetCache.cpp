@@ -0,0 +1,345 @@
+#include <Ace/AssetCache.h>
+
+#include <Ace/Audio.h>
+#include <Ace/File.h>
+#include <Ace/Font.h>
+#include <Ace/Image.h>
+#include <Ace/SpriteSheet.h>
+#include <Ace/Texture.h>
+
+#include <SDL_mutex.h>
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace ace
+{
+    struct CacheEntry
+    {
+        std::shared_ptr<void> asset;
+        UInt64 size;
+        UInt64 key;
+        std::list<CacheEntry*>::iterator lru;
+    };
+
+    struct CacheState
+    {
+        SDL_mutex* mutex;
+
+        std::unordered_map<std::string, AssetCache::PathID> pathIDs;
+        std::vector<std::string> paths;
+
+        // Keyed by (type << 32 | path), most recently used at the front.
+        std::unordered_map<UInt64, CacheEntry> entries;
+        std::list<CacheEntry*> lru;
+
+        UInt64 budget;
+        UInt32 nextTypeID;
+        AssetCache::Stats stats;
+
+        CacheState() :
+            mutex(SDL_CreateMutex()),
+            pathIDs(),
+            paths(),
+            entries(),
+            lru(),
+            budget(256u << 20u),
+            nextTypeID(0u),
+            stats()
+        {
+
+        }
+
+        ~CacheState()
+        {
+            SDL_DestroyMutex(mutex);
+        }
+    };
+
+    static CacheState& GetState()
+    {
+        static CacheState state;
+        return state;
+    }
+
+    struct CacheLock final
+    {
+        CacheLock() { SDL_LockMutex(GetState().mutex); }
+        ~CacheLock() { SDL_UnlockMutex(GetState().mutex); }
+    };
+
+    static inline UInt64 MakeKey(const UInt32 type, const AssetCache::PathID path)
+    {
+        return (static_cast<UInt64>(type) << 32u) | path;
+    }
+
+    // "a\\b/./c/../d" -> "a/b/d"
+    static std::string Normalize(const std::string& path)
+    {
+        std::vector<std::string> segments;
+        std::string segment;
+
+        for (UInt32 i = 0u; i <= path.size(); ++i)
+        {
+            if (i < path.size() && path[i] != '/' && path[i] != '\\')
+            {
+                segment.push_back(path[i]);
+                continue;
+            }
+
+            if (segment == ".." && !segments.empty() && segments.back() != "..")
+            {
+                segments.pop_back();
+            }
+            else if (!segment.empty() && segment != ".")
+            {
+                segments.push_back(segment);
+            }
+            segment.clear();
+        }
+
+        std::string result;
+        result.reserve(path.size());
+        if (!path.empty() && (path[0] == '/' || path[0] == '\\'))
+        {
+            result.push_back('/');
+        }
+
+        for (UInt32 i = 0u; i < segments.size(); ++i)
+        {
+            if (i > 0u)
+            {
+                result.push_back('/');
+            }
+            result += segments[i];
+        }
+        return result;
+    }
+
+    AssetCache::Stats::Stats() :
+        hits(0u), misses(0u), evictions(0u), entries(0u), bytes(0u)
+    {
+
+    }
+
+    AssetCache::PathID AssetCache::Intern(const std::string& path)
+    {
+        const std::string normalized(Normalize(path));
+
+        CacheState& state = GetState();
+        CacheLock lock;
+
+        const auto itr = state.pathIDs.find(normalized);
+        if (itr != state.pathIDs.end())
+        {
+            return itr->second;
+        }
+
+        const PathID id = static_cast<PathID>(state.paths.size());
+        state.paths.push_back(normalized);
+        state.pathIDs.emplace(normalized, id);
+        return id;
+    }
+
+    std::string AssetCache::GetPath(const PathID id)
+    {
+        CacheState& state = GetState();
+        CacheLock lock;
+        return id < state.paths.size() ? state.paths[id] : std::string();
+    }
+
+    void AssetCache::SetBudget(const UInt64 bytes)
+    {
+        CacheLock lock;
+        GetState().budget = bytes;
+    }
+
+    UInt64 AssetCache::GetBudget()
+    {
+        CacheLock lock;
+        return GetState().budget;
+    }
+
+    void AssetCache::Update()
+    {
+        // Released outside the lock, destructors may be slow or call back into the cache.
+        std::vector<std::shared_ptr<void>> evicted;
+
+        {
+            CacheState& state = GetState();
+            CacheLock lock;
+
+            auto itr = state.lru.end();
+            while (state.stats.bytes > state.budget && itr != state.lru.begin())
+            {
+                CacheEntry* entry = *(--itr);
+
+                // Still referenced outside the cache, evicting would not free anything.
+                if (entry->asset.use_count() > 1)
+                {
+                    continue;
+                }
+
+                evicted.push_back(std::move(entry->asset));
+                state.stats.bytes -= entry->size;
+                ++state.stats.evictions;
+                --state.stats.entries;
+
+                itr = state.lru.erase(itr);
+                state.entries.erase(entry->key);
+            }
+        }
+    }
+
+    void AssetCache::Clear()
+    {
+        std::unordered_map<UInt64, CacheEntry> entries;
+
+        {
+            CacheState& state = GetState();
+            CacheLock lock;
+
+            entries.swap(state.entries);
+            state.lru.clear();
+            state.stats.bytes = 0u;
+            state.stats.entries = 0u;
+        }
+    }
+
+    AssetCache::Stats AssetCache::GetStats()
+    {
+        CacheLock lock;
+        return GetState().stats;
+    }
+
+    void AssetCache::ResetStats()
+    {
+        CacheState& state = GetState();
+        CacheLock lock;
+        state.stats.hits = 0u;
+        state.stats.misses = 0u;
+        state.stats.evictions = 0u;
+    }
+
+    UInt32 AssetCache::NextTypeID()
+    {
+        CacheLock lock;
+        return GetState().nextTypeID++;
+    }
+
+    std::shared_ptr<void> AssetCache::FindEntry(const UInt32 type, const PathID path, const bool countStats)
+    {
+        CacheState& state = GetState();
+        CacheLock lock;
+
+        const auto itr = state.entries.find(MakeKey(type, path));
+        if (itr == state.entries.end())
+        {
+            state.stats.misses += countStats ? 1u : 0u;
+            return nullptr;
+        }
+
+        state.stats.hits += countStats ? 1u : 0u;
+        state.lru.splice(state.lru.begin(), state.lru, itr->second.lru);
+        return itr->second.asset;
+    }
+
+    std::shared_ptr<void> AssetCache::InsertEntry(const UInt32 type, const PathID path, const std::shared_ptr<void>& asset, const UInt64 size)
+    {
+        CacheState& state = GetState();
+        CacheLock lock;
+
+        const UInt64 key = MakeKey(type, path);
+        const auto result = state.entries.emplace(key, CacheEntry());
+        CacheEntry& entry = result.first->second;
+
+        if (!result.second)
+        {
+            return entry.asset;
+        }
+
+        entry.asset = asset;
+        entry.size = size;
+        entry.key = key;
+        state.lru.push_front(&entry);
+        entry.lru = state.lru.begin();
+
+        state.stats.bytes += size;
+        ++state.stats.entries;
+        return asset;
+    }
+
+    template <>
+    std::shared_ptr<Image> AssetCache::Create<Image>(const Path& path)
+    {
+        return std::make_shared<Image>(File(path));
+    }
+
+    template <>
+    std::shared_ptr<Texture> AssetCache::Create<Texture>(const Path& path)
+    {
+        if (Texture::IsBaked(path))
+        {
+            return std::make_shared<Texture>(File(path));
+        }
+
+        // Shares the decoded pixels with anything else using the same image.
+        return std::make_shared<Texture>(*Get<Image>(path));
+    }
+
+    template <>
+    std::shared_ptr<SpriteSheet> AssetCache::Create<SpriteSheet>(const Path& path)
+    {
+        return std::make_shared<SpriteSheet>(path);
+    }
+
+    template <>
+    std::shared_ptr<Font> AssetCache::Create<Font>(const Path& path)
+    {
+        return std::make_shared<Font>(File(path));
+    }
+
+    template <>
+    std::shared_ptr<AudioClip> AssetCache::Create<AudioClip>(const Path& path)
+    {
+        return std::make_shared<AudioClip>(File(path));
+    }
+
+    template <>
+    UInt64 AssetCache::SizeOf<Image>(const Image& asset)
+    {
+        return static_cast<UInt64>(asset.w) * asset.h * static_cast<UInt64>(asset.format);
+    }
+
+    template <>
+    UInt64 AssetCache::SizeOf<Texture>(const Texture& asset)
+    {
+        // GPU memory, uploaded as 4 bytes per texel at most. A mip chain adds a third.
+        const UInt64 size = static_cast<UInt64>(asset.size.x * asset.size.y) * 4u;
+        return asset.flags.mipmaps ? size + size / 3u : size;
+    }
+
+    template <>
+    UInt64 AssetCache::SizeOf<SpriteSheet>(const SpriteSheet& asset)
+    {
+        // Pixels are accounted for by the cached Image.
+        return asset.GetSpriteCount() * sizeof(SpriteSheet::SpriteData);
+    }
+
+    template <>
+    UInt64 AssetCache::SizeOf<Font>(const Font& asset)
+    {
+        UInt32 size = 0u;
+        asset.GetBuffer(size);
+        return size;
+    }
+
+    template <>
+    UInt64 AssetCache::SizeOf<AudioClip>(const AudioClip&)
+    {
+        // Sample data lives in OpenAL buffers, not visible from here.
+        return 0u;
+    }
+
+}
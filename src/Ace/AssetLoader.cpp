@@ -0,0 +1,340 @@
+#include <Ace/AssetLoader.h>
+
+#include <Ace/AssetCache.h>
+#include <Ace/File.h>
+#include <Ace/Log.h>
+#include <Ace/Profiler.h>
+#include <Ace/Time.h>
+
+#include <SDL_atomic.h>
+#include <SDL_cpuinfo.h>
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
+#include <SDL_timer.h>
+
+#include <deque>
+#include <vector>
+
+namespace ace
+{
+    // Upload and what to do if it is dropped by Quit instead.
+    struct Upload
+    {
+        AssetLoader::Job job;
+        AssetLoader::Job drop;
+    };
+
+    struct WorkerPool
+    {
+        std::vector<SDL_Thread*> threads;
+        SDL_mutex* mutex;
+        SDL_cond* condition;
+        std::deque<AssetLoader::Job> jobs;
+        bool isRunning;
+
+        SDL_mutex* uploadMutex;
+        std::deque<Upload> uploads;
+
+        SDL_atomic_t pending;
+        float budget;
+
+        WorkerPool() :
+            threads(),
+            mutex(nullptr),
+            condition(nullptr),
+            jobs(),
+            isRunning(false),
+            uploadMutex(nullptr),
+            uploads(),
+            pending(),
+            budget(2.f)
+        {
+
+        }
+    };
+
+    static WorkerPool g_pool;
+
+    // Worker thread, runs jobs until Quit and the queue is empty.
+    static int WorkerUpdate(void*)
+    {
+        ACE_PROFILE_THREAD("AssetLoader");
+
+        while (true)
+        {
+            SDL_LockMutex(g_pool.mutex);
+            while (g_pool.isRunning && g_pool.jobs.empty())
+            {
+                SDL_CondWait(g_pool.condition, g_pool.mutex);
+            }
+
+            if (g_pool.jobs.empty())
+            {
+                SDL_UnlockMutex(g_pool.mutex);
+                return 0;
+            }
+
+            AssetLoader::Job job(std::move(g_pool.jobs.front()));
+            g_pool.jobs.pop_front();
+            SDL_UnlockMutex(g_pool.mutex);
+
+            ACE_PROFILE_SCOPE("AssetLoader::Job");
+            job();
+        }
+    }
+
+    // Pops one upload, returns false if there were none.
+    static bool RunUpload()
+    {
+        AssetLoader::Job job;
+
+        SDL_LockMutex(g_pool.uploadMutex);
+        if (!g_pool.uploads.empty())
+        {
+            job = std::move(g_pool.uploads.front().job);
+            g_pool.uploads.pop_front();
+        }
+        SDL_UnlockMutex(g_pool.uploadMutex);
+
+        if (!job)
+        {
+            return false;
+        }
+
+        ACE_PROFILE_SCOPE("AssetLoader::Upload");
+        job();
+        return true;
+    }
+
+    void AssetLoader::Init(UInt32 threads)
+    {
+        if (g_pool.isRunning)
+        {
+            return;
+        }
+
+        if (threads == 0u)
+        {
+            threads = static_cast<UInt32>(SDL_GetCPUCount() > 1 ? SDL_GetCPUCount() - 1 : 1);
+        }
+
+        g_pool.mutex = SDL_CreateMutex();
+        g_pool.condition = SDL_CreateCond();
+        g_pool.uploadMutex = SDL_CreateMutex();
+        g_pool.isRunning = true;
+
+        for (UInt32 i = 0u; i < threads; ++i)
+        {
+            SDL_Thread* thread = SDL_CreateThread(WorkerUpdate, "AssetLoader", nullptr);
+
+            if (thread == nullptr)
+            {
+                Logger::LogError("AssetLoader: Failed to create a worker thread: %s", SDL_GetError());
+                break;
+            }
+            g_pool.threads.push_back(thread);
+        }
+    }
+
+    void AssetLoader::Quit()
+    {
+        if (!g_pool.isRunning)
+        {
+            return;
+        }
+
+        SDL_LockMutex(g_pool.mutex);
+        g_pool.isRunning = false;
+        SDL_CondBroadcast(g_pool.condition);
+        SDL_UnlockMutex(g_pool.mutex);
+
+        for (auto& itr : g_pool.threads)
+        {
+            SDL_WaitThread(itr, nullptr);
+        }
+        g_pool.threads.clear();
+
+        // Graphics may already be gone, remaining uploads are dropped and their handles fail.
+        if (!g_pool.uploads.empty())
+        {
+            Logger::LogInfo("AssetLoader: Dropped %u uploads on quit", static_cast<UInt32>(g_pool.uploads.size()));
+            for (const Upload& upload : g_pool.uploads)
+            {
+                if (upload.drop)
+                {
+                    upload.drop();
+                }
+            }
+            g_pool.uploads.clear();
+        }
+        SDL_AtomicSet(&g_pool.pending, 0);
+
+        SDL_DestroyCond(g_pool.condition);
+        SDL_DestroyMutex(g_pool.mutex);
+        SDL_DestroyMutex(g_pool.uploadMutex);
+        g_pool.condition = nullptr;
+        g_pool.mutex = nullptr;
+        g_pool.uploadMutex = nullptr;
+    }
+
+    void AssetLoader::Update()
+    {
+        if (g_pool.uploadMutex == nullptr)
+        {
+            return;
+        }
+
+        ACE_PROFILE_SCOPE("AssetLoader::Update");
+
+        const UInt64 start = Time::GetPerformanceCounter();
+        const UInt64 budget = static_cast<UInt64>(g_pool.budget * 0.001f * Time::GetPerformanceFrequency());
+
+        while (RunUpload() && Time::GetPerformanceCounter() - start < budget)
+        {
+
+        }
+    }
+
+    void AssetLoader::SetUploadBudget(const float milliseconds)
+    {
+        g_pool.budget = milliseconds;
+    }
+
+    UInt32 AssetLoader::GetPendingCount()
+    {
+        return static_cast<UInt32>(SDL_AtomicGet(&g_pool.pending));
+    }
+
+    void AssetLoader::WaitAll()
+    {
+        while (GetPendingCount() > 0u)
+        {
+            Pump();
+        }
+    }
+
+    void AssetLoader::Run(const Job& job)
+    {
+        // Without workers the loader degrades to blocking loads.
+        if (!g_pool.isRunning || g_pool.threads.empty())
+        {
+            job();
+            return;
+        }
+
+        SDL_LockMutex(g_pool.mutex);
+        g_pool.jobs.push_back(job);
+        SDL_CondSignal(g_pool.condition);
+        SDL_UnlockMutex(g_pool.mutex);
+    }
+
+    void AssetLoader::RunOnRenderThread(const Job& job)
+    {
+        RunOnRenderThread(job, Job());
+    }
+
+    void AssetLoader::RunOnRenderThread(const Job& job, const Job& drop)
+    {
+        if (g_pool.uploadMutex == nullptr)
+        {
+            job();
+            return;
+        }
+
+        SDL_LockMutex(g_pool.uploadMutex);
+        g_pool.uploads.push_back({ job, drop });
+        SDL_UnlockMutex(g_pool.uploadMutex);
+    }
+
+    void AssetLoader::Begin()
+    {
+        SDL_AtomicAdd(&g_pool.pending, 1);
+    }
+
+    void AssetLoader::Finish()
+    {
+        SDL_AtomicAdd(&g_pool.pending, -1);
+    }
+
+    void AssetLoader::Pump()
+    {
+        bool hasRun = false;
+        while (RunUpload())
+        {
+            hasRun = true;
+        }
+
+        if (!hasRun)
+        {
+            SDL_Delay(1u);
+        }
+    }
+
+    template <>
+    AssetHandle<Image> AssetLoader::Load<Image>(const Path& path)
+    {
+        return Queue<Image>([path]()
+        {
+            return AssetCache::Get<Image>(path);
+        });
+    }
+
+    template <>
+    AssetHandle<Texture> AssetLoader::Load<Texture>(const Path& path)
+    {
+        if (Texture::IsBaked(path))
+        {
+            return Queue<Texture, File::View>(
+                [path]()
+                {
+                    // Nothing to decode. Mapping starts the read ahead, so the upload does not wait on the disk.
+                    return std::make_shared<File::View>(File(path).Map());
+                },
+                [path](const File::View&)
+                {
+                    return AssetCache::Get<Texture>(path);
+                }
+            );
+        }
+
+        return Queue<Texture, Image>(
+            [path]()
+            {
+                return AssetCache::Get<Image>(path);
+            },
+            [path](const Image&)
+            {
+                // The decoded image is held by the job, so this finds it in the cache.
+                return AssetCache::Get<Texture>(path);
+            }
+        );
+    }
+
+    template <>
+    AssetHandle<SpriteSheet> AssetLoader::Load<SpriteSheet>(const Path& path)
+    {
+        return Queue<SpriteSheet>([path]()
+        {
+            return AssetCache::Get<SpriteSheet>(path);
+        });
+    }
+
+    template <>
+    AssetHandle<Font> AssetLoader::Load<Font>(const Path& path)
+    {
+        return Queue<Font>([path]()
+        {
+            return AssetCache::Get<Font>(path);
+        });
+    }
+
+    template <>
+    AssetHandle<AudioClip> AssetLoader::Load<AudioClip>(const Path& path)
+    {
+        return Queue<AudioClip>([path]()
+        {
+            return AssetCache::Get<AudioClip>(path);
+        });
+    }
+
+}
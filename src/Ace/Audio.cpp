@@ -1,65 +1,1327 @@
 #include <Ace/Audio.h>
 #include <Ace/Assert.h>
+#include <Ace/AssetCache.h>
+#include <Ace/AssetLoader.h>
+#include <Ace/AudioMixer.h>
 #include <Ace/IntTypes.h>
-#include <Ace/Time.h>
+#include <Ace/SPSCQueue.h>
 #include <Ace/Log.h>
+#include <Ace/Profiler.h>
 
+#include <OALWrapper/OAL_Buffer.h>
 #include <OALWrapper/OAL_Funcs.h>
+#include <OALWrapper/OAL_Loaders.h>
 #include <OALWrapper/OAL_Sample.h>
+#include <OALWrapper/OAL_Stream.h>
 
+#include <SDL_endian.h>
+#include <SDL_rwops.h>
 #include <SDL_thread.h>
+#include <SDL_timer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include <vorbis/vorbisfile.h>
 
 namespace ace
 {
 	static SDL_Thread* g_audioThread;
-	static bool g_isAudioRunning;
+	static SDL_threadID g_audioThreadID;
+	static std::atomic<bool> g_isAudioRunning(false);
+
+	// The audio thread sleeps on g_wakeCond until a command arrives or its next deadline.
+	static SDL_mutex* g_wakeMutex;
+	static SDL_cond* g_wakeCond;
+	static std::atomic<bool> g_isAudioSleeping(false);
+
+	// Set under g_wakeMutex when a sample finishes decoding, plays waiting for it may start.
+	// Checked before sleeping, a decode finishing during Audio::Update is not missed.
+	static std::atomic<bool> g_isSampleDecoded(false);
+
+	// Milliseconds until the next deadline, SDL_MUTEX_MAXWAIT when nothing plays. Set by Audio::Update.
+	static Uint32 g_wait = SDL_MUTEX_MAXWAIT;
+
+	// Update rates while something needs the audio thread.
+	static const Uint32 FadeWait = 10u;
+	static const Uint32 PlaybackWait = 1000u / 30u;
+
+	// SDL's counter directly, UInt64 is only 32 bits wide on some platforms.
+	static Uint64 g_clockStart;
+
+	static double g_lastUpdate;
+
+	// Seconds since Init, the timeline of scheduled starts and effects.
+	static double GetAudioClock()
+	{
+		return static_cast<double>(SDL_GetPerformanceCounter() - g_clockStart) / SDL_GetPerformanceFrequency();
+	}
+
+	static bool HasPendingCommands();
 
 	// Audio Update thread.
 	static int AudioUpdate(void* data)
 	{
-		Int32 wait = 1000 / 30; // 30times / second
+		g_audioThreadID = SDL_ThreadID();
+		ACE_PROFILE_THREAD("Audio");
+
 		while (g_isAudioRunning)
 		{
 			Audio::Update();
-			Time::Delay(wait);
+
+			SDL_LockMutex(g_wakeMutex);
+			g_isAudioSleeping = true;
+			// Pairs with the fence in PushCommand, either it sees the flag or this sees its command.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (g_isAudioRunning && !HasPendingCommands() && !g_isSampleDecoded)
+			{
+				if (g_wait == SDL_MUTEX_MAXWAIT)
+				{
+					SDL_CondWait(g_wakeCond, g_wakeMutex);
+				}
+				else
+				{
+					SDL_CondWaitTimeout(g_wakeCond, g_wakeMutex, g_wait);
+				}
+			}
+			g_isAudioSleeping = false;
+			g_isSampleDecoded = false;
+			SDL_UnlockMutex(g_wakeMutex);
 		}
 		return 0;
 	}
 
+	static void WakeAudioThread()
+	{
+		SDL_LockMutex(g_wakeMutex);
+		SDL_CondSignal(g_wakeCond);
+		SDL_UnlockMutex(g_wakeMutex);
+	}
+
+	// Effects run on the audio thread and apply their changes directly.
+	static bool IsAudioThread()
+	{
+		return g_audioThread != nullptr && SDL_ThreadID() == g_audioThreadID;
+	}
+
+	/**
+		Decoded sample shared by every AudioClip loaded from the same path.
+		Decoded on the loading thread or an AssetLoader worker, the OpenAL buffer is created by the audio thread.
+	*/
+	struct SampleData
+	{
+		enum class State : UInt8
+		{
+			Unloaded,
+			Decoding,
+			Decoded,
+			Failed,
+		};
+
+		Path path;
+		std::atomic<State> state;
+		std::atomic<bool> queued;
+
+		// 16-bit or 8-bit PCM behind a WAV header, released once uploaded. Written before state becomes Decoded.
+		std::vector<UInt8> wav;
+		double duration;
+
+		// Audio thread only, one of them once uploaded.
+		cOAL_Sample* sample;
+		std::shared_ptr<const PCMBuffer> pcm;
+
+		SampleData(const Path& path) : path(path), state(State::Unloaded), queued(false), duration(0.0), sample(nullptr)
+		{
+
+		}
+
+		~SampleData()
+		{
+			if (sample)
+			{
+				OAL_Sample_Unload(sample);
+				sample = nullptr;
+			}
+		}
+	};
+
 	struct IAudioSample::AudioClipImpl
 	{
 		cOAL_Stream* stream;
+		std::shared_ptr<SampleData> data;
+
+		// Audio thread only, set once data is uploaded.
 		cOAL_Sample* sample;
+		std::shared_ptr<const PCMBuffer> pcm;
+
+		// Written by the audio thread, read by the getters on the game thread.
+		// Reflects the newest voice playing the clip.
+		std::atomic<int> id;
+		std::atomic<bool> playing;
+		std::atomic<float> gain;
+		std::atomic<float> pitch;
+		std::atomic<double> elapsedTime;
+		std::atomic<double> totalTime;
+
+		// Most voices playing this clip at once, 0 for no limit.
+		std::atomic<UInt32> maxInstances;
+
+		AudioClipImpl(cOAL_Stream* clip) : stream(clip), sample(nullptr), id(-1), playing(false), gain(1.f), pitch(1.f), elapsedTime(0.0), totalTime(0.0), maxInstances(0u)
+		{
+
+		}
+
+		AudioClipImpl(const std::shared_ptr<SampleData>& clip) : stream(nullptr), data(clip), sample(nullptr), id(-1), playing(false), gain(1.f), pitch(1.f), elapsedTime(0.0), totalTime(0.0), maxInstances(0u)
+		{
+
+		}
+
+		double GetDuration() const
+		{
+			return data ? data->duration : (stream ? stream->GetTotalTime() : 0.0);
+		}
+
+		~AudioClipImpl()
+		{
+			if (stream)
+			{
+				OAL_Stream_Unload(stream);
+				stream = nullptr;
+			}
+		}
+	};
+
+	// Path keyed cache of decoded samples, entries expire with their last clip.
+	static SDL_mutex* g_sampleMutex;
+	static SDL_cond* g_sampleDecoded;
+	static std::unordered_map<AssetCache::PathID, std::weak_ptr<SampleData>> g_samples;
+	static std::atomic<UInt32> g_decodeCount(0u);
+
+	// Stereo clips up to this long are mixed down to mono, halving their memory.
+	// OpenAL only positions mono sources anyway.
+	static const double MonoMaxDuration = 5.0;
+
+	struct PCMFormat
+	{
+		UInt16 channels;
+		UInt16 bitsPerSample;
+		UInt32 frequency;
+	};
+
+	static void Write16(UInt8* out, UInt16 value)
+	{
+		std::memcpy(out, &value, sizeof(value));
+	}
+
+	static void Write32(UInt8* out, UInt32 value)
+	{
+		std::memcpy(out, &value, sizeof(value));
+	}
+
+	static const UInt32 WavHeaderSize = 44u;
+
+	// Writes the RIFF, "fmt " and "data" headers OAL_Sample_LoadFromBuffer expects in front of bytes of samples.
+	// Fields are in host order, the way the OALWrapper reader copies them.
+	static void WriteWavHeader(UInt8* out, const PCMFormat& format, UInt32 bytes)
+	{
+		const UInt16 blockAlign = static_cast<UInt16>(format.channels * format.bitsPerSample / 8u);
+
+		std::memcpy(out, "RIFF", 4u);
+		Write32(out + 4u, WavHeaderSize - 8u + bytes);
+		std::memcpy(out + 8u, "WAVEfmt ", 8u);
+		Write32(out + 16u, 16u);
+		Write16(out + 20u, 1u);
+		Write16(out + 22u, format.channels);
+		Write32(out + 24u, format.frequency);
+		Write32(out + 28u, format.frequency * blockAlign);
+		Write16(out + 32u, blockAlign);
+		Write16(out + 34u, format.bitsPerSample);
+		std::memcpy(out + 36u, "data", 4u);
+		Write32(out + 40u, bytes);
+	}
+
+	// Averages interleaved unsigned 8-bit frames into one channel.
+	static void MixToMono(const UInt8* in, UInt32 frames, UInt32 channels, UInt8* out)
+	{
+		for (UInt32 i = 0u; i < frames; ++i)
+		{
+			UInt32 sum = 0u;
+			for (UInt32 c = 0u; c < channels; ++c)
+			{
+				sum += in[i * channels + c];
+			}
+			out[i] = static_cast<UInt8>(sum / channels);
+		}
+	}
+
+	// Averages interleaved 16-bit frames into one channel.
+	static void MixToMono(const Int16* in, UInt32 frames, UInt32 channels, Int16* out)
+	{
+		for (UInt32 i = 0u; i < frames; ++i)
+		{
+			Int32 sum = 0;
+			for (UInt32 c = 0u; c < channels; ++c)
+			{
+				sum += in[i * channels + c];
+			}
+			out[i] = static_cast<Int16>(sum / static_cast<Int32>(channels));
+		}
+	}
+
+	struct OggMemory
+	{
+		const UInt8* data;
+		size_t size;
+		size_t position;
+	};
+
+	static size_t OggRead(void* out, size_t size, size_t count, void* source)
+	{
+		OggMemory& memory = *static_cast<OggMemory*>(source);
+		const size_t bytes = std::min(size * count, memory.size - memory.position);
+		std::memcpy(out, memory.data + memory.position, bytes);
+		memory.position += bytes;
+		return size != 0u ? bytes / size : 0u;
+	}
+
+	static int OggSeek(void* source, ogg_int64_t offset, int whence)
+	{
+		OggMemory& memory = *static_cast<OggMemory*>(source);
+		const ogg_int64_t base = whence == SEEK_CUR ? memory.position : (whence == SEEK_END ? memory.size : 0);
+		const ogg_int64_t position = base + offset;
+		if (position < 0 || position > static_cast<ogg_int64_t>(memory.size))
+		{
+			return -1;
+		}
+		memory.position = static_cast<size_t>(position);
+		return 0;
+	}
+
+	static long OggTell(void* source)
+	{
+		return static_cast<long>(static_cast<OggMemory*>(source)->position);
+	}
+
+	static bool DecodeOgg(const File::View& view, std::vector<UInt8>& wav, double& duration)
+	{
+		OggMemory memory = { view.Get(), view.size, 0u };
+		const ov_callbacks callbacks = { OggRead, OggSeek, nullptr, OggTell };
+
+		OggVorbis_File file;
+		if (ov_open_callbacks(&memory, &file, nullptr, 0, callbacks) < 0)
+		{
+			return false;
+		}
+
+		const vorbis_info* info = ov_info(&file, -1);
+		const ogg_int64_t frames = ov_pcm_total(&file, -1);
+		const UInt32 channels = static_cast<UInt32>(info->channels);
+
+		PCMFormat format;
+		format.frequency = static_cast<UInt32>(info->rate);
+		format.bitsPerSample = 16u;
+		duration = frames > 0 ? static_cast<double>(frames) / format.frequency : 0.0;
+
+		// The OALWrapper only plays mono and stereo.
+		const bool mono = channels > 2u || (channels == 2u && duration <= MonoMaxDuration);
+		format.channels = static_cast<UInt16>(mono ? 1u : channels);
+
+		wav.clear();
+		wav.reserve(WavHeaderSize + static_cast<size_t>(frames > 0 ? frames : 0) * format.channels * sizeof(Int16));
+		wav.resize(WavHeaderSize);
+
+		const int bigEndian = SDL_BYTEORDER == SDL_BIG_ENDIAN ? 1 : 0;
+		Int16 block[4096];
+		int section = 0;
+
+		for (;;)
+		{
+			const long bytes = ov_read(&file, reinterpret_cast<char*>(block), sizeof(block), bigEndian, 2, 1, &section);
+			if (bytes <= 0)
+			{
+				// 0 at the end, negative on a damaged page. Keeps what was decoded.
+				break;
+			}
+
+			const UInt32 blockFrames = static_cast<UInt32>(bytes) / (channels * sizeof(Int16));
+			const size_t offset = wav.size();
+			wav.resize(offset + blockFrames * format.channels * sizeof(Int16));
+			Int16* out = reinterpret_cast<Int16*>(&wav[offset]);
+
+			if (mono && channels > 1u)
+			{
+				MixToMono(block, blockFrames, channels, out);
+			}
+			else
+			{
+				std::memcpy(out, block, blockFrames * channels * sizeof(Int16));
+			}
+		}
+		ov_clear(&file);
+
+		const UInt32 bytes = static_cast<UInt32>(wav.size() - WavHeaderSize);
+		WriteWavHeader(wav.data(), format, bytes);
+		return bytes != 0u;
+	}
+
+	// Finds the format and samples of a PCM WAV file.
+	static bool ParseWav(const UInt8* data, UInt32 size, PCMFormat& format, const UInt8*& samples, UInt32& bytes)
+	{
+		if (size < 12u || std::memcmp(data, "RIFF", 4u) != 0 || std::memcmp(data + 8u, "WAVE", 4u) != 0)
+		{
+			return false;
+		}
+
+		bool hasFormat = false;
+		for (UInt32 offset = 12u; offset + 8u <= size;)
+		{
+			UInt32 chunkSize;
+			std::memcpy(&chunkSize, data + offset + 4u, sizeof(chunkSize));
+			const UInt8* chunk = data + offset + 8u;
+			const UInt32 available = size - offset - 8u;
+
+			if (std::memcmp(data + offset, "fmt ", 4u) == 0 && chunkSize >= 16u && available >= 16u)
+			{
+				UInt16 audioFormat;
+				std::memcpy(&audioFormat, chunk, sizeof(audioFormat));
+				std::memcpy(&format.channels, chunk + 2u, sizeof(format.channels));
+				std::memcpy(&format.frequency, chunk + 4u, sizeof(format.frequency));
+				std::memcpy(&format.bitsPerSample, chunk + 14u, sizeof(format.bitsPerSample));
+				hasFormat = audioFormat == 1u;
+			}
+			else if (std::memcmp(data + offset, "data", 4u) == 0)
+			{
+				samples = chunk;
+				bytes = std::min(chunkSize, available);
+				return hasFormat && format.channels != 0u && format.frequency != 0u && (format.bitsPerSample == 8u || format.bitsPerSample == 16u);
+			}
+
+			// No room for another chunk after this one, and a larger size would wrap offset.
+			if (chunkSize >= available)
+			{
+				break;
+			}
+
+			// Chunks are padded to an even size.
+			offset += 8u + chunkSize + (chunkSize & 1u);
+		}
+		return false;
+	}
+
+	static bool DecodeWav(const File::View& view, std::vector<UInt8>& wav, double& duration)
+	{
+		PCMFormat format;
+		const UInt8* samples = nullptr;
+		UInt32 bytes = 0u;
+		if (!ParseWav(view.Get(), view.size, format, samples, bytes))
+		{
+			return false;
+		}
+
+		const UInt32 frameSize = format.channels * format.bitsPerSample / 8u;
+		const UInt32 frames = bytes / frameSize;
+		duration = static_cast<double>(frames) / format.frequency;
+
+		// The OALWrapper only plays mono and stereo. 8-bit stereo is already small and kept.
+		const bool mono = format.channels > 2u || (format.channels == 2u && format.bitsPerSample == 16u && duration <= MonoMaxDuration);
+		const PCMFormat output = { mono ? static_cast<UInt16>(1u) : format.channels, format.bitsPerSample, format.frequency };
+		const UInt32 outputBytes = mono ? frames * (format.bitsPerSample / 8u) : frames * frameSize;
+
+		wav.resize(WavHeaderSize + outputBytes);
+		WriteWavHeader(wav.data(), output, outputBytes);
+
+		if (mono && format.bitsPerSample == 8u)
+		{
+			MixToMono(samples, frames, format.channels, &wav[WavHeaderSize]);
+		}
+		else if (mono)
+		{
+			// The data chunk may be unaligned within the file.
+			std::vector<Int16> input(frames * format.channels);
+			std::memcpy(input.data(), samples, input.size() * sizeof(Int16));
+			MixToMono(input.data(), frames, format.channels, reinterpret_cast<Int16*>(&wav[WavHeaderSize]));
+		}
+		else
+		{
+			std::memcpy(&wav[WavHeaderSize], samples, outputBytes);
+		}
+		return outputBytes != 0u;
+	}
+
+	static void DecodeSample(SampleData& data)
+	{
+		const File::View view = File(data.path).Map();
+
+		std::vector<UInt8> wav;
+		double duration = 0.0;
+		bool decoded = false;
+
+		if (view.size >= 4u && std::memcmp(view.Get(), "OggS", 4u) == 0)
+		{
+			decoded = DecodeOgg(view, wav, duration);
+		}
+		else if (view.size != 0u)
+		{
+			decoded = DecodeWav(view, wav, duration);
+		}
+
+		if (!decoded)
+		{
+			Logger::LogError("Audioclip could not be decoded %s!", data.path.GetPath().c_str());
+		}
+
+		SDL_LockMutex(g_sampleMutex);
+		data.wav = std::move(wav);
+		data.duration = duration;
+		data.state = decoded ? SampleData::State::Decoded : SampleData::State::Failed;
+		SDL_CondBroadcast(g_sampleDecoded);
+		SDL_UnlockMutex(g_sampleMutex);
+
+		// Plays waiting for the sample can start now.
+		SDL_LockMutex(g_wakeMutex);
+		g_isSampleDecoded = true;
+		SDL_CondSignal(g_wakeCond);
+		SDL_UnlockMutex(g_wakeMutex);
+	}
+
+	// Decodes unless the sample is already decoded or being decoded.
+	static void TryDecode(SampleData& data)
+	{
+		SampleData::State expected = SampleData::State::Unloaded;
+		if (data.state.compare_exchange_strong(expected, SampleData::State::Decoding))
+		{
+			DecodeSample(data);
+		}
+	}
+
+	static void RequestDecode(const std::shared_ptr<SampleData>& data, bool background)
+	{
+		if (!background)
+		{
+			TryDecode(*data);
+			return;
+		}
+
+		// Claimed when the job runs, not when it is queued, so a blocking load never waits on
+		// a job stuck behind it in the worker queue.
+		if (data->state == SampleData::State::Unloaded && !data->queued.exchange(true))
+		{
+			++g_decodeCount;
+			AssetLoader::Run([data]()
+			{
+				TryDecode(*data);
+				--g_decodeCount;
+			});
+		}
+	}
+
+	static AudioBackend g_backend = AudioBackend::OpenAL;
+
+	// True while OpenAL is open, the Null and WavFile backends run without it.
+	static bool g_hasDevice;
+
+	// Mixes clips for every backend but OpenAL. Audio thread only.
+	static AudioMixer* g_mixer;
+
+	// Converts a decoded WAV to mixer PCM, 8-bit samples are widened.
+	static std::shared_ptr<const PCMBuffer> CreatePCM(const std::vector<UInt8>& wav)
+	{
+		PCMFormat format;
+		const UInt8* samples = nullptr;
+		UInt32 bytes = 0u;
+		if (!ParseWav(wav.data(), static_cast<UInt32>(wav.size()), format, samples, bytes) || format.channels > 2u)
+		{
+			return nullptr;
+		}
+
+		auto pcm = std::make_shared<PCMBuffer>();
+		pcm->channels = format.channels;
+		pcm->frequency = format.frequency;
+		pcm->frames = bytes / (format.channels * format.bitsPerSample / 8u);
+		pcm->samples.resize(pcm->frames * format.channels);
+
+		if (format.bitsPerSample == 16u)
+		{
+			std::memcpy(pcm->samples.data(), samples, pcm->samples.size() * sizeof(Int16));
+		}
+		else
+		{
+			for (UInt32 i = 0u; i < pcm->samples.size(); ++i)
+			{
+				pcm->samples[i] = static_cast<Int16>((samples[i] - 128) << 8);
+			}
+		}
+		return pcm;
+	}
+
+	// Stereo frames between the audio thread and OpenAL's stream thread of the Mixer backend.
+	// Lock-free for one producer and one consumer, the counters only grow.
+	static const UInt32 MixRingFrames = 8192u;
+	static Int16 g_mixRing[MixRingFrames * 2u];
+	static std::atomic<UInt32> g_mixWritten(0u);
+	static std::atomic<UInt32> g_mixRead(0u);
+
+	// Frames kept ahead of OpenAL, about 70 ms at 44.1 kHz.
+	static const UInt32 MixLatencyFrames = 3072u;
+
+	static const UInt32 MixFrequency = 44100u;
+
+	static cOAL_Stream* g_mixStream;
+	static int g_mixSource = -1;
+
+	// Frames mixed since Init by the Null and WavFile backends, paced by the audio clock.
+	static Uint64 g_mixedFrames;
+	static SDL_RWops* g_wavFile;
+	static UInt32 g_wavBytes;
+
+	static double MixStreamGetTime(void*)
+	{
+		return static_cast<double>(g_mixRead.load(std::memory_order_relaxed)) / MixFrequency;
+	}
+
+	// Runs on OpenAL's stream thread. Underruns play silence, the stream never ends.
+	static bool MixStreamFill(void*, cOAL_Buffer* destination, char* buffer, unsigned int bufferSize, bool& eof)
+	{
+		const UInt32 frames = bufferSize / (2u * sizeof(Int16));
+		const UInt32 read = g_mixRead.load(std::memory_order_relaxed);
+		const UInt32 available = std::min(g_mixWritten.load(std::memory_order_acquire) - read, frames);
+
+		Int16* out = reinterpret_cast<Int16*>(buffer);
+		for (UInt32 i = 0u; i < available; ++i)
+		{
+			const UInt32 frame = ((read + i) % MixRingFrames) * 2u;
+			out[i * 2u] = g_mixRing[frame];
+			out[i * 2u + 1u] = g_mixRing[frame + 1u];
+		}
+		std::memset(out + available * 2u, 0, (frames - available) * 2u * sizeof(Int16));
+
+		g_mixRead.store(read + available, std::memory_order_release);
+		destination->Feed(buffer, static_cast<int>(frames * 2u * sizeof(Int16)));
+		eof = false;
+		return true;
+	}
+
+	// Mixes what the backend needs by now. Audio thread only.
+	static void RenderMix(double now)
+	{
+		if (g_mixer == nullptr)
+		{
+			return;
+		}
+
+		Int16 block[AudioMixer::BlockFrames * 2u];
+
+		if (g_backend == AudioBackend::Mixer)
+		{
+			const UInt32 written = g_mixWritten.load(std::memory_order_relaxed);
+			UInt32 queued = written - g_mixRead.load(std::memory_order_acquire);
+			UInt32 frame = written;
+
+			while (queued < MixLatencyFrames)
+			{
+				const UInt32 frames = std::min(std::min(AudioMixer::BlockFrames, MixLatencyFrames - queued), MixRingFrames - frame % MixRingFrames);
+				g_mixer->Mix(g_mixRing + (frame % MixRingFrames) * 2u, frames);
+				frame += frames;
+				queued += frames;
+			}
+			g_mixWritten.store(frame, std::memory_order_release);
+			return;
+		}
+
+		const Uint64 due = static_cast<Uint64>(now * MixFrequency);
+
+		// The thread slept through silence, voices started since then begin now rather than in the past.
+		if (g_backend == AudioBackend::Null && due - g_mixedFrames > MixLatencyFrames)
+		{
+			g_mixedFrames = due - MixLatencyFrames;
+		}
+
+		while (g_mixedFrames < due)
+		{
+			const UInt32 frames = static_cast<UInt32>(std::min<Uint64>(AudioMixer::BlockFrames, due - g_mixedFrames));
+			g_mixedFrames += frames;
+
+			// Silence is not worth mixing when nothing listens.
+			if (g_backend == AudioBackend::Null && g_mixer->GetVoiceCount() == 0u)
+			{
+				continue;
+			}
+
+			g_mixer->Mix(block, frames);
+			if (g_wavFile != nullptr)
+			{
+				const UInt32 bytes = frames * 2u * sizeof(Int16);
+				if (SDL_RWwrite(g_wavFile, block, 1u, bytes) == bytes)
+				{
+					g_wavBytes += bytes;
+				}
+			}
+		}
+	}
+
+	static void OpenWavFile(const char* path)
+	{
+		g_wavFile = path != nullptr ? SDL_RWFromFile(path, "wb") : nullptr;
+		if (g_wavFile == nullptr)
+		{
+			Logger::LogError("Audio output file %s could not be opened: %s", path != nullptr ? path : "(null)", SDL_GetError());
+			return;
+		}
+
+		// The sizes are filled in by CloseWavFile.
+		UInt8 header[WavHeaderSize];
+		WriteWavHeader(header, PCMFormat{ 2u, 16u, MixFrequency }, 0u);
+		SDL_RWwrite(g_wavFile, header, 1u, WavHeaderSize);
+		g_wavBytes = 0u;
+	}
+
+	static void CloseWavFile()
+	{
+		if (g_wavFile == nullptr)
+		{
+			return;
+		}
+
+		UInt8 header[WavHeaderSize];
+		WriteWavHeader(header, PCMFormat{ 2u, 16u, MixFrequency }, g_wavBytes);
+		SDL_RWseek(g_wavFile, 0, RW_SEEK_SET);
+		SDL_RWwrite(g_wavFile, header, 1u, WavHeaderSize);
+		SDL_RWclose(g_wavFile);
+		g_wavFile = nullptr;
+	}
+
+	// @return True once the clip's sample or stream can be played.
+	static bool IsPrepared(const IAudioSample::AudioClipImpl& clip)
+	{
+		return clip.sample != nullptr || clip.pcm != nullptr || clip.stream != nullptr;
+	}
+
+	// Uploads a decoded clip to OpenAL, or to mixer PCM when there is a mixer. Audio thread only.
+	// @return True once the clip can be played.
+	static bool PrepareSample(IAudioSample::AudioClipImpl& clip)
+	{
+		if (IsPrepared(clip))
+		{
+			return true;
+		}
+
+		SampleData& data = *clip.data;
+		if (data.sample == nullptr && data.pcm == nullptr && data.state == SampleData::State::Decoded)
+		{
+			if (g_mixer != nullptr)
+			{
+				data.pcm = CreatePCM(data.wav);
+			}
+			else
+			{
+				data.sample = OAL_Sample_LoadFromBuffer(data.wav.data(), data.wav.size(), eOAL_SampleFormat_Wav);
+			}
+
+			if (data.sample == nullptr && data.pcm == nullptr)
+			{
+				Logger::LogError("Audioclip upload failed %s!", data.path.GetPath().c_str());
+				data.state = SampleData::State::Failed;
+			}
+
+			// OpenAL and the PCM buffer keep their own copy.
+			std::vector<UInt8>().swap(data.wav);
+		}
+
+		clip.sample = data.sample;
+		clip.pcm = data.pcm;
+		return IsPrepared(clip);
+	}
+
+	// @return True while a play of the clip should wait for its sample.
+	static bool IsDecoding(const IAudioSample::AudioClipImpl& clip)
+	{
+		if (clip.data == nullptr)
+		{
+			return false;
+		}
+		const SampleData::State state = clip.data->state;
+		return state == SampleData::State::Unloaded || state == SampleData::State::Decoding;
+	}
+
+
+	/**
+		Every playing instance of a clip is a voice. Only the most important voices hold an OpenAL source,
+		the rest are virtual: silent, but their playback position keeps advancing so they resume in place.
+		Audio thread only.
+	*/
+	struct Voice
+	{
+		std::shared_ptr<IAudioSample::AudioClipImpl> clip;
+		int source;				// -1 while virtual.
+		UInt32 priority;
+		UInt32 serial;			// Play order, the oldest instance is replaced first.
+
+		float gain;
+		float pitch;
+		bool loop;
+		bool paused;
+		bool positional;
+		float position[3];
+		float velocity[3];
+
+		double elapsedTime;
+		double totalTime;
+		float audibility;
+	};
+
+	static const UInt32 MaxVoices = 128u;
+
+	static Voice g_voices[MaxVoices];
+	static UInt32 g_realVoiceLimit = 32u;
+	static UInt32 g_serial;
+	static float g_listener[3];
+
+	static std::atomic<float> g_cullDistance(1000.f);
+	static std::atomic<UInt32> g_voiceCount(0u);
+	static std::atomic<UInt32> g_realVoiceCount(0u);
+
+	static bool IsActive(const Voice& voice)
+	{
+		return voice.clip != nullptr;
+	}
+
+	// The source of a voice is a mixer voice for clips when there is a mixer, an OpenAL source otherwise.
+	static bool IsMixed(const Voice& voice)
+	{
+		return g_mixer != nullptr && voice.clip->stream == nullptr;
+	}
+
+	static void SetSourceGain(const Voice& voice, float gain)
+	{
+		IsMixed(voice) ? g_mixer->SetGain(voice.source, gain) : OAL_Source_SetGain(voice.source, gain);
+	}
+
+	static void SetSourcePitch(const Voice& voice, float pitch)
+	{
+		IsMixed(voice) ? g_mixer->SetPitch(voice.source, pitch) : OAL_Source_SetPitch(voice.source, pitch);
+	}
+
+	static void SetSourceLoop(const Voice& voice, bool loop)
+	{
+		IsMixed(voice) ? g_mixer->SetLoop(voice.source, loop) : OAL_Source_SetLoop(voice.source, loop);
+	}
+
+	static void SetSourcePaused(const Voice& voice, bool paused)
+	{
+		IsMixed(voice) ? g_mixer->SetPaused(voice.source, paused) : OAL_Source_SetPaused(voice.source, paused);
+	}
+
+	static void SetSourceElapsedTime(const Voice& voice, double time)
+	{
+		IsMixed(voice) ? g_mixer->SetElapsedTime(voice.source, time) : OAL_Source_SetElapsedTime(voice.source, time);
+	}
+
+	static void SetSourcePosition(const Voice& voice, const float* position)
+	{
+		IsMixed(voice) ? g_mixer->SetPosition(voice.source, position) : OAL_Source_SetPosition(voice.source, position);
+	}
+
+	// The mixer has no doppler.
+	static void SetSourceVelocity(const Voice& voice, const float* velocity)
+	{
+		if (!IsMixed(voice))
+		{
+			OAL_Source_SetVelocity(voice.source, velocity);
+		}
+	}
+
+	static double GetSourceElapsedTime(const Voice& voice)
+	{
+		return IsMixed(voice) ? g_mixer->GetElapsedTime(voice.source) : OAL_Source_GetElapsedTime(voice.source);
+	}
+
+	static bool IsSourcePlaying(const Voice& voice)
+	{
+		return IsMixed(voice) ? g_mixer->IsPlaying(voice.source) : OAL_Source_IsPlaying(voice.source);
+	}
+
+	static void StopSource(Voice& voice, bool keepPosition)
+	{
+		if (voice.source == -1)
+		{
+			return;
+		}
+
+		if (keepPosition)
+		{
+			voice.elapsedTime = GetSourceElapsedTime(voice);
+		}
+		IsMixed(voice) ? g_mixer->Stop(voice.source) : OAL_Source_Stop(voice.source);
+		voice.source = -1;
+	}
+
+	static bool StartSource(Voice& voice)
+	{
+		IAudioSample::AudioClipImpl& clip = *voice.clip;
+
+		if (IsMixed(voice))
+		{
+			voice.source = g_mixer->Play(clip.pcm, voice.gain, voice.pitch, voice.loop, true);
+		}
+		else
+		{
+			voice.source = clip.sample ?
+				OAL_Sample_Play(OAL_FREE, clip.sample, voice.gain, true, voice.priority) :
+				OAL_Stream_Play(OAL_FREE, clip.stream, voice.gain, true);
+		}
+
+		if (voice.source == -1)
+		{
+			return false;
+		}
+
+		SetSourceLoop(voice, voice.loop);
+		SetSourcePitch(voice, voice.pitch);
+		if (voice.positional)
+		{
+			SetSourcePosition(voice, voice.position);
+			SetSourceVelocity(voice, voice.velocity);
+		}
+		if (voice.elapsedTime > 0.0)
+		{
+			SetSourceElapsedTime(voice, voice.elapsedTime);
+		}
+		SetSourcePaused(voice, voice.paused);
+		return true;
+	}
+
+	static void FreeVoice(Voice& voice)
+	{
+		StopSource(voice, false);
+		voice.clip->playing = false;
+		voice.clip.reset();
+	}
+
+	// Lower ranks are stolen first.
+	static bool IsLessImportant(const Voice& a, const Voice& b)
+	{
+		if (a.priority != b.priority)
+		{
+			return a.priority < b.priority;
+		}
+		if (a.audibility != b.audibility)
+		{
+			return a.audibility < b.audibility;
+		}
+		return a.serial < b.serial;
+	}
+
+	// Finds a slot for a new instance of clip, nullptr if every voice is more important.
+	static Voice* AllocateVoice(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, UInt32 priority)
+	{
+		const UInt32 maxInstances = clip->maxInstances;
+
+		Voice* free = nullptr;
+		Voice* oldest = nullptr;
+		Voice* weakest = nullptr;
+		UInt32 instances = 0u;
+
+		for (auto& voice : g_voices)
+		{
+			if (!IsActive(voice))
+			{
+				free = free ? free : &voice;
+				continue;
+			}
+
+			if (voice.clip == clip)
+			{
+				++instances;
+				oldest = (oldest == nullptr || voice.serial < oldest->serial) ? &voice : oldest;
+			}
+
+			weakest = (weakest == nullptr || IsLessImportant(voice, *weakest)) ? &voice : weakest;
+		}
+
+		// Streams have a single playback position, a new instance restarts the current one.
+		if (oldest != nullptr && (clip->stream != nullptr || (maxInstances != 0u && instances >= maxInstances)))
+		{
+			FreeVoice(*oldest);
+			return oldest;
+		}
+
+		if (free != nullptr)
+		{
+			return free;
+		}
+
+		if (weakest != nullptr && weakest->priority <= priority)
+		{
+			FreeVoice(*weakest);
+			return weakest;
+		}
+		return nullptr;
+	}
+
+	template <typename Func>
+	static void ForEachVoice(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, Func func)
+	{
+		for (auto& voice : g_voices)
+		{
+			if (voice.clip == clip)
+			{
+				func(voice);
+			}
+		}
+	}
+
+	static void SetVoiceGain(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, float gain)
+	{
+		ForEachVoice(clip, [gain](Voice& voice)
+		{
+			voice.gain = gain;
+			if (voice.source != -1)
+			{
+				SetSourceGain(voice, gain);
+			}
+		});
+		clip->gain = gain;
+	}
+
+	static void SetVoicePitch(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, float pitch)
+	{
+		ForEachVoice(clip, [pitch](Voice& voice)
+		{
+			voice.pitch = pitch;
+			if (voice.source != -1)
+			{
+				SetSourcePitch(voice, pitch);
+			}
+		});
+		clip->pitch = pitch;
+	}
+
+	static void SetVoiceLoop(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, bool loop)
+	{
+		ForEachVoice(clip, [loop](Voice& voice)
+		{
+			voice.loop = loop;
+			if (voice.source != -1)
+			{
+				SetSourceLoop(voice, loop);
+			}
+		});
+	}
+
+	static void SetVoiceElapsedTime(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, double time)
+	{
+		ForEachVoice(clip, [time](Voice& voice)
+		{
+			voice.elapsedTime = time;
+			if (voice.source != -1)
+			{
+				SetSourceElapsedTime(voice, time);
+			}
+		});
+		clip->elapsedTime = time;
+	}
+
+	static void SetVoicePosition(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, const float* position)
+	{
+		ForEachVoice(clip, [position](Voice& voice)
+		{
+			voice.positional = true;
+			std::memcpy(voice.position, position, sizeof(voice.position));
+			if (voice.source != -1)
+			{
+				SetSourcePosition(voice, position);
+			}
+		});
+	}
+
+	static void SetVoiceVelocity(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, const float* velocity)
+	{
+		ForEachVoice(clip, [velocity](Voice& voice)
+		{
+			std::memcpy(voice.velocity, velocity, sizeof(voice.velocity));
+			if (voice.source != -1)
+			{
+				SetSourceVelocity(voice, velocity);
+			}
+		});
+	}
+
+	static Voice* PlayVoice(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, float gain, bool loop, UInt32 priority)
+	{
+		Voice* voice = AllocateVoice(clip, priority);
+		if (voice == nullptr)
+		{
+			// Every voice is busy with more important sounds.
+			return nullptr;
+		}
+
+		voice->clip = clip;
+		voice->source = -1;
+		voice->priority = priority;
+		voice->serial = ++g_serial;
+		voice->gain = gain;
+		voice->pitch = 1.f;
+		voice->loop = loop;
+		voice->paused = false;
+		voice->positional = false;
+		std::memset(voice->velocity, 0, sizeof(voice->velocity));
+		voice->elapsedTime = 0.0;
+		voice->totalTime = clip->GetDuration();
+		voice->audibility = gain;
+
+		clip->gain = gain;
+		clip->pitch = 1.f;
+		clip->elapsedTime = 0.0;
+		clip->totalTime = voice->totalTime;
+		clip->playing = true;
+		return voice;
+	}
+
+	/**
+		A play command waiting for its start time on the audio clock. Audio thread only.
+	*/
+	struct ScheduledStart
+	{
+		std::shared_ptr<IAudioSample::AudioClipImpl> clip;
+		double time;
+		float gain;
+		bool loop;
+		UInt32 priority;
+		bool inPhase;			// False for plays only waiting for their sample to decode.
+	};
+
+	static std::vector<ScheduledStart> g_scheduled;
+
+	// Starts the due clips. OpenAL cannot start a source at a given sample, so a late start
+	// skips the samples it missed instead and stays in phase with the clock.
+	static void StartScheduled(double now)
+	{
+		for (UInt32 i = 0u; i < g_scheduled.size();)
+		{
+			ScheduledStart& start = g_scheduled[i];
+			const bool ready = PrepareSample(*start.clip);
+			if (start.time > now || (!ready && IsDecoding(*start.clip)))
+			{
+				++i;
+				continue;
+			}
+
+			Voice* voice = ready ? PlayVoice(start.clip, start.gain, start.loop, start.priority) : nullptr;
+			if (voice != nullptr && start.inPhase)
+			{
+				const double late = now - start.time;
+				if (late >= voice->totalTime && voice->totalTime > 0.0)
+				{
+					if (start.loop)
+					{
+						voice->elapsedTime = std::fmod(late, voice->totalTime);
+					}
+					else
+					{
+						FreeVoice(*voice);
+					}
+				}
+				else
+				{
+					voice->elapsedTime = late;
+				}
+			}
+
+			g_scheduled[i] = std::move(g_scheduled.back());
+			g_scheduled.pop_back();
+		}
+	}
 
-		int id;
+	// Advances voices by dt seconds, gives sources to the most important audible ones.
+	static void UpdateVoices(double dt)
+	{
+		const float cullDistance = g_cullDistance;
+		Voice* active[MaxVoices];
+		UInt32 count = 0u;
 
-		AudioClipImpl(cOAL_Stream* clip) : stream(clip), id(-1), sample(nullptr)
+		for (auto& voice : g_voices)
 		{
+			if (!IsActive(voice))
+			{
+				continue;
+			}
 
-		}
+			if (voice.source != -1)
+			{
+				if (!voice.paused && !IsSourcePlaying(voice))
+				{
+					FreeVoice(voice);
+					continue;
+				}
+				voice.elapsedTime = GetSourceElapsedTime(voice);
+			}
+			else if (!voice.paused)
+			{
+				voice.elapsedTime += dt * voice.pitch;
+				if (voice.elapsedTime >= voice.totalTime)
+				{
+					if (!voice.loop || voice.totalTime <= 0.0)
+					{
+						FreeVoice(voice);
+						continue;
+					}
+					voice.elapsedTime = std::fmod(voice.elapsedTime, voice.totalTime);
+				}
+			}
 
-		AudioClipImpl(cOAL_Sample* clip) : sample(clip), id(-1), stream(nullptr)
-		{
+			// Inverse distance, only used to rank voices.
+			float distance = 0.f;
+			if (voice.positional)
+			{
+				const float dx = voice.position[0] - g_listener[0];
+				const float dy = voice.position[1] - g_listener[1];
+				const float dz = voice.position[2] - g_listener[2];
+				distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+			}
+			voice.audibility = distance > cullDistance ? 0.f : voice.gain / std::max(distance, 1.f);
 
+			active[count++] = &voice;
 		}
 
-		~AudioClipImpl()
+		std::sort(active, active + count, [](const Voice* a, const Voice* b)
 		{
-			if (stream)
+			const bool audibleA = a->audibility > 0.f, audibleB = b->audibility > 0.f;
+			return audibleA != audibleB ? audibleA : IsLessImportant(*b, *a);
+		});
+
+		UInt32 real = 0u;
+		for (UInt32 i = 0u; i < count; ++i)
+		{
+			if (i >= g_realVoiceLimit || active[i]->audibility <= 0.f)
 			{
-				OAL_Stream_Unload(stream);
-				stream = nullptr;
+				StopSource(*active[i], true);
 			}
-			if (sample)
+		}
+
+		for (UInt32 i = 0u; i < count; ++i)
+		{
+			Voice& voice = *active[i];
+			if (i < g_realVoiceLimit && voice.audibility > 0.f && voice.source == -1)
 			{
-				OAL_Sample_Unload(sample);
-				sample = nullptr;
+				StartSource(voice);
 			}
+			real += voice.source != -1 ? 1u : 0u;
+		}
+
+		// Oldest first, so the newest voice of each clip is published last.
+		std::sort(active, active + count, [](const Voice* a, const Voice* b)
+		{
+			return a->serial < b->serial;
+		});
+
+		for (UInt32 i = 0u; i < count; ++i)
+		{
+			IAudioSample::AudioClipImpl& clip = *active[i]->clip;
+			clip.id = active[i]->source;
+			clip.playing = !active[i]->paused;
+			clip.elapsedTime = active[i]->elapsedTime;
+		}
+
+		g_voiceCount = count;
+		g_realVoiceCount = real;
+	}
+
+	/**
+		Game thread calls are queued as commands and applied by the audio thread at the start of its update.
+		Only the game thread may push, only the audio thread pops.
+	*/
+	struct AudioCommand
+	{
+		enum class Type : UInt8
+		{
+			None,
+			PlaySample,
+			PlayStream,
+			Pause,
+			Stop,
+			StopAll,
+			SetGain,
+			SetPitch,
+			SetLoop,
+			SetElapsedTime,
+			SetPosition,
+			SetVelocity,
+			SetMasterVolume,
+			SetListener,
+			AddEffect,
+		};
+
+		Type type;
+		std::shared_ptr<IAudioSample::AudioClipImpl> clip;
+		IAudioEffect* effect;
+
+		float value;
+		bool flag;
+		bool loop;
+		UInt32 priority;
+		double time;
+		float vectors[4][3];
+
+		AudioCommand(Type type = Type::None) : type(type), effect(nullptr), value(0.f), flag(false), loop(false), priority(0u), time(0.0)
+		{
+
 		}
 	};
 
+	static const UInt32 AudioCommandCapacity = 1024u;
+	static SPSCQueue<AudioCommand, AudioCommandCapacity> g_commands;
+
+	static bool HasPendingCommands()
+	{
+		return !g_commands.IsEmpty();
+	}
+
+	static void PushCommand(AudioCommand&& command)
+	{
+		IAudioEffect* effect = command.effect;
+		if (!g_commands.Push(std::move(command)))
+		{
+			// Never blocks the game thread, the command is dropped instead.
+			Logger::LogError("Audio command queue is full, command dropped!");
+			delete effect;
+			return;
+		}
+
+		// Only takes the lock when the audio thread may be waiting.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (g_isAudioSleeping)
+		{
+			WakeAudioThread();
+		}
+	}
+
+	static AudioCommand ClipCommand(AudioCommand::Type type, const std::shared_ptr<IAudioSample::AudioClipImpl>& clip)
+	{
+		AudioCommand command(type);
+		command.clip = clip;
+		return command;
+	}
+
+	// Flag marks a scheduled start at time.
+	static AudioCommand PlayCommand(AudioCommand::Type type, const std::shared_ptr<IAudioSample::AudioClipImpl>& clip, float volume, bool loop, UInt32 priority)
+	{
+		AudioCommand command = ClipCommand(type, clip);
+		command.value = volume;
+		command.loop = loop;
+		command.priority = priority;
+		return command;
+	}
+
+	static void SetVector(float* target, const math::Vector3& vector)
+	{
+		std::memcpy(target, vector.array, sizeof(vector.array));
+	}
 
-	IAudioSample::IAudioSample(IAudioSample::AudioClipImpl* impl) : impl(impl)
+	IAudioSample::IAudioSample(IAudioSample::AudioClipImpl* impl) : impl(impl), ispaused(true), volume(1.f), pitch(1.f), loop(false), priority(0u)
 	{
 
 	}
@@ -69,7 +1331,7 @@ namespace ace
 		return impl ? impl.get() : nullptr;
 	}
 
-	static cOAL_Sample* LoadSample(const File& file)
+	static std::shared_ptr<SampleData> LoadSample(const File& file, AudioDecode decode)
 	{
 		// returns nullptr if audio is not initialized.
 		if (!g_isAudioRunning || !File::Exists(file.path))
@@ -77,43 +1339,71 @@ namespace ace
 			return nullptr;
 		}
 
-		UInt32 pos = file.Size();
-		UInt8* buffer = new UInt8[pos];
+		const AssetCache::PathID id = AssetCache::Intern(file.path.GetPath());
+
+		SDL_LockMutex(g_sampleMutex);
+		std::weak_ptr<SampleData>& entry = g_samples[id];
+		std::shared_ptr<SampleData> data = entry.lock();
+		if (data == nullptr)
+		{
+			data = std::make_shared<SampleData>(file.path);
+			entry = data;
+		}
+		SDL_UnlockMutex(g_sampleMutex);
+
+		switch (decode)
+		{
+		case AudioDecode::Immediate:
+			RequestDecode(data, false);
+
+			// Another clip may be decoding the same file on a worker.
+			SDL_LockMutex(g_sampleMutex);
+			while (data->state == SampleData::State::Decoding)
+			{
+				SDL_CondWait(g_sampleDecoded, g_sampleMutex);
+			}
+			SDL_UnlockMutex(g_sampleMutex);
+			break;
 
-		file.Read(buffer, pos);
+		case AudioDecode::Background:
+			RequestDecode(data, true);
+			break;
 
-		cOAL_Sample* sample = OAL_Sample_LoadFromBuffer(buffer, pos);
+		case AudioDecode::OnFirstPlay:
+			break;
+		}
+		return data;
+	}
 
-		if (sample == nullptr)
+	// Game thread side of playing a clip, starts OnFirstPlay decodes. False if it can never play.
+	static bool CanPlay(const std::shared_ptr<IAudioSample::AudioClipImpl>& clip)
+	{
+		if (clip->data == nullptr || clip->data->state == SampleData::State::Failed)
 		{
-			Logger::LogError("Audioclip not found %s!", file.path.GetPath().c_str());
+			return false;
 		}
 
-		delete buffer;
-		return sample;
+		RequestDecode(clip->data, true);
+		return true;
 	}
 
 	static cOAL_Stream* LoadStream(const File& file)
 	{
-		// returns nullptr if audio is not initialized.
-		if (!g_isAudioRunning || !File::Exists(file.path))
+		// returns nullptr if audio is not initialized or runs without a device.
+		if (!g_isAudioRunning || !g_hasDevice || !File::Exists(file.path))
 		{
 			return nullptr;
 		}
 		
-		UInt32 pos = file.Size();
-		UInt8* buffer = new UInt8[pos];
-
-		file.Read(buffer, pos);
+		const File::View view = file.Map();
 
-		cOAL_Stream* stream = OAL_Stream_LoadFromBuffer(buffer, pos);
+		cOAL_Stream* stream = OAL_Stream_LoadFromBuffer(view.Get(), view.size);
 
 		if (stream == nullptr)
 		{
 			Logger::LogError("Audioclip not found %s!", file.path.GetPath().c_str());
 		}
 
-		delete buffer;
 		return stream;
 	}
 
@@ -123,7 +1413,7 @@ namespace ace
 
 	}
 
-	AudioClip::AudioClip(const File& file, float volume, bool isPaused, bool loop) : IAudioSample(new AudioClipImpl(LoadSample(file)))
+	AudioClip::AudioClip(const File& file, float volume, bool isPaused, bool loop, AudioDecode decode) : IAudioSample(new AudioClipImpl(LoadSample(file, decode)))
 	{
 		this->volume = volume;
 		this->ispaused = isPaused;
@@ -137,41 +1427,128 @@ namespace ace
 
 	AudioStream::AudioStream(const File& file, float volume, bool isPaused, bool loop) : IAudioSample(new AudioClipImpl(LoadStream(file)))
 	{
+		// Music outranks effects when voices run out.
+		this->priority = 128u;
 		this->volume = volume;
 		this->ispaused = isPaused;
 		this->loop = loop;
 	}
 
 
-	void Audio::Init(bool externalInit)
+	static bool OpenDevice()
 	{
-		if (g_isAudioRunning)
+		cOAL_Init_Params oal_parms;
+
+		//ACE_ASSERT(OAL_Init(oal_parms), "Audio initializing failed!", "");
+
+		if (!OAL_Init(oal_parms))
 		{
-			return;
+			std::string error = OAL_GetALCErrorString();
+			Logger::LogError("Audio initialization failed: %s", error.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	// Starts the software mixer and its output for every backend but OpenAL.
+	static void OpenMixer(const char* outputPath)
+	{
+		g_mixer = new AudioMixer(MixFrequency);
+		g_mixedFrames = 0u;
+		g_mixWritten = 0u;
+		g_mixRead = 0u;
+
+		if (g_backend == AudioBackend::Mixer)
+		{
+			const tStreamCallbacks callbacks = { nullptr, MixStreamGetTime, nullptr, MixStreamFill, nullptr };
+			const tStreamInfo info = { 2, static_cast<ALint>(MixFrequency), AL_FORMAT_STEREO16, 0, 0.0 };
+
+			g_mixStream = OAL_Stream_LoadCustom(callbacks, info, nullptr);
+			g_mixSource = g_mixStream != nullptr ? OAL_Stream_Play(OAL_FREE, g_mixStream, 1.f, false) : -1;
+			if (g_mixSource == -1)
+			{
+				Logger::LogError("Audio mixer stream could not be played, mixed clips are silent!");
+			}
+		}
+		else if (g_backend == AudioBackend::WavFile)
+		{
+			OpenWavFile(outputPath);
+		}
+	}
+
+	static void CloseMixer()
+	{
+		if (g_mixSource != -1)
+		{
+			OAL_Source_Stop(g_mixSource);
+			g_mixSource = -1;
+		}
+		if (g_mixStream != nullptr)
+		{
+			OAL_Stream_Unload(g_mixStream);
+			g_mixStream = nullptr;
 		}
+		CloseWavFile();
 
+		delete g_mixer;
+		g_mixer = nullptr;
+	}
+
+	static void StartAudio()
+	{
 		g_isAudioRunning = true;
 
+		// The device may mix fewer sources than the pool holds, the rest stay virtual. The mixer has room for all of them.
+		g_realVoiceLimit = g_mixer != nullptr ? MaxVoices :
+			static_cast<UInt32>(std::max(std::min(OAL_Info_GetNumSources(), static_cast<int>(MaxVoices)), 1));
+
+		g_clockStart = SDL_GetPerformanceCounter();
+		g_lastUpdate = 0.0;
+		g_wakeMutex = SDL_CreateMutex();
+		g_wakeCond = SDL_CreateCond();
+		g_sampleMutex = SDL_CreateMutex();
+		g_sampleDecoded = SDL_CreateCond();
+		g_audioThread = SDL_CreateThread(AudioUpdate, "Audio", nullptr);
+	}
+
+	void Audio::Init(bool externalInit)
+	{
+		if (g_isAudioRunning)
+		{
+			return;
+		}
 
 		if (!externalInit)
 		{
+			Init(AudioBackend::OpenAL);
+			return;
+		}
 
-			cOAL_Init_Params oal_parms;
+		g_backend = AudioBackend::OpenAL;
+		g_hasDevice = true;
+		StartAudio();
+	}
 
-			//ACE_ASSERT(OAL_Init(oal_parms), "Audio initializing failed!", "");
+	void Audio::Init(AudioBackend backend, const char* outputPath)
+	{
+		if (g_isAudioRunning)
+		{
+			return;
+		}
 
-			if (!OAL_Init(oal_parms))
-			{
-				std::string error = OAL_GetALCErrorString();
-				Logger::LogError("Audio initialization failed: %s", error.c_str());
-				g_isAudioRunning = false;
-			}
+		g_backend = backend;
+		g_hasDevice = backend == AudioBackend::OpenAL || backend == AudioBackend::Mixer;
+		if (g_hasDevice && !OpenDevice())
+		{
+			g_hasDevice = false;
+			return;
 		}
 
-		if (g_isAudioRunning)
+		if (backend != AudioBackend::OpenAL)
 		{
-			g_audioThread = SDL_CreateThread(AudioUpdate, "Audio", nullptr);
+			OpenMixer(outputPath);
 		}
+		StartAudio();
 	}
 
 	void Audio::Quit()
@@ -179,26 +1556,61 @@ namespace ace
 		if (g_isAudioRunning)
 		{
 			g_isAudioRunning = false;
+			WakeAudioThread();
 			SDL_WaitThread(g_audioThread, nullptr);
 			g_audioThread = nullptr;
 
-			OAL_Close();
+			// Background decodes still signal the conditions.
+			while (g_decodeCount != 0u)
+			{
+				SDL_Delay(1u);
+			}
+
+			SDL_DestroyCond(g_wakeCond);
+			SDL_DestroyMutex(g_wakeMutex);
+			g_wakeCond = nullptr;
+			g_wakeMutex = nullptr;
+
+			SDL_DestroyCond(g_sampleDecoded);
+			SDL_DestroyMutex(g_sampleMutex);
+			g_sampleDecoded = nullptr;
+			g_sampleMutex = nullptr;
+			g_samples.clear();
+			g_scheduled.clear();
+
+			// Commands that never reached the audio thread.
+			AudioCommand command;
+			while (g_commands.Pop(command))
+			{
+				delete command.effect;
+			}
+
+			// Sources are released before the device.
+			for (auto& voice : g_voices)
+			{
+				if (IsActive(voice))
+				{
+					FreeVoice(voice);
+				}
+			}
+
+			CloseMixer();
+			if (g_hasDevice)
+			{
+				OAL_Close();
+				g_hasDevice = false;
+			}
 		}
 	}
 
 	bool Audio::Update(const AudioClip& clip)
 	{
-		if(!g_isAudioRunning)
-		{
-			return false;
-		}
-		
-		if (clip->id != -1)
+		if(!g_isAudioRunning || clip.impl == nullptr)
 		{
 			return false;
 		}
 
-		return OAL_Source_IsPlaying(clip->id);
+		return clip->playing;
 	}
 
 	void AudioStream::Play()
@@ -218,14 +1630,9 @@ namespace ace
 			return;
 		}
 		
-		if (clip.impl->sample)
+		if (CanPlay(clip.impl))
 		{
-			clip.impl->id = OAL_Sample_Play(OAL_FREE, clip.impl->sample, clip.volume, clip.ispaused, 0);
-			Audio::GetAudio().clips.push_back(clip);
-
-			OAL_Source_SetLoop(clip->id, clip.loop);
-
-			OAL_Source_SetPaused(clip->id, false);
+			PushCommand(PlayCommand(AudioCommand::Type::PlaySample, clip.impl, clip.volume, clip.loop, clip.priority));
 		}
 		else
 		{
@@ -242,19 +1649,7 @@ namespace ace
 		
 		if (stream.impl->stream)
 		{
-			if (stream.impl->id != -1)
-			{
-				stream.SetElapsedTime(0);
-			}
-			else
-			{
-				stream.impl->id = OAL_Stream_Play(OAL_FREE, stream.impl->stream, stream.volume, stream.ispaused);
-
-				OAL_Source_SetLoop(stream->id, stream.loop);
-
-				OAL_Source_SetPaused(stream->id, false);
-			}
-
+			PushCommand(PlayCommand(AudioCommand::Type::PlayStream, stream.impl, stream.volume, stream.loop, stream.priority));
 		}
 		else
 		{
@@ -262,6 +1657,37 @@ namespace ace
 		}
 	}
 
+	void Audio::PlayAudioAt(AudioClip& clip, double time)
+	{
+		if (!g_isAudioRunning || clip.impl == nullptr || !CanPlay(clip.impl))
+		{
+			return;
+		}
+
+		AudioCommand command = PlayCommand(AudioCommand::Type::PlaySample, clip.impl, clip.volume, clip.loop, clip.priority);
+		command.flag = true;
+		command.time = time;
+		PushCommand(std::move(command));
+	}
+
+	void Audio::PlayAudioAt(AudioStream& stream, double time)
+	{
+		if (!g_isAudioRunning || stream.impl == nullptr || stream.impl->stream == nullptr)
+		{
+			return;
+		}
+
+		AudioCommand command = PlayCommand(AudioCommand::Type::PlayStream, stream.impl, stream.volume, stream.loop, stream.priority);
+		command.flag = true;
+		command.time = time;
+		PushCommand(std::move(command));
+	}
+
+	double Audio::GetTime()
+	{
+		return g_isAudioRunning ? GetAudioClock() : 0.0;
+	}
+
 	void Audio::PauseAudio(AudioClip& clip)
 	{
 		if (!g_isAudioRunning || clip.impl == nullptr)
@@ -280,7 +1706,9 @@ namespace ace
 			return;
 		}
 		
-		OAL_Source_SetPaused(clip->id, pause);
+		AudioCommand command = ClipCommand(AudioCommand::Type::Pause, clip.impl);
+		command.flag = pause;
+		PushCommand(std::move(command));
 	}
 
 	void Audio::StopAudio(const AudioClip& clip)
@@ -290,7 +1718,7 @@ namespace ace
 			return;
 		}
 		
-		OAL_Source_Stop(clip->id);
+		PushCommand(ClipCommand(AudioCommand::Type::Stop, clip.impl));
 	}
 
 	void Audio::StopAll()
@@ -300,7 +1728,7 @@ namespace ace
 			return;
 		}
 		
-		OAL_Source_Stop(OAL_ALL);
+		PushCommand(AudioCommand(AudioCommand::Type::StopAll));
 	}
 
 	void Audio::SetMasterVolume(float volume)
@@ -310,127 +1738,177 @@ namespace ace
 			return;
 		}
 		
-		OAL_Listener_SetMasterVolume(volume);
+		AudioCommand command(AudioCommand::Type::SetMasterVolume);
+		command.value = volume;
+		PushCommand(std::move(command));
 	}
 
 	void IAudioSample::SetVolume(float volume)
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
+		{
+			return;
+		}
+
+		if (IsAudioThread())
 		{
+			SetVoiceGain(impl, volume);
 			return;
 		}
 		
-		OAL_Source_SetGain((*this)->id, volume);
+		AudioCommand command = ClipCommand(AudioCommand::Type::SetGain, impl);
+		command.value = volume;
+		PushCommand(std::move(command));
 	}
 
 	float IAudioSample::GetVolume()
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
 		{
 			return 0;
 		}
 		
-		return OAL_Source_GetGain((*this)->id);
+		return impl->gain;
 	}
 
 	void IAudioSample::SetPitch(float pitch)
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
+		{
+			return;
+		}
+
+		if (IsAudioThread())
 		{
+			SetVoicePitch(impl, pitch);
 			return;
 		}
 		
-		OAL_Source_SetPitch((*this)->id, pitch);
+		AudioCommand command = ClipCommand(AudioCommand::Type::SetPitch, impl);
+		command.value = pitch;
+		PushCommand(std::move(command));
 	}
 
 	float IAudioSample::GetPitch()
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
 		{
 			return 0;
 		}
 		
-		return OAL_Source_GetPitch((*this)->id);
+		return impl->pitch;
 	}
 
 	void IAudioSample::SetLoop(bool loop)
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
+		{
+			return;
+		}
+
+		if (IsAudioThread())
 		{
+			SetVoiceLoop(impl, loop);
 			return;
 		}
 		
-		OAL_Source_SetLoop((*this)->id, loop);
+		AudioCommand command = ClipCommand(AudioCommand::Type::SetLoop, impl);
+		command.flag = loop;
+		PushCommand(std::move(command));
 	}
 
-	//void AudioClip::SetPriority(UInt32 priority)
-	//{
-	//	OAL_Source_SetPriority((*this)->id, priority);
-	//}
+	void IAudioSample::SetPriority(UInt32 priority)
+	{
+		this->priority = priority;
+	}
 
-	//UInt32 AudioClip::GetPriority()
-	//{
-	//	return OAL_Source_GetPriority((*this)->id);
-	//}
+	UInt32 IAudioSample::GetPriority()
+	{
+		return priority;
+	}
 
 	void IAudioSample::SetElapsedTime(double time)
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
+		{
+			return;
+		}
+
+		if (IsAudioThread())
 		{
+			SetVoiceElapsedTime(impl, time);
 			return;
 		}
 		
-		OAL_Source_SetElapsedTime((*this)->id, time);
+		AudioCommand command = ClipCommand(AudioCommand::Type::SetElapsedTime, impl);
+		command.time = time;
+		PushCommand(std::move(command));
 	}
 
 	double IAudioSample::GetElapsedTime()
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
 		{
 			return 0;
 		}
 		
-		return OAL_Source_GetElapsedTime((*this)->id);
+		return impl->elapsedTime;
 	}
 
 	double IAudioSample::GetTotalTime()
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
 		{
 			return 0;
 		}
 		
-		return OAL_Source_GetTotalTime((*this)->id);
+		return impl->totalTime;
 	}
 
 	bool IAudioSample::IsPlaying()
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
 		{
 			return false;
 		}
 		
-		return OAL_Source_IsPlaying((*this)->id);
+		return impl->playing;
 	}
 
 	void IAudioSample::SetPosition(math::Vector3 position)
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
+		{
+			return;
+		}
+
+		if (IsAudioThread())
 		{
+			SetVoicePosition(impl, position.array);
 			return;
 		}
 		
-		OAL_Source_SetPosition((*this)->id, position.array);
+		AudioCommand command = ClipCommand(AudioCommand::Type::SetPosition, impl);
+		SetVector(command.vectors[0], position);
+		PushCommand(std::move(command));
 	}
 
 	void IAudioSample::SetVelocity(math::Vector3 velocity)
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || impl == nullptr)
+		{
+			return;
+		}
+
+		if (IsAudioThread())
 		{
+			SetVoiceVelocity(impl, velocity.array);
 			return;
 		}
 		
-		OAL_Source_SetPosition((*this)->id, velocity.array);
+		AudioCommand command = ClipCommand(AudioCommand::Type::SetVelocity, impl);
+		SetVector(command.vectors[0], velocity);
+		PushCommand(std::move(command));
 	}
 
 	void AudioClip::Fade(float duration, float endVolume)
@@ -476,20 +1954,28 @@ namespace ace
 			delete effect;
 			return;
 		}
-		
-		Audio& audio = Audio::GetAudio();
 
-		audio.effects.push_back(effect);
+		if (IsAudioThread())
+		{
+			GetAudio().effects.push_back(effect);
+			return;
+		}
+		
+		AudioCommand command(AudioCommand::Type::AddEffect);
+		command.effect = effect;
+		PushCommand(std::move(command));
 	}
 
-	void Audio::PlayAudioAtPosition(const AudioClip& Clip, math::Vector3 pos)
+	void Audio::PlayAudioAtPosition(const AudioClip& clip, math::Vector3 pos)
 	{
-		if(!g_isAudioRunning)
+		if(!g_isAudioRunning || clip.impl == nullptr)
 		{
 			return;
 		}
 		
-		OAL_Source_SetPosition(Clip->id, pos.array);
+		AudioCommand command = ClipCommand(AudioCommand::Type::SetPosition, clip.impl);
+		SetVector(command.vectors[0], pos);
+		PushCommand(std::move(command));
 	}
 
 	void Audio::SetAttributes(math::Vector3 apPos, math::Vector3 apVel, math::Vector3 apForward, math::Vector3 apUpward)
@@ -499,7 +1985,146 @@ namespace ace
 			return;
 		}
 		
-		OAL_Listener_SetAttributes(apPos.array, apVel.array, apForward.array, apUpward.array);
+		AudioCommand command(AudioCommand::Type::SetListener);
+		SetVector(command.vectors[0], apPos);
+		SetVector(command.vectors[1], apVel);
+		SetVector(command.vectors[2], apForward);
+		SetVector(command.vectors[3], apUpward);
+		PushCommand(std::move(command));
+	}
+
+	void AudioClip::SetMaxInstances(UInt32 count)
+	{
+		if (impl != nullptr)
+		{
+			impl->maxInstances = count;
+		}
+	}
+
+	void Audio::SetCullDistance(float distance)
+	{
+		g_cullDistance = distance;
+	}
+
+	UInt32 Audio::GetVoiceCount()
+	{
+		return g_voiceCount;
+	}
+
+	UInt32 Audio::GetRealVoiceCount()
+	{
+		return g_realVoiceCount;
+	}
+
+	void Audio::ProcessCommands()
+	{
+		AudioCommand command;
+		while (g_commands.Pop(command))
+		{
+			const std::shared_ptr<IAudioSample::AudioClipImpl>& clip = command.clip;
+
+			switch (command.type)
+			{
+			case AudioCommand::Type::PlaySample:
+			case AudioCommand::Type::PlayStream:
+				if (command.flag || (!PrepareSample(*clip) && IsDecoding(*clip)))
+				{
+					// Scheduled, or waiting for a background decode.
+					g_scheduled.push_back({ clip, command.time, command.value, command.loop, command.priority, command.flag });
+				}
+				else if (IsPrepared(*clip))
+				{
+					PlayVoice(clip, command.value, command.loop, command.priority);
+				}
+				break;
+
+			case AudioCommand::Type::Pause:
+				ForEachVoice(clip, [&command](Voice& voice)
+				{
+					voice.paused = command.flag;
+					if (voice.source != -1)
+					{
+						SetSourcePaused(voice, command.flag);
+					}
+				});
+				clip->playing = !command.flag;
+				break;
+
+			case AudioCommand::Type::Stop:
+				ForEachVoice(clip, FreeVoice);
+				g_scheduled.erase(std::remove_if(g_scheduled.begin(), g_scheduled.end(), [&clip](const ScheduledStart& start)
+				{
+					return start.clip == clip;
+				}), g_scheduled.end());
+				break;
+
+			case AudioCommand::Type::StopAll:
+				g_scheduled.clear();
+				for (auto& voice : g_voices)
+				{
+					if (IsActive(voice))
+					{
+						FreeVoice(voice);
+					}
+				}
+				break;
+
+			case AudioCommand::Type::SetGain:
+				SetVoiceGain(clip, command.value);
+				break;
+
+			case AudioCommand::Type::SetPitch:
+				SetVoicePitch(clip, command.value);
+				break;
+
+			case AudioCommand::Type::SetLoop:
+				SetVoiceLoop(clip, command.flag);
+				break;
+
+			case AudioCommand::Type::SetElapsedTime:
+				SetVoiceElapsedTime(clip, command.time);
+				break;
+
+			case AudioCommand::Type::SetPosition:
+				SetVoicePosition(clip, command.vectors[0]);
+				break;
+
+			case AudioCommand::Type::SetVelocity:
+				SetVoiceVelocity(clip, command.vectors[0]);
+				break;
+
+			case AudioCommand::Type::SetMasterVolume:
+				// With a device the listener also scales the mixer's stream.
+				if (g_hasDevice)
+				{
+					OAL_Listener_SetMasterVolume(command.value);
+				}
+				else if (g_mixer != nullptr)
+				{
+					g_mixer->SetMasterGain(command.value);
+				}
+				break;
+
+			case AudioCommand::Type::SetListener:
+				std::memcpy(g_listener, command.vectors[0], sizeof(g_listener));
+				if (g_mixer != nullptr)
+				{
+					g_mixer->SetListener(command.vectors[0], command.vectors[2], command.vectors[3]);
+				}
+				if (g_hasDevice)
+				{
+					OAL_Listener_SetAttributes(command.vectors[0], command.vectors[1], command.vectors[2], command.vectors[3]);
+				}
+				break;
+
+			case AudioCommand::Type::AddEffect:
+				Audio::GetAudio().effects.push_back(command.effect);
+				break;
+
+			case AudioCommand::Type::None:
+				break;
+			}
+		}
 	}
 
 	void Audio::Update()
@@ -508,37 +2133,68 @@ namespace ace
 		{
 			return;
 		}
-		
-		Audio& audio = Audio::GetAudio();
 
-		for (UInt32 i = 0u; i < audio.effects.size(); ++i)
+		ACE_PROFILE_SCOPE("Audio::Update");
+
+		// Fades and virtual voices advance on the audio clock, not the game's frame time.
+		const double now = GetAudioClock();
+		const double dt = now - g_lastUpdate;
+		g_lastUpdate = now;
+
+		ProcessCommands();
+		StartScheduled(now);
+
+		auto& effects = Audio::GetAudio().effects;
+		for (UInt32 i = 0u; i < effects.size();)
 		{
-			if (audio.effects[i] == nullptr)
-			{
-				continue;
-			}
+			IAudioEffect* effect = effects[i];
+			effect->time += static_cast<float>(dt);
+
+			const float normalized = effect->time / effect->duration;
 
-			float normalized = audio.effects[i]->time / audio.effects[i]->duration;
+			// TODO: Check that effect clip is playing.
+
+			effect->Effect(normalized > 1.f ? 1.f : normalized);
 
-			if (normalized > 1)
+			if (normalized >= 1.f)
 			{
-				delete audio.effects[i];
-				audio.effects[i] = nullptr;
+				delete effect;
+				effects.erase(effects.begin() + i);
 				continue;
 			}
+			++i;
+		}
 
-			// TODO: Check that effect clip is playing.
+		UpdateVoices(dt);
+		RenderMix(now);
 
-			audio.effects[i]->Effect(normalized);
-			audio.effects[i]->time += Time::DeltaTime();
+		// Sleeps until the next thing to do, or until woken by a command.
+		g_wait = SDL_MUTEX_MAXWAIT;
+		if (!effects.empty())
+		{
+			g_wait = FadeWait;
+		}
+		else if (g_voiceCount > 0u)
+		{
+			g_wait = PlaybackWait;
+		}
+
+		// Mixed voices are rendered by this thread, often enough to stay ahead of the output.
+		if (g_mixer != nullptr && g_mixer->GetVoiceCount() > 0u)
+		{
+			g_wait = std::min(g_wait, FadeWait);
 		}
 
-		for (UInt32 i = 0u; i < audio.clips.size(); ++i)
+		for (const auto& start : g_scheduled)
 		{
-			if (!OAL_Source_IsPlaying(audio.clips[i]->id))
+			// Undecoded clips wake the thread when they are done.
+			if (!IsPrepared(*start.clip))
 			{
-				// TODO: Remove clip from the vector. (Or add check for "duplicated" clips in PlayAudio method)
+				continue;
 			}
+
+			const double until = std::max(0.0, start.time - GetAudioClock());
+			g_wait = std::min(g_wait, static_cast<Uint32>(std::ceil(until * 1000.0)));
 		}
 	}
 }
@@ -0,0 +1,428 @@
+#include <Ace/AudioMixer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ACE_MIXER_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define ACE_MIXER_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace ace
+{
+    // Bound by reference in std::min.
+    const UInt32 AudioMixer::MaxVoices;
+    const UInt32 AudioMixer::BlockFrames;
+
+    static const float QuarterPi = 0.785398163f;
+
+    // Voices only play forwards, a non-positive pitch would step before the first frame.
+    static const float MinPitch = 0.01f;
+
+    // Also replaces NaN.
+    static float ClampPitch(const float pitch)
+    {
+        return pitch > MinPitch ? pitch : MinPitch;
+    }
+
+    // mix[i] += input[i] * gain, with gain ramping by step per frame.
+    static void Accumulate(float* mix, const float* input, const UInt32 count, const float gain, const float step)
+    {
+        UInt32 i = 0u;
+
+#if ACE_MIXER_SSE2
+        __m128 gains = _mm_setr_ps(gain, gain + step, gain + 2.f * step, gain + 3.f * step);
+        const __m128 steps = _mm_set1_ps(4.f * step);
+        for (; i + 4u <= count; i += 4u)
+        {
+            const __m128 sum = _mm_add_ps(_mm_loadu_ps(mix + i), _mm_mul_ps(_mm_loadu_ps(input + i), gains));
+            _mm_storeu_ps(mix + i, sum);
+            gains = _mm_add_ps(gains, steps);
+        }
+#elif ACE_MIXER_NEON
+        const float ramp[4] = { gain, gain + step, gain + 2.f * step, gain + 3.f * step };
+        float32x4_t gains = vld1q_f32(ramp);
+        const float32x4_t steps = vdupq_n_f32(4.f * step);
+        for (; i + 4u <= count; i += 4u)
+        {
+            vst1q_f32(mix + i, vmlaq_f32(vld1q_f32(mix + i), vld1q_f32(input + i), gains));
+            gains = vaddq_f32(gains, steps);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            mix[i] += input[i] * (gain + step * i);
+        }
+    }
+
+    // Scales, saturates and interleaves the planar mix into 16-bit stereo.
+    static void Interleave(const float* left, const float* right, const float gain, Int16* output, const UInt32 count)
+    {
+        UInt32 i = 0u;
+
+#if ACE_MIXER_SSE2
+        const __m128 scale = _mm_set1_ps(gain);
+        const __m128 low = _mm_set1_ps(-32768.f);
+        const __m128 high = _mm_set1_ps(32767.f);
+        for (; i + 4u <= count; i += 4u)
+        {
+            // Clamped first, out of range conversions do not saturate.
+            // Truncated like the NEON and scalar paths, every path produces the same samples.
+            const __m128 l = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(left + i), scale), low), high);
+            const __m128 r = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(right + i), scale), low), high);
+            const __m128i li = _mm_cvttps_epi32(l);
+            const __m128i ri = _mm_cvttps_epi32(r);
+            const __m128i frames = _mm_packs_epi32(_mm_unpacklo_epi32(li, ri), _mm_unpackhi_epi32(li, ri));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2u), frames);
+        }
+#elif ACE_MIXER_NEON
+        for (; i + 4u <= count; i += 4u)
+        {
+            int16x4x2_t frames;
+            frames.val[0] = vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(left + i), gain)));
+            frames.val[1] = vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(right + i), gain)));
+            vst2_s16(output + i * 2u, frames);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            output[i * 2u] = static_cast<Int16>(std::min(std::max(left[i] * gain, -32768.f), 32767.f));
+            output[i * 2u + 1u] = static_cast<Int16>(std::min(std::max(right[i] * gain, -32768.f), 32767.f));
+        }
+    }
+
+    AudioMixer::AudioMixer(const UInt32 frequency) :
+        m_frequency(frequency),
+        m_voiceCount(0u),
+        m_masterGain(1.f),
+        m_voices(MaxVoices)
+    {
+        // OpenAL's default listener, facing -z with +y up.
+        const float position[3] = { 0.f, 0.f, 0.f };
+        const float forward[3] = { 0.f, 0.f, -1.f };
+        const float up[3] = { 0.f, 1.f, 0.f };
+        SetListener(position, forward, up);
+
+        for (UInt32 c = 0u; c < 2u; ++c)
+        {
+            m_mix[c].resize(BlockFrames);
+            m_scratch[c].resize(BlockFrames);
+        }
+
+        for (auto& voice : m_voices)
+        {
+            voice.active = false;
+        }
+    }
+
+    Int32 AudioMixer::Play(const std::shared_ptr<const PCMBuffer>& buffer, const float gain, const float pitch, const bool loop, const bool paused)
+    {
+        if (buffer == nullptr || buffer->frames == 0u || m_voiceCount == MaxVoices)
+        {
+            return -1;
+        }
+
+        for (UInt32 i = 0u; i < MaxVoices; ++i)
+        {
+            Voice& voice = m_voices[i];
+            if (voice.active)
+            {
+                continue;
+            }
+
+            voice.buffer = buffer;
+            voice.position = 0.0;
+            voice.pitch = ClampPitch(pitch);
+            voice.gain = gain;
+            voice.active = true;
+            voice.paused = paused;
+            voice.loop = loop;
+            voice.positional = false;
+            std::memset(voice.location, 0, sizeof(voice.location));
+
+            UpdateTarget(voice);
+            voice.current[0] = voice.target[0];
+            voice.current[1] = voice.target[1];
+
+            ++m_voiceCount;
+            return static_cast<Int32>(i);
+        }
+        return -1;
+    }
+
+    void AudioMixer::Stop(const Int32 index)
+    {
+        if (Voice* voice = Find(index))
+        {
+            voice->active = false;
+            voice->buffer.reset();
+            --m_voiceCount;
+        }
+    }
+
+    bool AudioMixer::IsPlaying(const Int32 index) const
+    {
+        return Find(index) != nullptr;
+    }
+
+    void AudioMixer::SetPaused(const Int32 index, const bool paused)
+    {
+        if (Voice* voice = Find(index))
+        {
+            voice->paused = paused;
+        }
+    }
+
+    void AudioMixer::SetGain(const Int32 index, const float gain)
+    {
+        if (Voice* voice = Find(index))
+        {
+            voice->gain = gain;
+            UpdateTarget(*voice);
+        }
+    }
+
+    void AudioMixer::SetPitch(const Int32 index, const float pitch)
+    {
+        if (Voice* voice = Find(index))
+        {
+            voice->pitch = ClampPitch(pitch);
+        }
+    }
+
+    void AudioMixer::SetLoop(const Int32 index, const bool loop)
+    {
+        if (Voice* voice = Find(index))
+        {
+            voice->loop = loop;
+        }
+    }
+
+    void AudioMixer::SetElapsedTime(const Int32 index, const double seconds)
+    {
+        if (Voice* voice = Find(index))
+        {
+            voice->position = std::max(0.0, seconds * voice->buffer->frequency);
+        }
+    }
+
+    double AudioMixer::GetElapsedTime(const Int32 index) const
+    {
+        const Voice* voice = Find(index);
+        return voice ? voice->position / voice->buffer->frequency : 0.0;
+    }
+
+    void AudioMixer::SetPosition(const Int32 index, const float* position)
+    {
+        if (Voice* voice = Find(index))
+        {
+            voice->positional = true;
+            std::memcpy(voice->location, position, sizeof(voice->location));
+            UpdateTarget(*voice);
+        }
+    }
+
+    void AudioMixer::SetListener(const float* position, const float* forward, const float* up)
+    {
+        std::memcpy(m_listener, position, sizeof(m_listener));
+
+        // Right handed like OpenAL, right = forward x up.
+        m_right[0] = forward[1] * up[2] - forward[2] * up[1];
+        m_right[1] = forward[2] * up[0] - forward[0] * up[2];
+        m_right[2] = forward[0] * up[1] - forward[1] * up[0];
+
+        const float length = std::sqrt(m_right[0] * m_right[0] + m_right[1] * m_right[1] + m_right[2] * m_right[2]);
+        for (UInt32 i = 0u; i < 3u; ++i)
+        {
+            m_right[i] = length > 0.f ? m_right[i] / length : (i == 0u ? 1.f : 0.f);
+        }
+
+        for (auto& voice : m_voices)
+        {
+            if (voice.active && voice.positional)
+            {
+                UpdateTarget(voice);
+            }
+        }
+    }
+
+    void AudioMixer::SetMasterGain(const float gain)
+    {
+        m_masterGain = gain;
+    }
+
+    UInt32 AudioMixer::GetFrequency() const
+    {
+        return m_frequency;
+    }
+
+    UInt32 AudioMixer::GetVoiceCount() const
+    {
+        return m_voiceCount;
+    }
+
+    AudioMixer::Voice* AudioMixer::Find(const Int32 index)
+    {
+        return index >= 0 && index < static_cast<Int32>(MaxVoices) && m_voices[index].active ? &m_voices[index] : nullptr;
+    }
+
+    const AudioMixer::Voice* AudioMixer::Find(const Int32 index) const
+    {
+        return index >= 0 && index < static_cast<Int32>(MaxVoices) && m_voices[index].active ? &m_voices[index] : nullptr;
+    }
+
+    void AudioMixer::UpdateTarget(Voice& voice) const
+    {
+        voice.target[0] = voice.gain;
+        voice.target[1] = voice.gain;
+
+        if (!voice.positional || voice.buffer->channels != 1u)
+        {
+            return;
+        }
+
+        float offset[3];
+        for (UInt32 i = 0u; i < 3u; ++i)
+        {
+            offset[i] = voice.location[i] - m_listener[i];
+        }
+        const float distance = std::sqrt(offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]);
+
+        // Inverse distance clamped at one unit, OpenAL's default model.
+        const float attenuation = 1.f / std::max(distance, 1.f);
+
+        float pan = 0.f;
+        if (distance > 0.0001f)
+        {
+            pan = (offset[0] * m_right[0] + offset[1] * m_right[1] + offset[2] * m_right[2]) / distance;
+            pan = std::min(std::max(pan, -1.f), 1.f);
+        }
+
+        // Equal power, a centred voice is 3 dB down on each side.
+        const float angle = (pan + 1.f) * QuarterPi;
+        voice.target[0] = voice.gain * attenuation * std::cos(angle);
+        voice.target[1] = voice.gain * attenuation * std::sin(angle);
+    }
+
+    UInt32 AudioMixer::Resample(Voice& voice, const UInt32 frames)
+    {
+        const PCMBuffer& buffer = *voice.buffer;
+        const Int16* samples = buffer.samples.data();
+        const UInt32 length = buffer.frames;
+        const bool stereo = buffer.channels == 2u;
+        const double step = static_cast<double>(voice.pitch) * buffer.frequency / m_frequency;
+
+        float* left = m_scratch[0].data();
+        float* right = m_scratch[1].data();
+
+        double position = voice.position;
+        UInt32 i = 0u;
+
+        for (; i < frames; ++i)
+        {
+            if (position >= length)
+            {
+                if (!voice.loop)
+                {
+                    break;
+                }
+                position = std::fmod(position, static_cast<double>(length));
+            }
+
+            const UInt32 index = static_cast<UInt32>(position);
+            const float fraction = static_cast<float>(position - index);
+
+            // Interpolates into the start when looping, holds the last frame otherwise.
+            const UInt32 next = index + 1u < length ? index + 1u : (voice.loop ? 0u : index);
+
+            if (stereo)
+            {
+                const float l0 = samples[index * 2u], l1 = samples[next * 2u];
+                const float r0 = samples[index * 2u + 1u], r1 = samples[next * 2u + 1u];
+                left[i] = l0 + (l1 - l0) * fraction;
+                right[i] = r0 + (r1 - r0) * fraction;
+            }
+            else
+            {
+                const float s0 = samples[index], s1 = samples[next];
+                left[i] = s0 + (s1 - s0) * fraction;
+            }
+
+            position += step;
+        }
+
+        voice.position = position;
+        return i;
+    }
+
+    void AudioMixer::MixBlock(const UInt32 frames)
+    {
+        std::fill(m_mix[0].begin(), m_mix[0].begin() + frames, 0.f);
+        std::fill(m_mix[1].begin(), m_mix[1].begin() + frames, 0.f);
+
+        for (auto& voice : m_voices)
+        {
+            if (!voice.active || voice.paused)
+            {
+                continue;
+            }
+
+            UInt32 count = frames;
+            const bool silent = voice.current[0] == 0.f && voice.current[1] == 0.f && voice.target[0] == 0.f && voice.target[1] == 0.f;
+
+            if (silent)
+            {
+                // Only the position moves.
+                const PCMBuffer& buffer = *voice.buffer;
+                voice.position += static_cast<double>(voice.pitch) * buffer.frequency / m_frequency * frames;
+                if (voice.position >= buffer.frames)
+                {
+                    count = voice.loop ? frames : 0u;
+                    voice.position = std::fmod(voice.position, static_cast<double>(buffer.frames));
+                }
+            }
+            else
+            {
+                count = Resample(voice, frames);
+
+                const bool stereo = voice.buffer->channels == 2u;
+                const float* left = m_scratch[0].data();
+                const float* right = m_scratch[stereo ? 1u : 0u].data();
+
+                const float stepLeft = (voice.target[0] - voice.current[0]) / frames;
+                const float stepRight = (voice.target[1] - voice.current[1]) / frames;
+
+                Accumulate(m_mix[0].data(), left, count, voice.current[0], stepLeft);
+                Accumulate(m_mix[1].data(), right, count, voice.current[1], stepRight);
+
+                voice.current[0] = voice.target[0];
+                voice.current[1] = voice.target[1];
+            }
+
+            if (count < frames)
+            {
+                voice.active = false;
+                voice.buffer.reset();
+                --m_voiceCount;
+            }
+        }
+    }
+
+    void AudioMixer::Mix(Int16* output, const UInt32 frames)
+    {
+        for (UInt32 done = 0u; done < frames;)
+        {
+            const UInt32 count = std::min(frames - done, BlockFrames);
+            MixBlock(count);
+            Interleave(m_mix[0].data(), m_mix[1].data(), m_masterGain, output + done * 2u, count);
+            done += count;
+        }
+    }
+
+}
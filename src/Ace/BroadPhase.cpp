@@ -0,0 +1,98 @@
+#include <Ace/BroadPhase.h>
+
+#include <algorithm> // std::sort, std::remove_if
+
+namespace ace
+{
+
+    BroadPhase::BroadPhase() :
+        m_collidables(),
+        m_pairs(),
+        m_nextProxy(0u)
+    {
+
+    }
+
+    BroadPhase::~BroadPhase()
+    {
+
+    }
+
+    UInt32 BroadPhase::Add(Collidable& collidable, bool updateAABB)
+    {
+        if (updateAABB)
+        {
+            collidable.UpdateAABB();
+        }
+        m_collidables.push_back({ &collidable, m_nextProxy });
+        return m_nextProxy++;
+    }
+
+    void BroadPhase::Remove(Collidable& collidable)
+    {
+        m_collidables.erase(std::remove_if(m_collidables.begin(), m_collidables.end(), [&collidable](const Proxy& proxy)
+        {
+            return proxy.collidable == &collidable;
+        }), m_collidables.end());
+        m_pairs.clear();
+    }
+
+    void BroadPhase::Clear()
+    {
+        m_collidables.clear();
+        m_pairs.clear();
+        m_nextProxy = 0u;
+    }
+
+    const std::vector<BroadPhase::Pair>& BroadPhase::Update(bool updateAABBs)
+    {
+        m_pairs.clear();
+
+        // Static and sleeping Collidables don't move, their AABBs are still valid.
+        for (auto& itr : m_collidables)
+        {
+            if (updateAABBs && itr.collidable->IsAwake())
+            {
+                itr.collidable->UpdateAABB();
+            }
+        }
+
+        // Insertion sort would be cheaper for mostly coherent frames, but std::sort keeps the worst case bounded.
+        std::sort(m_collidables.begin(), m_collidables.end(), [](const Proxy& a, const Proxy& b)
+        {
+            return a.collidable->GetAABB().min.x < b.collidable->GetAABB().min.x;
+        });
+
+        const UInt32 size = static_cast<UInt32>(m_collidables.size());
+        for (UInt32 i = 0u; i < size; ++i)
+        {
+            Collidable* a = m_collidables[i].collidable;
+            const AABB& aabbA = a->GetAABB();
+
+            for (UInt32 j = i + 1u; j < size; ++j)
+            {
+                Collidable* b = m_collidables[j].collidable;
+                const AABB& aabbB = b->GetAABB();
+
+                // Sorted by min.x, nothing after this can overlap on x.
+                if (aabbA.max.x < aabbB.min.x)
+                {
+                    break;
+                }
+
+                if (!Collidable::CanCollide(*a, *b))
+                {
+                    continue;
+                }
+
+                if (aabbA.max.y >= aabbB.min.y && aabbA.min.y <= aabbB.max.y)
+                {
+                    m_pairs.push_back({ a, b, m_collidables[i].proxy, m_collidables[j].proxy });
+                }
+            }
+        }
+
+        return m_pairs;
+    }
+
+}
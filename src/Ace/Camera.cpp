@@ -26,6 +26,7 @@ namespace ace
 
 
 	Camera::Camera(EntityManager& manager) :
+        EventBase(0, EventMask(WindowEventType::Resized) | EventMask(WindowEventType::SizeChanged)),
         m_entity(manager),
         m_proj(),
         m_view(),
@@ -2,6 +2,9 @@
 #include <Ace/Math.h>
 #include <Ace/Log.h>
 
+#include <Ace/Image.h>
+
+#include <algorithm> // std::sort
 #include <limits> // numeric_limits::max()
 
 #include <Ace/Debugger.h>
@@ -34,9 +37,9 @@ namespace ace
 
     std::vector<Vector2> GetNormalsImpl(const std::vector<Vector2>& vertices)
     {
-        const UInt8 size = static_cast<UInt8>(vertices.size());
+        const UInt32 size = static_cast<UInt32>(vertices.size());
         std::vector<Vector2> normals(size);
-        for (UInt8 i = 0u; i < size; ++i)
+        for (UInt32 i = 0u; i < size; ++i)
         {
             // TODO: direction checks, normalization?
             //const Vector2 edge((vertices[i] - vertices[(i + 1u) < size ? (i + 1u) : 0u]).Normalize());
@@ -72,7 +75,7 @@ namespace ace
     {
         float min = Vector2::Dot(axis, vertices[0]);
         float max = min;
-        for (UInt8 i = 1u; i < vertices.size(); ++i)
+        for (UInt32 i = 1u; i < vertices.size(); ++i)
         {
             const float cur = Vector2::Dot(axis, vertices[i]);
             if (cur < min) min = cur;
@@ -90,7 +93,7 @@ namespace ace
         bool nearestIsInside = false;
         Int32 nearestVertexIndex = -1;
         bool lastIsInside = false;
-        for (UInt8 i = 0u; i < otherVertices.size(); ++i)
+        for (UInt32 i = 0u; i < otherVertices.size(); ++i)
         {
             const Vector2& nextVertex(otherVertices[i]);
             Vector2 axis(center - vertex);
@@ -128,8 +131,234 @@ namespace ace
 
 
 
-    Collidable::Collidable(const Vector2& position, const Matrix2& rotation) :
-        m_aabb(), m_rotation(rotation), m_position(position)
+    // Unit outward normals regardless of the winding of the vertices.
+    std::vector<Vector2> GetOutwardNormals(const std::vector<Vector2>& vertices)
+    {
+        const UInt32 size = static_cast<UInt32>(vertices.size());
+
+        float area = 0.f;
+        for (UInt32 i = 0u; i < size; ++i)
+        {
+            area += Vector2::Cross(vertices[i], vertices[(i + 1u) < size ? (i + 1u) : 0u]);
+        }
+        const float winding = area < 0.f ? -1.f : 1.f;
+
+        std::vector<Vector2> normals(size);
+        for (UInt32 i = 0u; i < size; ++i)
+        {
+            const Vector2 edge(vertices[(i + 1u) < size ? (i + 1u) : 0u] - vertices[i]);
+            normals[i] = Vector2(edge.y * winding, -edge.x * winding).Normalize();
+        }
+        return normals;
+    }
+
+    // Largest separation of b from the faces of a, negative when overlapping.
+    float FindMaxSeparation(
+        const std::vector<Vector2>& a,
+        const std::vector<Vector2>& normalsA,
+        const std::vector<Vector2>& b,
+        UInt32& edge
+    )
+    {
+        float maxSeparation = std::numeric_limits<float>::lowest();
+        for (UInt32 i = 0u; i < a.size(); ++i)
+        {
+            float separation = std::numeric_limits<float>::max();
+            for (const auto& vertex : b)
+            {
+                separation = math::Min(separation, Vector2::Dot(normalsA[i], vertex - a[i]));
+            }
+            if (separation > maxSeparation)
+            {
+                maxSeparation = separation;
+                edge = i;
+            }
+        }
+        return maxSeparation;
+    }
+
+    // Keeps the part of the segment behind the plane (normal, offset).
+    UInt8 ClipSegment(Vector2 (&out)[2u], const Vector2 (&in)[2u], const Vector2& normal, const float offset)
+    {
+        UInt8 count = 0u;
+        const float distance0 = Vector2::Dot(normal, in[0]) - offset;
+        const float distance1 = Vector2::Dot(normal, in[1]) - offset;
+
+        if (distance0 <= 0.f) out[count++] = in[0];
+        if (distance1 <= 0.f) out[count++] = in[1];
+
+        if (distance0 * distance1 < 0.f)
+        {
+            out[count++] = in[0] + (in[1] - in[0]) * (distance0 / (distance0 - distance1));
+        }
+        return count;
+    }
+
+    bool GetManifoldCircles(const Circle& a, const Circle& b, Manifold& manifold)
+    {
+        const Vector2 delta(b.GetLocalPosition() - a.GetLocalPosition());
+        const float radius = a.GetRadius() + b.GetRadius();
+        const float distanceSquared = delta.LengthSquared();
+
+        if (distanceSquared > radius * radius)
+        {
+            return false;
+        }
+
+        const float distance = math::Sqrt(distanceSquared);
+        manifold.normal = math::IsNearEpsilon(distance) ? Vector2(0.f, 1.f) : delta / distance;
+        manifold.depths[0] = radius - distance;
+        manifold.points[0] = a.GetLocalPosition() + manifold.normal * (a.GetRadius() - manifold.depths[0] * 0.5f);
+        manifold.count = 1u;
+        return true;
+    }
+
+    // Normal points from the polygon towards the circle.
+    bool GetManifoldPolygonCircle(const std::vector<Vector2>& vertices, const Circle& circle, Manifold& manifold)
+    {
+        const std::vector<Vector2> normals(GetOutwardNormals(vertices));
+        const Vector2& center = circle.GetLocalPosition();
+        const float radius = circle.GetRadius();
+        const UInt32 size = static_cast<UInt32>(vertices.size());
+
+        UInt32 edge = 0u;
+        float separation = std::numeric_limits<float>::lowest();
+        for (UInt32 i = 0u; i < size; ++i)
+        {
+            const float s = Vector2::Dot(normals[i], center - vertices[i]);
+            if (s > radius)
+            {
+                return false;
+            }
+            if (s > separation)
+            {
+                separation = s;
+                edge = i;
+            }
+        }
+
+        const Vector2& v1 = vertices[edge];
+        const Vector2& v2 = vertices[(edge + 1u) < size ? (edge + 1u) : 0u];
+
+        manifold.count = 1u;
+
+        // Center inside the polygon.
+        if (separation < 0.f)
+        {
+            manifold.normal = normals[edge];
+            manifold.depths[0] = radius - separation;
+            manifold.points[0] = center - normals[edge] * separation;
+            return true;
+        }
+
+        const Vector2* corner = nullptr;
+        if (Vector2::Dot(center - v1, v2 - v1) <= 0.f) corner = &v1;
+        else if (Vector2::Dot(center - v2, v1 - v2) <= 0.f) corner = &v2;
+
+        if (corner)
+        {
+            const Vector2 delta(center - *corner);
+            const float distanceSquared = delta.LengthSquared();
+            if (distanceSquared > radius * radius)
+            {
+                return false;
+            }
+            const float distance = math::Sqrt(distanceSquared);
+            manifold.normal = math::IsNearEpsilon(distance) ? normals[edge] : delta / distance;
+            manifold.depths[0] = radius - distance;
+            manifold.points[0] = *corner;
+            return true;
+        }
+
+        manifold.normal = normals[edge];
+        manifold.depths[0] = radius - separation;
+        manifold.points[0] = center - normals[edge] * separation;
+        return true;
+    }
+
+    // Reference face clipping, produces up to two contact points.
+    bool GetManifoldPolygons(const std::vector<Vector2>& a, const std::vector<Vector2>& b, Manifold& manifold)
+    {
+        const std::vector<Vector2> normalsA(GetOutwardNormals(a));
+        const std::vector<Vector2> normalsB(GetOutwardNormals(b));
+
+        UInt32 edgeA = 0u, edgeB = 0u;
+        const float separationA = FindMaxSeparation(a, normalsA, b, edgeA);
+        if (separationA > 0.f) return false;
+        const float separationB = FindMaxSeparation(b, normalsB, a, edgeB);
+        if (separationB > 0.f) return false;
+
+        // Prefer a as the reference to keep the manifold stable between frames.
+        const bool flip = separationB > separationA + 0.1f * math::epsilon;
+
+        const std::vector<Vector2>& reference = flip ? b : a;
+        const std::vector<Vector2>& incident = flip ? a : b;
+        const std::vector<Vector2>& incidentNormals = flip ? normalsA : normalsB;
+        const Vector2& normal = flip ? normalsB[edgeB] : normalsA[edgeA];
+        const UInt32 edge = flip ? edgeB : edgeA;
+
+        // Incident edge is the one most anti-parallel to the reference normal.
+        UInt32 incidentEdge = 0u;
+        float minDot = std::numeric_limits<float>::max();
+        for (UInt32 i = 0u; i < incident.size(); ++i)
+        {
+            const float dot = Vector2::Dot(normal, incidentNormals[i]);
+            if (dot < minDot)
+            {
+                minDot = dot;
+                incidentEdge = i;
+            }
+        }
+
+        const Vector2 segment[2u] = {
+            incident[incidentEdge],
+            incident[(incidentEdge + 1u) < incident.size() ? (incidentEdge + 1u) : 0u]
+        };
+
+        const Vector2& v1 = reference[edge];
+        const Vector2& v2 = reference[(edge + 1u) < reference.size() ? (edge + 1u) : 0u];
+        const Vector2 tangent((v2 - v1).Normalize());
+
+        Vector2 clipped[2u];
+        Vector2 result[2u];
+        if (ClipSegment(clipped, segment, tangent.Invert(), -Vector2::Dot(tangent, v1)) < 2u) return false;
+        if (ClipSegment(result, clipped, tangent, Vector2::Dot(tangent, v2)) < 2u) return false;
+
+        manifold.normal = flip ? normal.Invert() : normal;
+        manifold.count = 0u;
+
+        const float offset = Vector2::Dot(normal, v1);
+        for (const auto& point : result)
+        {
+            const float separation = Vector2::Dot(normal, point) - offset;
+            if (separation <= 0.f)
+            {
+                manifold.points[manifold.count] = point;
+                manifold.depths[manifold.count] = -separation;
+                ++manifold.count;
+            }
+        }
+        return manifold.count > 0u;
+    }
+
+
+
+    Manifold::Manifold() :
+        normal(), points(), depths{ 0.f, 0.f }, count(0u)
+    {
+
+    }
+
+    Collidable::Collidable(const CollidableType type, const Vector2& position, const Matrix2& rotation) :
+        m_aabb(),
+        m_rotation(rotation),
+        m_position(position),
+        m_layer(DefaultLayer),
+        m_mask(AllLayers),
+        m_type(type),
+        m_isStatic(false),
+        m_isSleeping(false),
+        m_userData(nullptr)
     {
         
     }
@@ -139,6 +368,11 @@ namespace ace
         
     }
 
+    void Collidable::UpdateAABB()
+    {
+        m_aabb.Update(*this);
+    }
+
     // Vector2 Collidable::GetGlobalPosition() const
     // {
     //     return m_rotation * m_position;
@@ -146,26 +380,40 @@ namespace ace
 
     bool Collidable::IsColliding(const Collidable& a, const Collidable& b)
     {
-        const std::vector<Vector2> verticesA(a.GetVertices());
-        const std::vector<Vector2> verticesB(b.GetVertices());
-        const std::vector<Vector2> normalsA(GetNormals(verticesA));
-        const std::vector<Vector2> normalsB(GetNormals(verticesB));
-        
-        if (normalsA.empty() && normalsB.empty()) // Both are circles
+        const bool isCircleA = a.GetType() == CollidableType::Circle;
+        const bool isCircleB = b.GetType() == CollidableType::Circle;
+
+        if (a.GetType() == CollidableType::Polygon && b.GetType() == CollidableType::Polygon)
+        {
+            return Polygon::IsColliding(static_cast<const Polygon&>(a), static_cast<const Polygon&>(b));
+        }
+        else if (isCircleA && isCircleB)
         {
             const float radius = static_cast<const Circle&>(a).GetRadius() + static_cast<const Circle&>(b).GetRadius();
             return (a.GetLocalPosition() - b.GetLocalPosition()).LengthSquared() <= (radius * radius);
         }
-        else if (normalsA.empty()) // A is a circle
+
+        const std::vector<Vector2> verticesA(a.GetVertices());
+        const std::vector<Vector2> verticesB(b.GetVertices());
+
+        // Degenerate polygons have no vertices.
+        if ((!isCircleA && verticesA.empty()) || (!isCircleB && verticesB.empty()))
+        {
+            return false;
+        }
+        else if (isCircleA)
         {
             return IsCollidingCircle(static_cast<const Circle&>(a), verticesB);
         }
-        else if (normalsB.empty()) // B is a circle
+        else if (isCircleB)
         {
             return IsCollidingCircle(static_cast<const Circle&>(b), verticesA);
         }
         else
         {
+            const std::vector<Vector2> normalsA(GetNormals(verticesA));
+            const std::vector<Vector2> normalsB(GetNormals(verticesB));
+
             for (const auto& n : normalsA) if (!IsOverlapping(ProjectAxis(n, verticesA), ProjectAxis(n, verticesB))) return false; // SA found
             for (const auto& n : normalsB) if (!IsOverlapping(ProjectAxis(n, verticesA), ProjectAxis(n, verticesB))) return false; // SA found
         }
@@ -176,8 +424,43 @@ namespace ace
 
 
 
+    bool Collidable::GetManifold(const Collidable& a, const Collidable& b, Manifold& manifold)
+    {
+        const bool isCircleA = a.GetType() == CollidableType::Circle;
+        const bool isCircleB = b.GetType() == CollidableType::Circle;
+
+        if (isCircleA && isCircleB)
+        {
+            return GetManifoldCircles(static_cast<const Circle&>(a), static_cast<const Circle&>(b), manifold);
+        }
+
+        const std::vector<Vector2> verticesA(a.GetVertices());
+        const std::vector<Vector2> verticesB(b.GetVertices());
+
+        // Degenerate polygons have no vertices.
+        if ((!isCircleA && verticesA.empty()) || (!isCircleB && verticesB.empty()))
+        {
+            return false;
+        }
+        else if (isCircleA)
+        {
+            if (!GetManifoldPolygonCircle(verticesB, static_cast<const Circle&>(a), manifold)) return false;
+            manifold.normal = manifold.normal.Invert();
+            return true;
+        }
+        else if (isCircleB)
+        {
+            return GetManifoldPolygonCircle(verticesA, static_cast<const Circle&>(b), manifold);
+        }
+        return GetManifoldPolygons(verticesA, verticesB, manifold);
+    }
+
+
+
+
+
     Circle::Circle(const float radius, const Vector2& position, const Matrix2& rotation) :
-        Collidable(position, rotation), m_radius(math::Abs(radius))
+        Collidable(CollidableType::Circle, position, rotation), m_radius(math::Abs(radius))
     {
         if (math::IsNearEpsilon(radius))
             Logger::Log(Logger::Priority::Warning, "Collidable: Circle: Radius near epsilon: %f", radius);
@@ -198,37 +481,33 @@ namespace ace
         return;
     }
 
+    void Circle::UpdateAABB()
+    {
+        m_aabb.min = Vector2(m_position.x - m_radius, m_position.y - m_radius);
+        m_aabb.max = Vector2(m_position.x + m_radius, m_position.y + m_radius);
+    }
+
 
     Rectangle::Rectangle(const Vector2& extents, const Vector2& position, const Matrix2& rotation) :
-        Collidable(position, rotation), m_extents(extents)
+        Collidable(CollidableType::Rectangle, position, rotation), m_extents(extents)
     {
         
     }
     
     bool Rectangle::IsColliding(const Vector2& point) const
     {
-        const Vector2 pos = m_rotation * (m_position + m_extents);
-        const Vector2 neg = m_rotation * (m_position + m_extents.Invert());
-        return IsInTriangle(
-            point,
-            pos,
-            m_rotation * (m_position + Vector2(-m_extents.x, m_extents.y)),
-            neg
-        ) || IsInTriangle(
-            point,
-            neg,
-            m_rotation * (m_position + Vector2(m_extents.x, -m_extents.y)),
-            pos
-        );
+        // Rotation is orthonormal, the transpose brings the point to local space.
+        const Vector2 local(m_rotation.Transpose() * (point - m_position));
+        return math::Abs(local.x) <= math::Abs(m_extents.x) && math::Abs(local.y) <= math::Abs(m_extents.y);
     }
     
     std::vector<Vector2> Rectangle::GetVertices() const
     {
         return {
-            m_rotation * (m_position + Vector2{-m_extents.x, -m_extents.y}),
-            m_rotation * (m_position + Vector2{ m_extents.x, -m_extents.y}),
-            m_rotation * (m_position + m_extents),
-            m_rotation * (m_position + Vector2{-m_extents.x,  m_extents.y})
+            m_position + (m_rotation * Vector2{-m_extents.x, -m_extents.y}),
+            m_position + (m_rotation * Vector2{ m_extents.x, -m_extents.y}),
+            m_position + (m_rotation * m_extents),
+            m_position + (m_rotation * Vector2{-m_extents.x,  m_extents.y})
         };
     }
 
@@ -242,7 +521,7 @@ namespace ace
 
 
     Triangle::Triangle(const Vector2 (&extents)[3u], const Vector2& position, const Matrix2& rotation) :
-        Collidable(position, rotation), m_extents{ extents[0], extents[1], extents[2] }
+        Collidable(CollidableType::Triangle, position, rotation), m_extents{ extents[0], extents[1], extents[2] }
     {
         
     }
@@ -251,9 +530,9 @@ namespace ace
     {
         return IsInTriangle(
             point,
-            m_rotation * (m_position + m_extents[0]),
-            m_rotation * (m_position + m_extents[1]),
-            m_rotation * (m_position + m_extents[2])
+            m_position + (m_rotation * m_extents[0]),
+            m_position + (m_rotation * m_extents[1]),
+            m_position + (m_rotation * m_extents[2])
         );
     }
     
@@ -272,5 +551,302 @@ namespace ace
             itr *= Matrix2::Rotation(deg);
         m_rotation = Matrix2::Identity();
     }
-    
+
+
+
+
+    // Andrew's monotone chain, counter-clockwise without collinear points.
+    std::vector<Vector2> ComputeHull(std::vector<Vector2> points)
+    {
+        std::sort(points.begin(), points.end(), [](const Vector2& a, const Vector2& b)
+        {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+        });
+
+        if (points.size() < 3u)
+        {
+            return points;
+        }
+
+        std::vector<Vector2> hull(points.size() * 2u);
+        UInt32 k = 0u;
+
+        for (UInt32 i = 0u; i < points.size(); ++i)
+        {
+            while (k >= 2u && Vector2::Cross(hull[k - 1u] - hull[k - 2u], points[i] - hull[k - 2u]) <= 0.f) --k;
+            hull[k++] = points[i];
+        }
+        for (Int32 i = static_cast<Int32>(points.size()) - 2, t = k + 1u; i >= 0; --i)
+        {
+            while (k >= static_cast<UInt32>(t) && Vector2::Cross(hull[k - 1u] - hull[k - 2u], points[i] - hull[k - 2u]) <= 0.f) --k;
+            hull[k++] = points[i];
+        }
+
+        hull.resize(k - 1u);
+
+        // Drop the vertex spanning the smallest triangle until the hull fits.
+        while (hull.size() > Polygon::MaxVertices)
+        {
+            const UInt32 size = static_cast<UInt32>(hull.size());
+            UInt32 smallest = 0u;
+            float smallestArea = std::numeric_limits<float>::max();
+            for (UInt32 i = 0u; i < size; ++i)
+            {
+                const Vector2& prev = hull[(i + size - 1u) % size];
+                const Vector2& next = hull[(i + 1u) % size];
+                const float area = math::Abs(Vector2::Cross(hull[i] - prev, next - prev));
+                if (area < smallestArea)
+                {
+                    smallestArea = area;
+                    smallest = i;
+                }
+            }
+            hull.erase(hull.begin() + smallest);
+        }
+        return hull;
+    }
+
+    // Transforms b into the local space of a and checks a's face normals, four lanes at a time.
+    bool IsSeparated(
+        const float* anx, const float* any, const float* amin, const float* amax, const UInt32 aCount,
+        const float* bx, const float* by, const UInt32 bPadded,
+        const Matrix2& rotation, const Vector2& translation
+    )
+    {
+        alignas(16) float x[Polygon::MaxVertices];
+        alignas(16) float y[Polygon::MaxVertices];
+
+        const float r00 = rotation(0, 0), r01 = rotation(0, 1), r10 = rotation(1, 0), r11 = rotation(1, 1);
+        for (UInt32 j = 0u; j < bPadded; ++j)
+        {
+            x[j] = r00 * bx[j] + r01 * by[j] + translation.x;
+            y[j] = r10 * bx[j] + r11 * by[j] + translation.y;
+        }
+
+        for (UInt32 i = 0u; i < aCount; ++i)
+        {
+            const float nx = anx[i], ny = any[i];
+
+            float min0 = std::numeric_limits<float>::max(), min1 = min0, min2 = min0, min3 = min0;
+            float max0 = std::numeric_limits<float>::lowest(), max1 = max0, max2 = max0, max3 = max0;
+
+            for (UInt32 j = 0u; j < bPadded; j += 4u)
+            {
+                const float d0 = nx * x[j + 0u] + ny * y[j + 0u];
+                const float d1 = nx * x[j + 1u] + ny * y[j + 1u];
+                const float d2 = nx * x[j + 2u] + ny * y[j + 2u];
+                const float d3 = nx * x[j + 3u] + ny * y[j + 3u];
+
+                min0 = d0 < min0 ? d0 : min0; max0 = d0 > max0 ? d0 : max0;
+                min1 = d1 < min1 ? d1 : min1; max1 = d1 > max1 ? d1 : max1;
+                min2 = d2 < min2 ? d2 : min2; max2 = d2 > max2 ? d2 : max2;
+                min3 = d3 < min3 ? d3 : min3; max3 = d3 > max3 ? d3 : max3;
+            }
+
+            const float min = math::Min(math::Min(min0, min1), math::Min(min2, min3));
+            const float max = math::Max(math::Max(max0, max1), math::Max(max2, max3));
+
+            if (min > amax[i] || max < amin[i])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+
+
+    Polygon::Polygon(const std::vector<Vector2>& points, const Vector2& position, const Matrix2& rotation) :
+        Collidable(CollidableType::Polygon, position, rotation), m_count(0u), m_padded(0u)
+    {
+        SetVertices(ComputeHull(points));
+    }
+
+    Polygon Polygon::FromImage(const Image& image, const float scale, const Vector2& position, const UInt8 alphaThreshold)
+    {
+        const float halfW = image.w * 0.5f;
+        const float halfH = image.h * 0.5f;
+        const UInt8* pixels = image.GetPixelData();
+
+        Int32 alpha = -1;
+        switch (image.format)
+        {
+        case PixelFormat::RG: alpha = 1; break;
+        case PixelFormat::RGBA: alpha = 3; break;
+        default: break;
+        }
+
+        std::vector<Vector2> points;
+
+        if (alpha < 0 || pixels == nullptr)
+        {
+            points = { { -halfW, -halfH }, { halfW, -halfH }, { halfW, halfH }, { -halfW, halfH } };
+        }
+        else
+        {
+            const Int32 stride = static_cast<Int32>(image.format);
+
+            // Outermost solid pixels of each row are enough for a convex hull.
+            for (Int32 y = 0; y < image.h; ++y)
+            {
+                Int32 left = -1, right = -1;
+                for (Int32 x = 0; x < image.w; ++x)
+                {
+                    if (pixels[(x + y * image.w) * stride + alpha] >= alphaThreshold)
+                    {
+                        if (left < 0) left = x;
+                        right = x;
+                    }
+                }
+
+                if (left < 0)
+                {
+                    continue;
+                }
+
+                const float top = halfH - y;
+                const float bottom = halfH - (y + 1);
+                points.emplace_back(left - halfW, top);
+                points.emplace_back(left - halfW, bottom);
+                points.emplace_back(right + 1 - halfW, top);
+                points.emplace_back(right + 1 - halfW, bottom);
+            }
+        }
+
+        for (auto& itr : points)
+        {
+            itr *= scale;
+        }
+
+        if (points.empty())
+        {
+            Logger::Log(Logger::Priority::Warning, "Collidable: Polygon: Image has no solid pixels");
+        }
+
+        return Polygon(points, position);
+    }
+
+    void Polygon::SetVertices(const std::vector<Vector2>& hull)
+    {
+        m_count = static_cast<UInt32>(hull.size());
+        m_padded = (m_count + 3u) & ~3u;
+
+        if (m_count < 3u)
+        {
+            Logger::Log(Logger::Priority::Warning, "Collidable: Polygon: Degenerate hull with %u vertices", m_count);
+        }
+
+        for (UInt32 i = 0u; i < m_count; ++i)
+        {
+            m_x[i] = hull[i].x;
+            m_y[i] = hull[i].y;
+
+            const Vector2 edge(hull[(i + 1u) < m_count ? (i + 1u) : 0u] - hull[i]);
+            const Vector2 normal(Vector2(edge.y, -edge.x).Normalize());
+            m_normalX[i] = normal.x;
+            m_normalY[i] = normal.y;
+        }
+
+        // Padding repeats the first vertex and normal, duplicates don't change any projection.
+        for (UInt32 i = m_count; i < MaxVertices; ++i)
+        {
+            m_x[i] = m_count ? m_x[0] : 0.f;
+            m_y[i] = m_count ? m_y[0] : 0.f;
+            m_normalX[i] = m_count ? m_normalX[0] : 0.f;
+            m_normalY[i] = m_count ? m_normalY[0] : 0.f;
+        }
+
+        for (UInt32 i = 0u; i < MaxVertices; ++i)
+        {
+            float min = std::numeric_limits<float>::max();
+            float max = std::numeric_limits<float>::lowest();
+            for (UInt32 j = 0u; j < m_count; ++j)
+            {
+                const float d = m_normalX[i] * m_x[j] + m_normalY[i] * m_y[j];
+                min = math::Min(min, d);
+                max = math::Max(max, d);
+            }
+            m_min[i] = min;
+            m_max[i] = max;
+        }
+    }
+
+    bool Polygon::IsColliding(const Vector2& point) const
+    {
+        const Vector2 local(m_rotation.Transpose() * (point - m_position));
+
+        bool inside = m_count > 0u;
+        for (UInt32 i = 0u; i < m_padded; ++i)
+        {
+            inside &= (m_normalX[i] * local.x + m_normalY[i] * local.y) <= m_max[i];
+        }
+        return inside;
+    }
+
+    bool Polygon::IsColliding(const Polygon& a, const Polygon& b)
+    {
+        if (a.m_count == 0u || b.m_count == 0u)
+        {
+            return false;
+        }
+
+        const Matrix2 inverseA(a.m_rotation.Transpose());
+        const Matrix2 inverseB(b.m_rotation.Transpose());
+
+        return
+            !IsSeparated(
+                a.m_normalX, a.m_normalY, a.m_min, a.m_max, a.m_count,
+                b.m_x, b.m_y, b.m_padded,
+                inverseA * b.m_rotation, inverseA * (b.m_position - a.m_position)
+            ) &&
+            !IsSeparated(
+                b.m_normalX, b.m_normalY, b.m_min, b.m_max, b.m_count,
+                a.m_x, a.m_y, a.m_padded,
+                inverseB * a.m_rotation, inverseB * (a.m_position - b.m_position)
+            );
+    }
+
+    std::vector<Vector2> Polygon::GetVertices() const
+    {
+        std::vector<Vector2> vertices(m_count);
+        for (UInt32 i = 0u; i < m_count; ++i)
+        {
+            vertices[i] = m_position + (m_rotation * Vector2(m_x[i], m_y[i]));
+        }
+        return vertices;
+    }
+
+    void Polygon::Rotate(float deg)
+    {
+        std::vector<Vector2> vertices(m_count);
+        const Matrix2 rotation(Matrix2::Rotation(deg));
+        for (UInt32 i = 0u; i < m_count; ++i)
+        {
+            vertices[i] = rotation * Vector2(m_x[i], m_y[i]);
+        }
+        SetVertices(vertices);
+        m_rotation = Matrix2::Identity();
+    }
+
+    void Polygon::UpdateAABB()
+    {
+        const float r00 = m_rotation(0, 0), r01 = m_rotation(0, 1), r10 = m_rotation(1, 0), r11 = m_rotation(1, 1);
+
+        float minX = std::numeric_limits<float>::max(), minY = minX;
+        float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+        for (UInt32 i = 0u; i < m_padded; ++i)
+        {
+            const float x = r00 * m_x[i] + r01 * m_y[i];
+            const float y = r10 * m_x[i] + r11 * m_y[i];
+            minX = x < minX ? x : minX;
+            maxX = x > maxX ? x : maxX;
+            minY = y < minY ? y : minY;
+            maxY = y > maxY ? y : maxY;
+        }
+
+        m_aabb.min = Vector2(m_position.x + minX, m_position.y + minY);
+        m_aabb.max = Vector2(m_position.x + maxX, m_position.y + maxY);
+    }
+
 }
\ No newline at end of file
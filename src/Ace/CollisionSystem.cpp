@@ -0,0 +1,239 @@
+#include <Ace/CollisionSystem.h>
+
+#include <Ace/Collider.h>
+#include <Ace/EntityHandle.h>
+#include <Ace/EventManager.h>
+#include <Ace/Math.h>
+
+#include <algorithm> // std::sort, std::lower_bound, std::binary_search
+
+namespace ace
+{
+
+    static void SyncPose(Collidable& shape, const Vector2& offset, const Matrix4& model)
+    {
+        // Row vectors are multiplied from the left, rows 0 and 1 hold the scaled axes and row 3 the translation.
+        Vector2 axisX(model.data[0][0], model.data[0][1]);
+        Vector2 axisY(model.data[1][0], model.data[1][1]);
+
+        if (!math::IsNearEpsilon(axisX.LengthSquared()))
+        {
+            axisX = axisX.Normalize();
+        }
+        if (!math::IsNearEpsilon(axisY.LengthSquared()))
+        {
+            axisY = axisY.Normalize();
+        }
+
+        // Collidables multiply column vectors, the axes become columns.
+        const Matrix2 rotation(axisX.x, axisY.x, axisX.y, axisY.y);
+
+        shape.GetRotation() = rotation;
+        shape.GetLocalPosition() = Vector2(model.data[3][0], model.data[3][1]) + (rotation * offset);
+        shape.UpdateAABB();
+    }
+
+    static inline UInt32 GetID(const EntityHandle* entity)
+    {
+        return entity != nullptr ? entity->id : 0u;
+    }
+
+    static inline EntityManager* GetManager(const EntityHandle* entity)
+    {
+        return entity != nullptr ? entity->manager : nullptr;
+    }
+
+    template <typename ColliderType>
+    static Collidable* FindColliderOfType(EntityHandle& entity, Vector2& offset)
+    {
+        EntityManager::ComponentHandle<ColliderType>* handle = entity.GetComponentHandle<ColliderType>();
+        if (handle == nullptr)
+        {
+            return nullptr;
+        }
+
+        ColliderType& collider = handle->GetRef();
+        if (collider.version != entity.transform.version)
+        {
+            SyncPose(collider.shape, collider.offset, entity.transform.model);
+            collider.version = entity.transform.version;
+        }
+
+        offset = collider.offset;
+        return &collider.shape;
+    }
+
+    Collidable* CollisionSystem::FindCollider(EntityHandle& entity, Vector2& offset)
+    {
+        Collidable* shape = FindColliderOfType<CircleCollider>(entity, offset);
+        if (shape == nullptr)
+        {
+            shape = FindColliderOfType<BoxCollider>(entity, offset);
+        }
+        if (shape == nullptr)
+        {
+            shape = FindColliderOfType<PolygonCollider>(entity, offset);
+        }
+        return shape;
+    }
+
+    bool CollisionSystem::Resolve(const UInt32 id, const void* handle, EntityManager* manager, EntityHandle*& entity) const
+    {
+        if (id == 0u)
+        {
+            entity = nullptr;
+            return std::binary_search(m_collidables.begin(), m_collidables.end(), static_cast<const Collidable*>(handle));
+        }
+
+        entity = EntityManager::FindEntity(id, *manager);
+        return entity != nullptr;
+    }
+
+    template <typename ColliderType>
+    void CollisionSystem::Gather()
+    {
+        EntityManager::ComponentPool<ColliderType>& pool = EntityManager::ComponentPool<ColliderType>::GetPool();
+
+        const UInt32 size = static_cast<UInt32>(pool.m_components.size());
+        for (UInt32 i = 0u; i < size; ++i)
+        {
+            ColliderType& collider = pool.m_components[i];
+            EntityHandle* entity = pool.m_handles[i]->entity;
+
+            if (collider.version != entity->transform.version)
+            {
+                SyncPose(collider.shape, collider.offset, entity->transform.model);
+                collider.version = entity->transform.version;
+            }
+
+            m_proxies.push_back({ &collider.shape, pool.m_handles[i], entity });
+        }
+    }
+
+    CollisionSystem& CollisionSystem::GetInstance()
+    {
+        static CollisionSystem s_system;
+        return s_system;
+    }
+
+    CollisionSystem::CollisionSystem() :
+        m_broadPhase(),
+        m_collidables(),
+        m_proxies(),
+        m_contacts(),
+        m_previous()
+    {
+
+    }
+
+    CollisionSystem::~CollisionSystem()
+    {
+
+    }
+
+    void CollisionSystem::Add(Collidable& collidable)
+    {
+        std::vector<Collidable*>& collidables = GetInstance().m_collidables;
+
+        auto itr = std::lower_bound(collidables.begin(), collidables.end(), &collidable);
+        if (itr == collidables.end() || *itr != &collidable)
+        {
+            collidables.insert(itr, &collidable);
+        }
+    }
+
+    void CollisionSystem::Remove(Collidable& collidable)
+    {
+        std::vector<Collidable*>& collidables = GetInstance().m_collidables;
+
+        auto itr = std::lower_bound(collidables.begin(), collidables.end(), &collidable);
+        if (itr != collidables.end() && *itr == &collidable)
+        {
+            collidables.erase(itr);
+        }
+    }
+
+    void CollisionSystem::Update()
+    {
+        CollisionSystem& system = GetInstance();
+
+        system.m_proxies.clear();
+
+        system.Gather<CircleCollider>();
+        system.Gather<BoxCollider>();
+        system.Gather<PolygonCollider>();
+
+        for (const auto itr : system.m_collidables)
+        {
+            system.m_proxies.push_back({ itr, itr, nullptr });
+        }
+
+        // Pools may have reallocated since the last frame, rebuild the proxy list.
+        // Broad-phase proxies are numbered from 0 after Clear, matching the indices of m_proxies.
+        system.m_broadPhase.Clear();
+        for (auto& itr : system.m_proxies)
+        {
+            // Components were synced by Gather.
+            system.m_broadPhase.Add(*itr.collidable, itr.entity == nullptr && itr.collidable->IsAwake());
+        }
+
+        std::swap(system.m_contacts, system.m_previous);
+        system.m_contacts.clear();
+
+        for (const auto& pair : system.m_broadPhase.Update(false))
+        {
+            const Proxy* a = &system.m_proxies[pair.proxyA];
+            const Proxy* b = &system.m_proxies[pair.proxyB];
+
+            if ((a->entity != nullptr && a->entity == b->entity) || !Collidable::IsColliding(*pair.a, *pair.b))
+            {
+                continue;
+            }
+
+            // Ordered by entity id first, a handle address may be reused by a component of another entity.
+            if (GetID(b->entity) < GetID(a->entity) || (GetID(b->entity) == GetID(a->entity) && b->handle < a->handle))
+            {
+                std::swap(a, b);
+            }
+
+            system.m_contacts.push_back({
+                GetID(a->entity), GetID(b->entity), a->handle, b->handle, GetManager(a->entity), GetManager(b->entity),
+                a->entity, b->entity, a->collidable, b->collidable
+            });
+        }
+
+        std::sort(system.m_contacts.begin(), system.m_contacts.end());
+
+        // Both lists are sorted, a single merge yields Begin, Stay and End.
+        auto current = system.m_contacts.begin();
+        auto previous = system.m_previous.begin();
+
+        while (current != system.m_contacts.end() || previous != system.m_previous.end())
+        {
+            if (previous == system.m_previous.end() || (current != system.m_contacts.end() && *current < *previous))
+            {
+                EventManager<ContactEvent>::Broadcast({ ContactEventType::Begin, current->a, current->b, current->colliderA, current->colliderB });
+                ++current;
+            }
+            else if (current == system.m_contacts.end() || *previous < *current)
+            {
+                // Cached pointers may dangle, skip the event if either side is gone.
+                EntityHandle* a = nullptr;
+                EntityHandle* b = nullptr;
+                if (system.Resolve(previous->idA, previous->handleA, previous->managerA, a) &&
+                    system.Resolve(previous->idB, previous->handleB, previous->managerB, b))
+                {
+                    EventManager<ContactEvent>::Broadcast({ ContactEventType::End, a, b, nullptr, nullptr });
+                }
+                ++previous;
+            }
+            else
+            {
+                EventManager<ContactEvent>::Broadcast({ ContactEventType::Stay, current->a, current->b, current->colliderA, current->colliderB });
+                ++current;
+                ++previous;
+            }
+        }
+    }
+
+}
@@ -1,4 +1,5 @@
 #include <Ace/Drawable.h>
+#include <Ace/AssetCache.h>
 #include <Ace/GraphicsDevice.h>
 
 #include <Ace/Log.h>
@@ -6,6 +7,7 @@
 #include <Ace/Math.h>
 
 #include <tmxlite/Map.hpp>
+#include <tmxlite/ObjectGroup.hpp>
 #include <tmxlite/TileLayer.hpp>
 
 #include <cstdio>
@@ -22,7 +24,11 @@ namespace ace
 
         std::vector<TileLayer> layers;
 
-        TiledImpl(const Path file) : isMapLoaded(true)
+        TileGrid collision;
+        float scale;
+        Vector3 pivot;
+
+        TiledImpl(const Path file) : isMapLoaded(true), collision(), scale(1.f), pivot()
         {
             if (!map.load(file))
             {
@@ -44,12 +50,15 @@ namespace ace
                 {
                     char nameBuffer[8];
 
-                    sheet = SpriteSheet(Image(File(path)));
-                    sheet.AddSprite("NULL", Rect(0, 0, 0, 0)); // Null Sprite
+                    sheet = SpriteSheet(*AssetCache::Get<Image>(path));
 
                     tilesetSize = Vector2(map.getTilesets()[0].getTileSize().x, map.getTilesets()[0].getTileSize().y);
 
                     UInt32 col = map.getTilesets()[0].getColumnCount(), row = map.getTilesets()[0].getTileCount() / col;
+
+                    // Names are the tile IDs, at most 7 digits with the buffer below.
+                    sheet.Reserve(col * row + 1u, (col * row + 1u) * 7u);
+                    sheet.AddSprite("NULL", Rect(0, 0, 0, 0)); // Null Sprite
                     Rect location(0, 0, tilesetSize.x, tilesetSize.y);
 
                     for (Int32 y = 0; y < row; ++y)
@@ -64,7 +73,7 @@ namespace ace
                         }
                     }
 
-                    return Texture(sheet.image);
+                    return *AssetCache::Get<Texture>(path);
                 }
 
             }
@@ -191,12 +200,94 @@ namespace ace
                 layers.push_back(layer);
             }
         }
+
+        static bool IsCollisionLayer(const tmx::Layer& layer)
+        {
+            for (const auto& property : layer.getProperties())
+            {
+                if (property.getName() == "collision" && property.getType() == tmx::Property::Type::Boolean)
+                {
+                    return property.getBoolValue();
+                }
+            }
+            return false;
+        }
+
+        // Cells match the sprites placed by CreateLayers, grid row 0 is the bottom row of the map.
+        void ResetCollision()
+        {
+            const UInt32 col = map.getTileCount().x, row = map.getTileCount().y;
+            const Vector2 origin((-0.5f - col * pivot.x) * scale, (0.5f - row * pivot.y) * scale);
+            collision.Reset(col, row, origin, scale);
+        }
+
+        void AddCollision(const tmx::Layer& layer)
+        {
+            const Int32 col = map.getTileCount().x, row = map.getTileCount().y;
+
+            if (layer.getType() == tmx::Layer::Type::Tile)
+            {
+                const auto& tiles = static_cast<const tmx::TileLayer&>(layer).getTiles();
+                for (Int32 y = 0; y < row; ++y)
+                {
+                    for (Int32 x = 0; x < col; ++x)
+                    {
+                        if (tiles[x + y * col].ID != 0)
+                        {
+                            collision.SetSolid(x, row - 1 - y, true);
+                        }
+                    }
+                }
+            }
+            else if (layer.getType() == tmx::Layer::Type::Object)
+            {
+                const float tileW = static_cast<float>(map.getTileSize().x);
+                const float tileH = static_cast<float>(map.getTileSize().y);
+
+                for (const auto& object : static_cast<const tmx::ObjectGroup&>(layer).getObjects())
+                {
+                    const tmx::FloatRect& bounds = object.getAABB();
+                    const Int32 x0 = static_cast<Int32>(math::Floor(bounds.left / tileW));
+                    const Int32 x1 = static_cast<Int32>(math::Ceil((bounds.left + bounds.width) / tileW));
+                    const Int32 y0 = static_cast<Int32>(math::Floor(bounds.top / tileH));
+                    const Int32 y1 = static_cast<Int32>(math::Ceil((bounds.top + bounds.height) / tileH));
+
+                    for (Int32 y = y0; y < y1; ++y)
+                    {
+                        for (Int32 x = x0; x < x1; ++x)
+                        {
+                            collision.SetSolid(x, row - 1 - y, true);
+                        }
+                    }
+                }
+            }
+        }
+
+        void CreateCollision()
+        {
+            if (!isMapLoaded || map.getOrientation() != tmx::Orientation::Orthogonal)
+            {
+                return;
+            }
+
+            ResetCollision();
+            for (const auto& layer : map.getLayers())
+            {
+                if (IsCollisionLayer(*layer))
+                {
+                    AddCollision(*layer);
+                }
+            }
+        }
     };
 
     Tilemap::Tilemap(const Path& map, float scale, const Vector3& pivot, ReadTilemap callback, void* arg) : Drawable(), m_tiledImpl(new TiledImpl(map))
     {
         tileset = m_tiledImpl->GetTileset();
+        m_tiledImpl->scale = scale;
+        m_tiledImpl->pivot = pivot;
         m_tiledImpl->CreateLayers(scale, pivot, callback, arg);
+        m_tiledImpl->CreateCollision();
     }
 
     Tilemap::~Tilemap()
@@ -229,6 +320,38 @@ namespace ace
         return m_tiledImpl->sheet;
     }
 
+    bool Tilemap::BuildCollisionGrid(const std::string& layer)
+    {
+        if (!m_tiledImpl->isMapLoaded)
+        {
+            return false;
+        }
+
+        if (m_tiledImpl->map.getOrientation() != tmx::Orientation::Orthogonal)
+        {
+            Logger::LogError("Tilemap: Collision grid requires an orthogonal map");
+            return false;
+        }
+
+        for (const auto& itr : m_tiledImpl->map.getLayers())
+        {
+            if (itr->getName() == layer)
+            {
+                m_tiledImpl->ResetCollision();
+                m_tiledImpl->AddCollision(*itr);
+                return true;
+            }
+        }
+
+        Logger::LogError("Tilemap: Collision layer not found: %s", layer.c_str());
+        return false;
+    }
+
+    const TileGrid& Tilemap::GetCollisionGrid() const
+    {
+        return m_tiledImpl->collision;
+    }
+
     void Tilemap::Draw() const
     {
         for (Int32 i = 0; i < LayersCount(); ++i)
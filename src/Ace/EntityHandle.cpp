@@ -52,9 +52,12 @@ namespace ace
     }
 
 
+    static UInt32 s_lastID = 0u;
+
     EntityManager::EntityHandle::EntityHandle(EntityManager* manager) :
         transform(),
         manager(manager),
+        id(++s_lastID),
         m_children(),
         m_first(nullptr),
         m_last(nullptr),
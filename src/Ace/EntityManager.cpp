@@ -1,5 +1,8 @@
 #include <Ace/EntityManager.h>
 #include <Ace/EntityHandle.h>
+#include <Ace/Profiler.h>
+
+#include <algorithm> // std::lower_bound
 
 namespace ace
 {
@@ -22,6 +25,16 @@ namespace ace
         return manager.CreateEntity();
     }
 
+    EntityManager::EntityHandle* EntityManager::FindEntity(const UInt32 id, EntityManager& manager)
+    {
+        // Entities are appended on creation and erased in place, so they stay sorted by id.
+        auto itr = std::lower_bound(manager.m_entities.begin(), manager.m_entities.end(), id, [](const EntityHandle* entity, const UInt32 value)
+        {
+            return entity->id < value;
+        });
+        return (itr != manager.m_entities.end() && (*itr)->id == id) ? *itr : nullptr;
+    }
+
     void EntityManager::DestroyEntity(EntityManager::EntityHandle* entity, EntityManager& manager)
     {
         if (entity == nullptr || entity->manager != &manager)
@@ -65,6 +78,7 @@ namespace ace
 
 	void EntityManager::Update()
 	{
+		ACE_PROFILE_SCOPE("EntityManager::Update");
 		for (UInt32 i = 0; i < m_componentPools.size(); ++i)
 		{
 			m_componentPools[i]->Update();
@@ -6,6 +6,132 @@
 namespace ace
 {
 
+    static bool s_rawMotion = false;
+
+    static MouseState s_mouse;
+    static TouchState s_touch;
+
+    // Motion coalesced since the last event of its device it must stay ordered with.
+    static bool s_hasMouseMotion = false;
+    static MouseEvent s_mouseMotion;
+    static UInt32 s_touchMotionCount = 0u;
+    static TouchEvent s_touchMotion[MaxTouchFingers];
+
+    static const UInt32 AccelerometerAxes = 3u;
+    static bool s_hasAxis[AccelerometerAxes];
+    static Int16 s_axis[AccelerometerAxes];
+
+    static void FlushMouseMotion()
+    {
+        if (s_hasMouseMotion)
+        {
+            EventManager<MouseEvent>::Enqueue(s_mouseMotion, EventPhase::Input);
+            s_hasMouseMotion = false;
+        }
+    }
+
+    static void FlushTouchMotion()
+    {
+        for (UInt32 i = 0u; i < s_touchMotionCount; ++i)
+        {
+            EventManager<TouchEvent>::Enqueue(s_touchMotion[i], EventPhase::Input);
+        }
+        s_touchMotionCount = 0u;
+    }
+
+    static void FlushAxes()
+    {
+        for (UInt8 axis = 0u; axis < AccelerometerAxes; ++axis)
+        {
+            if (s_hasAxis[axis])
+            {
+                EventManager<AccelerometerEvent>::Enqueue({ axis, s_axis[axis] }, EventPhase::Input);
+                s_hasAxis[axis] = false;
+            }
+        }
+    }
+
+    static void CoalesceMouseMotion(const MouseEvent& mouseEvent)
+    {
+        if (s_hasMouseMotion && s_mouseMotion.which == mouseEvent.which)
+        {
+            s_mouseMotion.position = mouseEvent.position;
+            s_mouseMotion.Motion.state = mouseEvent.Motion.state;
+            s_mouseMotion.Motion.xrel += mouseEvent.Motion.xrel;
+            s_mouseMotion.Motion.yrel += mouseEvent.Motion.yrel;
+            return;
+        }
+
+        FlushMouseMotion();
+        s_mouseMotion = mouseEvent;
+        s_hasMouseMotion = true;
+    }
+
+    static void CoalesceTouchMotion(const TouchEvent& touchEvent)
+    {
+        for (UInt32 i = 0u; i < s_touchMotionCount; ++i)
+        {
+            TouchEvent& pending = s_touchMotion[i];
+            if (pending.fingerID == touchEvent.fingerID)
+            {
+                pending.position = touchEvent.position;
+                pending.direction += touchEvent.direction;
+                pending.pressure = touchEvent.pressure;
+                return;
+            }
+        }
+
+        if (s_touchMotionCount == MaxTouchFingers)
+        {
+            FlushTouchMotion();
+        }
+        s_touchMotion[s_touchMotionCount++] = touchEvent;
+    }
+
+    static TouchState::Finger* FindFinger(UInt32 fingerID)
+    {
+        for (UInt32 i = 0u; i < s_touch.count; ++i)
+        {
+            if (s_touch.fingers[i].fingerID == fingerID)
+            {
+                return &s_touch.fingers[i];
+            }
+        }
+        return nullptr;
+    }
+
+    static void UpdateTouchState(const TouchEvent& touchEvent)
+    {
+        TouchState::Finger* finger = FindFinger(touchEvent.fingerID);
+
+        if (touchEvent.type == TouchEventType::Released)
+        {
+            if (finger != nullptr)
+            {
+                *finger = s_touch.fingers[--s_touch.count];
+            }
+            return;
+        }
+
+        if (finger == nullptr)
+        {
+            if (s_touch.count == MaxTouchFingers)
+            {
+                return;
+            }
+            finger = &s_touch.fingers[s_touch.count++];
+            finger->fingerID = touchEvent.fingerID;
+            finger->delta = Vector2(0.f, 0.f);
+        }
+
+        finger->position = touchEvent.position;
+        finger->pressure = touchEvent.pressure;
+        if (touchEvent.type == TouchEventType::Motion)
+        {
+            finger->delta += touchEvent.direction;
+        }
+    }
+
     Event& Event::GetEvent()
     {
         static Event s_event;
@@ -17,90 +143,173 @@ namespace ace
 
     }
 
+    void Event::SetRawMotion(bool raw)
+    {
+        s_rawMotion = raw;
+    }
+
+    const MouseState& Event::GetMouseState()
+    {
+        return s_mouse;
+    }
+
+    const TouchState& Event::GetTouchState()
+    {
+        return s_touch;
+    }
+
     void Event::Update()
     {
+        s_mouse.delta = Vector2(0.f, 0.f);
+        s_mouse.wheel = 0.f;
+        s_mouse.samples = 0u;
+        for (UInt32 i = 0u; i < s_touch.count; ++i)
+        {
+            s_touch.fingers[i].delta = Vector2(0.f, 0.f);
+        }
+
         SDL_Event event;
         while (SDL_PollEvent(&event) != 0)
         {
-			UInt32 i = event.type;
-
-			MouseEvent mouseEvent;
-
-			switch (i)
-			{
-			case SDL_MOUSEMOTION: 
-
-				mouseEvent.type = MouseEventType::Motion;
-				mouseEvent.which = event.motion.which;
-				mouseEvent.position.x = event.motion.x;
-				mouseEvent.position.y = event.motion.y;
-
-				mouseEvent.Motion.state = event.motion.state;
-				mouseEvent.Motion.xrel = event.motion.xrel;
-				mouseEvent.Motion.yrel = event.motion.yrel;
-				break;
-
-			case SDL_MOUSEBUTTONUP:
-			case SDL_MOUSEBUTTONDOWN:
-
-				mouseEvent.type = i == SDL_MOUSEBUTTONDOWN ? MouseEventType::Pressed : MouseEventType::Released;
-				mouseEvent.which = event.button.which;
-				mouseEvent.position.x = event.button.x;
-				mouseEvent.position.y = event.button.y;
-
-				mouseEvent.Button.button = event.button.button;
-				mouseEvent.Button.state = event.button.state;
-				mouseEvent.Button.clicks = event.button.clicks;
-				break;
-
-			case SDL_MOUSEWHEEL:
-
-				mouseEvent.type = MouseEventType::Wheel;
-				mouseEvent.which = event.wheel.which;
-				mouseEvent.position.x = event.wheel.x;
-				mouseEvent.position.y = event.wheel.y;
-
-				mouseEvent.Wheel.scroll = event.wheel.direction;
-				break;
-
-			case SDL_WINDOWEVENT:
-				EventManager<WindowEvent>::Broadcast({ static_cast<WindowEventType>(event.window.event), event.window.data1, event.window.data2 });
-				break;
-
-
-			case SDL_FINGERMOTION:
-				EventManager<TouchEvent>::Broadcast({ TouchEventType::Motion, static_cast<UInt8>(event.tfinger.fingerId), { event.tfinger.x, event.tfinger.y }, { event.tfinger.dx, event.tfinger.dy }, event.tfinger.pressure });
-				break;
-
-			case SDL_FINGERDOWN:
-			case SDL_FINGERUP:
-				EventManager<TouchEvent>::Broadcast({ i == SDL_FINGERDOWN ? TouchEventType::Pressed : TouchEventType::Released, static_cast<UInt8>(event.tfinger.fingerId), Vector2(event.tfinger.x, event.tfinger.y), Vector2( event.tfinger.dx, event.tfinger.dy), event.tfinger.pressure
-			});
-				break;
-
-			case SDL_JOYAXISMOTION:
-			{
-				if (event.jaxis.which != Accelerometer::GetID())
-				{
-					break;
-				}
-				EventManager<AccelerometerEvent>::Broadcast({ event.jaxis.axis, event.jaxis.value });
-			}
-			break;
-			}
-
-			switch (i)
-			{
-			case SDL_MOUSEWHEEL:
-			case SDL_MOUSEMOTION:
-			case SDL_MOUSEBUTTONUP:
-			case SDL_MOUSEBUTTONDOWN:
-				EventManager<MouseEvent>::Broadcast(mouseEvent);
-				break;
-			}
-
-
-            EventManager<Event::SDLEventArg>::Broadcast({ event });
+            const UInt32 i = event.type;
+
+            switch (i)
+            {
+            case SDL_MOUSEMOTION:
+            {
+                MouseEvent mouseEvent;
+                mouseEvent.type = MouseEventType::Motion;
+                mouseEvent.which = event.motion.which;
+                mouseEvent.position.x = static_cast<float>(event.motion.x);
+                mouseEvent.position.y = static_cast<float>(event.motion.y);
+
+                mouseEvent.Motion.state = static_cast<UInt8>(event.motion.state);
+                mouseEvent.Motion.xrel = static_cast<float>(event.motion.xrel);
+                mouseEvent.Motion.yrel = static_cast<float>(event.motion.yrel);
+
+                s_mouse.position = mouseEvent.position;
+                s_mouse.delta += Vector2(mouseEvent.Motion.xrel, mouseEvent.Motion.yrel);
+                s_mouse.buttons = event.motion.state;
+                ++s_mouse.samples;
+
+                if (s_rawMotion)
+                {
+                    EventManager<MouseEvent>::Enqueue(mouseEvent, EventPhase::Input);
+                }
+                else
+                {
+                    CoalesceMouseMotion(mouseEvent);
+                }
+            }
+            break;
+
+            case SDL_MOUSEBUTTONUP:
+            case SDL_MOUSEBUTTONDOWN:
+            {
+                MouseEvent mouseEvent;
+                mouseEvent.type = i == SDL_MOUSEBUTTONDOWN ? MouseEventType::Pressed : MouseEventType::Released;
+                mouseEvent.which = event.button.which;
+                mouseEvent.position.x = static_cast<float>(event.button.x);
+                mouseEvent.position.y = static_cast<float>(event.button.y);
+
+                mouseEvent.Button.button = event.button.button;
+                mouseEvent.Button.state = event.button.state;
+                mouseEvent.Button.clicks = event.button.clicks;
+
+                s_mouse.position = mouseEvent.position;
+                s_mouse.buttons = i == SDL_MOUSEBUTTONDOWN ?
+                    s_mouse.buttons | SDL_BUTTON(event.button.button) :
+                    s_mouse.buttons & ~SDL_BUTTON(event.button.button);
+
+                // Motion before the press is delivered before it.
+                FlushMouseMotion();
+                EventManager<MouseEvent>::Enqueue(mouseEvent, EventPhase::Input);
+            }
+            break;
+
+            case SDL_MOUSEWHEEL:
+            {
+                MouseEvent mouseEvent;
+                mouseEvent.type = MouseEventType::Wheel;
+                mouseEvent.which = event.wheel.which;
+                mouseEvent.position.x = static_cast<float>(event.wheel.x);
+                mouseEvent.position.y = static_cast<float>(event.wheel.y);
+
+                mouseEvent.Wheel.scroll = event.wheel.direction;
+
+                s_mouse.wheel += static_cast<float>(event.wheel.y);
+
+                FlushMouseMotion();
+                EventManager<MouseEvent>::Enqueue(mouseEvent, EventPhase::Input);
+            }
+            break;
+
+            case SDL_WINDOWEVENT:
+                EventManager<WindowEvent>::Enqueue({ static_cast<WindowEventType>(event.window.event), event.window.data1, event.window.data2 }, EventPhase::Input);
+                break;
+
+            case SDL_FINGERMOTION:
+            {
+                const TouchEvent touchEvent = { TouchEventType::Motion, static_cast<UInt8>(event.tfinger.fingerId), { event.tfinger.x, event.tfinger.y }, { event.tfinger.dx, event.tfinger.dy }, event.tfinger.pressure };
+                UpdateTouchState(touchEvent);
+
+                if (s_rawMotion)
+                {
+                    EventManager<TouchEvent>::Enqueue(touchEvent, EventPhase::Input);
+                }
+                else
+                {
+                    CoalesceTouchMotion(touchEvent);
+                }
+            }
+            break;
+
+            case SDL_FINGERDOWN:
+            case SDL_FINGERUP:
+            {
+                const TouchEvent touchEvent = { i == SDL_FINGERDOWN ? TouchEventType::Pressed : TouchEventType::Released, static_cast<UInt8>(event.tfinger.fingerId), Vector2(event.tfinger.x, event.tfinger.y), Vector2(event.tfinger.dx, event.tfinger.dy), event.tfinger.pressure };
+                UpdateTouchState(touchEvent);
+
+                FlushTouchMotion();
+                EventManager<TouchEvent>::Enqueue(touchEvent, EventPhase::Input);
+            }
+            break;
+
+            case SDL_JOYAXISMOTION:
+            {
+                if (event.jaxis.which != static_cast<SDL_JoystickID>(Accelerometer::GetID()))
+                {
+                    break;
+                }
+
+                // The axes have no other events to stay ordered with, only their last value is kept.
+                if (s_rawMotion || event.jaxis.axis >= AccelerometerAxes)
+                {
+                    EventManager<AccelerometerEvent>::Enqueue({ event.jaxis.axis, event.jaxis.value }, EventPhase::Input);
+                }
+                else
+                {
+                    s_hasAxis[event.jaxis.axis] = true;
+                    s_axis[event.jaxis.axis] = event.jaxis.value;
+                }
+            }
+            break;
+            }
+
+            // The UI has no use for motion, it reads the mouse state itself.
+            // Gamepad axes are still forwarded, only the accelerometer is high rate.
+            const bool isAccelerometer = i == SDL_JOYAXISMOTION && event.jaxis.which == static_cast<SDL_JoystickID>(Accelerometer::GetID());
+            if (s_rawMotion || (i != SDL_MOUSEMOTION && i != SDL_FINGERMOTION && !isAccelerometer))
+            {
+                EventManager<Event::SDLEventArg>::Enqueue({ event }, EventPhase::Input);
+            }
         }
+
+        FlushMouseMotion();
+        FlushTouchMotion();
+        FlushAxes();
+
+        // Each type is delivered as one batch, listeners may subscribe and unsubscribe meanwhile.
+        EventDispatcher::Dispatch(EventPhase::Input);
     }
 }
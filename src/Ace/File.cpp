@@ -1,8 +1,17 @@
 #include <Ace/File.h>
+#include <Ace/Archive.h>
 #include <Ace/Log.h>
+#include <Ace/Platform.h>
 
 #include <SDL_rwops.h>
 
+#if ACE_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 namespace ace
 {
@@ -10,9 +19,25 @@ namespace ace
 	{
 		SDL_RWops* rwops;
 
+		// Set when the file was found in a mounted archive.
+		View archived;
+
 		//FileImpl constructor
-		FileImpl(const char* path, const char* mode) : rwops(SDL_RWFromFile(path, mode))
+		FileImpl(const char* path, const char* mode) : rwops(nullptr), archived()
 		{
+			// Archives are read-only, other modes always go to the file system.
+			if (Archive::GetMountCount() > 0u && (SDL_strcmp(mode, "r") == 0 || SDL_strcmp(mode, "rb") == 0))
+			{
+				archived = Archive::Find(path);
+				if (archived)
+				{
+					rwops = SDL_RWFromConstMem(archived.Get(), archived.size);
+					return;
+				}
+			}
+
+			rwops = SDL_RWFromFile(path, mode);
+
 			//	TODO: Error handler loggerilla
 			// Warning: if nullptr
 			if (rwops == NULL)
@@ -33,6 +58,11 @@ namespace ace
 
 	bool File::Exists(const Path& path)
 	{
+		if (Archive::GetMountCount() > 0u && Archive::Contains(path.GetPath()))
+		{
+			return true;
+		}
+
 		SDL_RWops* file = SDL_RWFromFile(path.GetPath().c_str(), "r");
 		
 		if (file != nullptr)
@@ -74,7 +104,65 @@ namespace ace
 		UInt8* buffer = new UInt8[size + 1];
 		SDL_RWread(m_fileImpl->rwops, buffer, size, 1);
 		buffer[size] = '\0';
-		return std::shared_ptr<UInt8>(buffer);
+		return std::shared_ptr<UInt8>(buffer, std::default_delete<UInt8[]>());
+	}
+
+	File::View::View() : data(), size(0u), isMapped(false)
+	{
+
+	}
+
+	File::View File::Map() const
+	{
+		View view;
+
+		if (m_fileImpl->archived)
+		{
+			return m_fileImpl->archived;
+		}
+
+#if ACE_LINUX
+		const int fd = open(path.GetPath().c_str(), O_RDONLY);
+		struct stat info;
+
+		if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0)
+		{
+			const size_t length = static_cast<size_t>(info.st_size);
+			void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if (address != MAP_FAILED)
+			{
+				// Whole file is read by the loaders, start paging it in now.
+				madvise(address, length, MADV_SEQUENTIAL | MADV_WILLNEED);
+
+				view.data = std::shared_ptr<const UInt8>(static_cast<const UInt8*>(address), [length](const UInt8* data)
+				{
+					munmap(const_cast<UInt8*>(data), length);
+				});
+				view.size = static_cast<UInt32>(length);
+				view.isMapped = true;
+			}
+		}
+
+		if (fd >= 0)
+		{
+			// The mapping keeps its own reference to the file.
+			close(fd);
+		}
+
+		if (view.isMapped)
+		{
+			return view;
+		}
+#endif
+
+		if (*this)
+		{
+			SDL_RWseek(m_fileImpl->rwops, 0, RW_SEEK_SET);
+			view.size = Size();
+			view.data = ReadAll();
+		}
+		return view;
 	}
 
 	std::shared_ptr<char> File::ReadAllText() const
@@ -83,7 +171,7 @@ namespace ace
 		char* buffer = new char[size + 1];
 		SDL_RWread(m_fileImpl->rwops, buffer, size, 1);
 		buffer[size] = '\0';
-		return std::shared_ptr<char>(buffer);
+		return std::shared_ptr<char>(buffer, std::default_delete<char[]>());
 	}
 
 	//Writing to end of a file
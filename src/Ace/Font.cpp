@@ -5,6 +5,10 @@
 #include <Ace/GraphicsDevice.h>
 #include <Ace/Math.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ace
 {
 	void CreateGlyphs(std::vector<Glyph>& glyphs, stbtt_bakedchar* cdata, UInt32 size, UInt32 first)
@@ -29,6 +33,76 @@ namespace ace
 		}
 	}
 
+	// Distance fields are computed at this many times the output resolution.
+	static const Int32 SDFOversampling = 4;
+
+	// Squared euclidean distance transform of one row or column, Felzenszwalb & Huttenlocher.
+	static void DistanceTransform(const float* f, float* d, Int32* v, float* z, Int32 n)
+	{
+		static const float Infinity = std::numeric_limits<float>::infinity();
+
+		Int32 k = 0;
+		v[0] = 0;
+		z[0] = -Infinity;
+		z[1] = Infinity;
+
+		for (Int32 q = 1; q < n; ++q)
+		{
+			float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+			while (s <= z[k])
+			{
+				--k;
+				s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+			}
+			++k;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = Infinity;
+		}
+
+		k = 0;
+		for (Int32 q = 0; q < n; ++q)
+		{
+			while (z[k + 1] < q)
+			{
+				++k;
+			}
+			d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+		}
+	}
+
+	// Distance of every pixel to the nearest feature pixel, in place.
+	static void DistanceTransform(std::vector<float>& grid, Int32 w, Int32 h)
+	{
+		const Int32 n = std::max(w, h);
+		std::vector<float> f(n), d(n), z(n + 1);
+		std::vector<Int32> v(n);
+
+		for (Int32 x = 0; x < w; ++x)
+		{
+			for (Int32 y = 0; y < h; ++y)
+			{
+				f[y] = grid[y * w + x];
+			}
+			DistanceTransform(f.data(), d.data(), v.data(), z.data(), h);
+			for (Int32 y = 0; y < h; ++y)
+			{
+				grid[y * w + x] = d[y];
+			}
+		}
+
+		for (Int32 y = 0; y < h; ++y)
+		{
+			DistanceTransform(&grid[y * w], d.data(), v.data(), z.data(), w);
+			std::copy(d.begin(), d.begin() + w, grid.begin() + y * w);
+		}
+
+		for (auto& value : grid)
+		{
+			value = std::sqrt(value);
+		}
+	}
+
 	struct Font::FontInfo
 	{
 		stbtt_fontinfo font;
@@ -38,12 +112,10 @@ namespace ace
 		m_info(std::make_shared<Font::FontInfo>()) //Eetu "muutti" rivin t.Vepe
 	{
 		//Font is placed inside buffer
-		m_buffer = p_file.ReadAll();
-
-		m_bufferSize = p_file.Size();
+		m_buffer = p_file.Map();
 
 		//Loads font file from a memory buffer
-		stbtt_InitFont(&m_info->font, m_buffer.get(), stbtt_GetFontOffsetForIndex(m_buffer.get(), 0));
+		stbtt_InitFont(&m_info->font, m_buffer.Get(), stbtt_GetFontOffsetForIndex(m_buffer.Get(), 0));
 
 	}
 
@@ -63,7 +135,7 @@ namespace ace
 		Int32 nW = 0, nH = 0;
 
 		//-- bake a font to a bitmap for use as texture
-		stbtt_BakeFontBitmap(m_buffer.get(), 0, pixelheight, bitmap, w, h, first_char, num_chars, cdata);
+		stbtt_BakeFontBitmap(m_buffer.Get(), 0, pixelheight, bitmap, w, h, first_char, num_chars, cdata);
 
 		//Saves image size
 		m_w = w;
@@ -265,7 +337,9 @@ namespace ace
 			return;
 		}
 
-		Vertex* vertex = new Vertex[6 * len];
+		// Reuses the previous allocation, skipped characters stay as degenerate triangles.
+		m_vertices.assign(6 * len, Vertex());
+		Vertex* vertex = m_vertices.data();
 
 		for (UInt32 i = 0u; i < len; ++i)
 		{
@@ -344,21 +418,196 @@ namespace ace
 		}
 
 		GraphicsDevice::BufferData(buffer, len * 6, vertex);
-		delete[] vertex;
 	}
 
+	bool Font::RasterizeGlyph(UInt32 codepoint, float pixelHeight, std::vector<UInt8>& pixels, Glyph& glyph) const
+	{
+		const stbtt_fontinfo* font = &m_info->font;
+		const float scale = stbtt_ScaleForPixelHeight(font, pixelHeight);
+		const Int32 index = stbtt_FindGlyphIndex(font, codepoint);
+
+		Int32 x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+		stbtt_GetGlyphBitmapBox(font, index, scale, scale, &x0, &y0, &x1, &y1);
+
+		Int32 advance = 0;
+		stbtt_GetGlyphHMetrics(font, index, &advance, nullptr);
+
+		glyph.x = 0u;
+		glyph.y = 0u;
+		glyph.w = static_cast<UInt16>(x1 - x0);
+		glyph.h = static_cast<UInt16>(y1 - y0);
+		glyph.xoff = static_cast<float>(x0);
+		glyph.yoff = static_cast<float>(y0);
+		glyph.xadvance = advance * scale;
+
+		pixels.resize(glyph.w * glyph.h);
+		if (!pixels.empty())
+		{
+			stbtt_MakeGlyphBitmap(font, pixels.data(), glyph.w, glyph.h, glyph.w, scale, scale, index);
+		}
+		return index != 0;
+	}
+
+	bool Font::RasterizeGlyphSDF(UInt32 codepoint, float pixelHeight, UInt32 spread, std::vector<UInt8>& pixels, Glyph& glyph) const
+	{
+		// Large but finite, keeps the parabola intersections free of inf - inf.
+		static const float Infinity = 1e20f;
+		static const Int32 K = SDFOversampling;
+
+		const stbtt_fontinfo* font = &m_info->font;
+		const float scale = stbtt_ScaleForPixelHeight(font, pixelHeight);
+		const Int32 index = stbtt_FindGlyphIndex(font, codepoint);
 
-	const UInt8* Font::GetBuffer(UInt32& size) const
+		Int32 advance = 0;
+		stbtt_GetGlyphHMetrics(font, index, &advance, nullptr);
+		glyph.x = 0u;
+		glyph.y = 0u;
+		glyph.xadvance = advance * scale;
+
+		// Outline box at the oversampled size.
+		Int32 x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+		stbtt_GetGlyphBitmapBox(font, index, scale * K, scale * K, &x0, &y0, &x1, &y1);
+
+		if (x1 <= x0 || y1 <= y0)
+		{
+			glyph.w = 0u;
+			glyph.h = 0u;
+			glyph.xoff = 0.f;
+			glyph.yoff = 0.f;
+			pixels.clear();
+			return index != 0;
+		}
+
+		const Int32 padding = static_cast<Int32>(spread);
+		const Int32 w = (x1 - x0 + K - 1) / K + 2 * padding;
+		const Int32 h = (y1 - y0 + K - 1) / K + 2 * padding;
+		const Int32 hw = w * K;
+		const Int32 hh = h * K;
+
+		glyph.w = static_cast<UInt16>(w);
+		glyph.h = static_cast<UInt16>(h);
+		glyph.xoff = static_cast<float>(x0) / K - padding;
+		glyph.yoff = static_cast<float>(y0) / K - padding;
+
+		std::vector<UInt8> coverage(hw * hh, 0u);
+		stbtt_MakeGlyphBitmap(font, &coverage[(padding * K) * hw + padding * K], x1 - x0, y1 - y0, hw, scale * K, scale * K, index);
+
+		// Distances to the nearest inside and the nearest outside pixel.
+		std::vector<float> outside(hw * hh), inside(hw * hh);
+		for (Int32 i = 0; i < hw * hh; ++i)
+		{
+			const bool isInside = coverage[i] >= 128u;
+			outside[i] = isInside ? 0.f : Infinity;
+			inside[i] = isInside ? Infinity : 0.f;
+		}
+		DistanceTransform(outside, hw, hh);
+		DistanceTransform(inside, hw, hh);
+
+		// Averages each KxK block, positive inside, in output pixels.
+		const float range = 128.f / spread;
+		pixels.resize(w * h);
+		for (Int32 y = 0; y < h; ++y)
+		{
+			for (Int32 x = 0; x < w; ++x)
+			{
+				float distance = 0.f;
+				for (Int32 sy = 0; sy < K; ++sy)
+				{
+					const Int32 row = (y * K + sy) * hw + x * K;
+					for (Int32 sx = 0; sx < K; ++sx)
+					{
+						// Pixel centers are half a pixel from the edge.
+						const Int32 i = row + sx;
+						distance += inside[i] > 0.f ? inside[i] - 0.5f : 0.5f - outside[i];
+					}
+				}
+				distance /= K * K * K;
+
+				const float value = 128.f + distance * range;
+				pixels[y * w + x] = static_cast<UInt8>(std::min(std::max(value, 0.f), 255.f));
+			}
+		}
+		return index != 0;
+	}
+
+	float Font::GetAscent(float pixelHeight) const
+	{
+		Int32 ascent = 0;
+		stbtt_GetFontVMetrics(&m_info->font, &ascent, nullptr, nullptr);
+		return ascent * stbtt_ScaleForPixelHeight(&m_info->font, pixelHeight);
+	}
+
+	float Font::GetLineHeight(float pixelHeight) const
+	{
+		Int32 ascent = 0, descent = 0, lineGap = 0;
+		stbtt_GetFontVMetrics(&m_info->font, &ascent, &descent, &lineGap);
+		return (ascent - descent + lineGap) * stbtt_ScaleForPixelHeight(&m_info->font, pixelHeight);
+	}
+
+	float Font::GetKerning(UInt32 first, UInt32 second, float pixelHeight) const
+	{
+		return stbtt_GetCodepointKernAdvance(&m_info->font, first, second) * stbtt_ScaleForPixelHeight(&m_info->font, pixelHeight);
+	}
+
+	UInt32 Font::DecodeUTF8(const char*& text)
 	{
-		size = m_bufferSize;
-		return m_buffer.get();
+		static const UInt32 Invalid = 0xFFFDu;
+
+		const UInt8* bytes = reinterpret_cast<const UInt8*>(text);
+		const UInt8 lead = bytes[0];
+
+		if (lead < 0x80u)
+		{
+			if (lead != 0u)
+			{
+				++text;
+			}
+			return lead;
+		}
+
+		UInt32 length = 0u, codepoint = 0u, minimum = 0u;
+		if ((lead & 0xE0u) == 0xC0u)
+		{
+			length = 2u; codepoint = lead & 0x1Fu; minimum = 0x80u;
+		}
+		else if ((lead & 0xF0u) == 0xE0u)
+		{
+			length = 3u; codepoint = lead & 0x0Fu; minimum = 0x800u;
+		}
+		else if ((lead & 0xF8u) == 0xF0u)
+		{
+			length = 4u; codepoint = lead & 0x07u; minimum = 0x10000u;
+		}
+		else
+		{
+			++text;
+			return Invalid;
+		}
+
+		for (UInt32 i = 1u; i < length; ++i)
+		{
+			if ((bytes[i] & 0xC0u) != 0x80u)
+			{
+				// Truncated sequence, resume at the unexpected byte.
+				text += i;
+				return Invalid;
+			}
+			codepoint = (codepoint << 6u) | (bytes[i] & 0x3Fu);
+		}
+
+		text += length;
+		if (codepoint < minimum || codepoint > 0x10FFFFu || (codepoint >= 0xD800u && codepoint <= 0xDFFFu))
+		{
+			return Invalid;
+		}
+		return codepoint;
 	}
 
 
-	UInt8* Font::GetBuffer(UInt32& size)
+	const UInt8* Font::GetBuffer(UInt32& size) const
 	{
-		size = m_bufferSize;
-		return m_buffer.get();
+		size = m_buffer.size;
+		return m_buffer.Get();
 	}
 
 }
\ No newline at end of file
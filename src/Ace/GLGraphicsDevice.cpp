@@ -75,6 +75,7 @@ namespace ace
 	{
 		GetMaterialPtr(&material);
         glUseProgram(material->materialID);
+		++CountStats().programBinds;
 	}
 
 	// OpenGL
@@ -161,6 +162,7 @@ namespace ace
 	void GraphicsDevice::Present(Window& window)
 	{
 		SDL_GL_SwapWindow((*window)->sdlWindow);
+		EndStatsFrame();
 	}
 
 	void GraphicsDevice::Viewport(UInt32 w, UInt32 h)
@@ -206,11 +208,13 @@ namespace ace
 			}
 
 			glBufferData(target, count * sizeof(Vertex) * instances, instance, GLBufferUsage[static_cast<UInt32>(usage)]);
+			CountUpload(count * sizeof(Vertex) * instances);
 			delete[] instance;
 		}
 		else
 		{
 			glBufferData(target, count * sizeof(Vertex), data, GLBufferUsage[static_cast<UInt32>(usage)]);
+			CountUpload(count * sizeof(Vertex));
 
 		}
 
@@ -224,6 +228,7 @@ namespace ace
 
 		glBindBuffer(target, buffer->bufferID);
 		glBufferSubData(target, offset, count * sizeof(Vertex), data);
+		CountUpload(count * sizeof(Vertex));
 		glBindBuffer(target, 0);
 	}
 
@@ -269,7 +274,7 @@ namespace ace
 		return texture;
 	}
 
-	void GraphicsDevice::UpdateTexture(Texture& texture, const UInt8* pixels, UInt32 w, UInt32 h, PixelFormat format)
+	void GraphicsDevice::UpdateTexture(Texture& texture, const UInt8* pixels, UInt32 w, UInt32 h, PixelFormat format, UInt32 level)
 	{
 		ACE_ASSERT(w != 0, "Texture width must be more than zero, %i", w);
 		ACE_ASSERT(h != 0, "Texture height must be more than zero, %i", h);
@@ -285,7 +290,14 @@ namespace ace
 		glBindTexture(GL_TEXTURE_2D, texture->textureID);
 		
 		UInt8 formatIndex = static_cast<UInt8>(format);
-		glTexImage2D(GL_TEXTURE_2D, 0, GLFormat[formatIndex], w, h, 0, GLFormat[formatIndex], GLFormatType[formatIndex], pixels);
+		// Rows are tightly packed, RGB and small mip levels are not 4 byte aligned.
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, level, GLFormat[formatIndex], w, h, 0, GLFormat[formatIndex], GLFormatType[formatIndex], pixels);
+		if (pixels != nullptr)
+		{
+			static const UInt32 PixelSizes[] = { 0u, 1u, 2u, 3u, 4u, 4u, 4u };
+			CountUpload(w * h * PixelSizes[formatIndex]);
+		}
 
 		SetTextureFlags(texture);
 		
@@ -305,6 +317,8 @@ namespace ace
 
 		glUseProgram((*GetMaterialPtr())->materialID);
 		glBindTexture(GL_TEXTURE_2D, texture->textureID);
+		++CountStats().programBinds;
+		++CountStats().textureBinds;
 		glActiveTexture(GL_TEXTURE0 + id);
         Uniform(name, &id, UniformType::Int32, 1);
 		//glUniform1i(glGetUniformLocation((*GetMaterialPtr())->materialID, name), id);
@@ -455,6 +469,7 @@ namespace ace
 			glUniformMatrix4fv(location, elements, false, static_cast<const math::Matrix4*>(data)->array);
 			break;
 		}
+		++CountStats().uniformUploads;
         
 		//glUseProgram(0);
 
@@ -463,6 +478,7 @@ namespace ace
 	void GraphicsDevice::Draw(UInt32 elements, UInt32 indicies, const UInt32* indexTable)
 	{
 		glUseProgram((*GetMaterialPtr())->materialID);
+		++CountStats().programBinds;
 		const_cast<ace::Material*>(GetMaterialPtr())->Apply();
 
 		CheckGL();
@@ -477,6 +493,8 @@ namespace ace
 		{
 			glDrawElements(GL_TRIANGLES, indicies, GL_UNSIGNED_INT, indexTable == nullptr ? 0 : indexTable);
 		}
+
+		CountDraw(elements, indicies);
 	}
 
 	void GraphicsDevice::Draw(const Buffer& buffer, UInt32 elements, UInt32 indicies, const UInt32* indexTable)
@@ -522,7 +540,8 @@ namespace ace
 		BufferData(s_spriteBuffer, 4, sprite.vertexData.data(), BufferUsage::Streaming);
 		SetVertexBuffer(s_spriteBuffer);
 
-		Draw(0, 6, indexTable);
+		// Indexed, the element count only feeds RenderStats.
+		Draw(4, 6, indexTable);
 	}
 
     void GraphicsDevice::Draw(const Drawable& drawable)
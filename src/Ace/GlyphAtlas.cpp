@@ -0,0 +1,237 @@
+#include <Ace/GlyphAtlas.h>
+#include <Ace/GraphicsDevice.h>
+#include <Ace/Log.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ace
+{
+    // Empty pixels between glyphs, keeps linear filtering from bleeding into neighbours.
+    static const UInt32 GlyphPadding = 1u;
+
+    // Pixel heights above this share the largest key.
+    static const UInt32 MaxPixelHeight = 2047u;
+
+    // Codepoints use 21 bits, the rounded pixel height the rest.
+    static UInt32 GlyphKey(const UInt32 codepoint, const float pixelHeight)
+    {
+        const UInt32 size = std::min(static_cast<UInt32>(pixelHeight + 0.5f), MaxPixelHeight);
+        return (size << 21u) | (codepoint & 0x1FFFFFu);
+    }
+
+    GlyphAtlas::GlyphAtlas(const Font& font, const UInt32 width, const UInt32 height, const GlyphMode mode,
+        const float fieldPixelHeight, const UInt32 fieldSpread) :
+        m_font(font),
+        m_width(width),
+        m_height(height),
+        m_mode(mode),
+        m_fieldPixelHeight(fieldPixelHeight),
+        m_fieldSpread(std::max(fieldSpread, 1u)),
+        m_dirty(false),
+        m_full(false)
+    {
+        Clear();
+    }
+
+    const Glyph* GlyphAtlas::GetGlyph(const UInt32 codepoint, const float pixelHeight)
+    {
+        const bool isField = m_mode == GlyphMode::DistanceField;
+
+        // Every size shares one distance field.
+        const UInt32 key = GlyphKey(codepoint, isField ? 0.f : pixelHeight);
+
+        const auto itr = m_glyphs.find(key);
+        if (itr != m_glyphs.end())
+        {
+            return &itr->second;
+        }
+
+        if (m_dropped.count(key) != 0u)
+        {
+            return nullptr;
+        }
+
+        Glyph glyph;
+        if (isField)
+        {
+            m_font.RasterizeGlyphSDF(codepoint, m_fieldPixelHeight, m_fieldSpread, m_scratch, glyph);
+        }
+        else
+        {
+            m_font.RasterizeGlyph(codepoint, static_cast<float>(key >> 21u), m_scratch, glyph);
+        }
+
+        UInt32 x = 0u, y = 0u;
+        if (glyph.w != 0u && !Pack(glyph.w + GlyphPadding, glyph.h + GlyphPadding, x, y))
+        {
+            if (!m_full)
+            {
+                Logger::LogError("GlyphAtlas: Atlas is full, glyph U+%04X dropped", codepoint);
+                m_full = true;
+            }
+            m_dropped.insert(key);
+            return nullptr;
+        }
+
+        glyph.x = static_cast<UInt16>(x);
+        glyph.y = static_cast<UInt16>(y);
+
+        for (UInt32 row = 0u; row < glyph.h; ++row)
+        {
+            std::memcpy(&m_pixels[(y + row) * m_width + x], &m_scratch[row * glyph.w], glyph.w);
+        }
+
+        m_dirty = m_dirty || glyph.w != 0u;
+        return &m_glyphs.emplace(key, glyph).first->second;
+    }
+
+    void GlyphAtlas::Update()
+    {
+        if (!m_dirty)
+        {
+            return;
+        }
+
+        if (!m_texture)
+        {
+            m_texture = GraphicsDevice::CreateTexture();
+            m_texture.flags.minFiltering = FilteringModes::Linear;
+            m_texture.flags.magFiltering = FilteringModes::Linear;
+            m_texture.flags.wrapModes = WrapModes::Clamp;
+        }
+
+        m_texture.Create(m_pixels.data(), m_width, m_height, PixelFormat::R);
+        m_dirty = false;
+    }
+
+    void GlyphAtlas::Clear()
+    {
+        m_glyphs.clear();
+        m_dropped.clear();
+        m_skyline.assign(1u, SkylineNode{ 0u, 0u, m_width });
+        m_pixels.assign(m_width * m_height, 0u);
+        m_dirty = true;
+        m_full = false;
+    }
+
+    float GlyphAtlas::GetGlyphScale(const float pixelHeight) const
+    {
+        return m_mode == GlyphMode::DistanceField ? pixelHeight / m_fieldPixelHeight : 1.f;
+    }
+
+    float GlyphAtlas::GetFieldGradient() const
+    {
+        // Matches Font::RasterizeGlyphSDF, 128 / spread per pixel out of 255.
+        return m_mode == GlyphMode::DistanceField ? 128.f / m_fieldSpread / 255.f : 0.f;
+    }
+
+    GlyphMode GlyphAtlas::GetMode() const
+    {
+        return m_mode;
+    }
+
+    const Font& GlyphAtlas::GetFont() const
+    {
+        return m_font;
+    }
+
+    const Texture& GlyphAtlas::GetTexture() const
+    {
+        return m_texture;
+    }
+
+    UInt32 GlyphAtlas::GetWidth() const
+    {
+        return m_width;
+    }
+
+    UInt32 GlyphAtlas::GetHeight() const
+    {
+        return m_height;
+    }
+
+    UInt32 GlyphAtlas::GetGlyphCount() const
+    {
+        return static_cast<UInt32>(m_glyphs.size());
+    }
+
+    bool GlyphAtlas::Pack(const UInt32 width, const UInt32 height, UInt32& x, UInt32& y)
+    {
+        // Bottom-left skyline: lowest placement wins, then the narrowest node.
+        UInt32 best = static_cast<UInt32>(m_skyline.size());
+        UInt32 bestY = m_height;
+        UInt32 bestWidth = m_width + 1u;
+
+        for (UInt32 i = 0u; i < m_skyline.size(); ++i)
+        {
+            const UInt32 left = m_skyline[i].x;
+            if (left + width > m_width)
+            {
+                break;
+            }
+
+            // Rests on the highest node under the span.
+            UInt32 top = 0u;
+            for (UInt32 j = i, covered = 0u; covered < width; covered += m_skyline[j].width, ++j)
+            {
+                top = std::max(top, m_skyline[j].y);
+            }
+
+            if (top + height <= m_height && (top < bestY || (top == bestY && m_skyline[i].width < bestWidth)))
+            {
+                best = i;
+                bestY = top;
+                bestWidth = m_skyline[i].width;
+            }
+        }
+
+        if (best == m_skyline.size())
+        {
+            return false;
+        }
+
+        x = m_skyline[best].x;
+        y = bestY;
+
+        m_skyline.insert(m_skyline.begin() + best, SkylineNode{ x, y + height, width });
+
+        // Shrinks or removes the nodes now under the new one.
+        const UInt32 right = x + width;
+        for (UInt32 i = best + 1u; i < m_skyline.size();)
+        {
+            SkylineNode& node = m_skyline[i];
+            if (node.x >= right)
+            {
+                break;
+            }
+
+            const UInt32 end = node.x + node.width;
+            if (end <= right)
+            {
+                m_skyline.erase(m_skyline.begin() + i);
+                continue;
+            }
+
+            node.width = end - right;
+            node.x = right;
+            break;
+        }
+
+        // Merges neighbours of the same height.
+        for (UInt32 i = 0u; i + 1u < m_skyline.size();)
+        {
+            if (m_skyline[i].y == m_skyline[i + 1u].y)
+            {
+                m_skyline[i].width += m_skyline[i + 1u].width;
+                m_skyline.erase(m_skyline.begin() + i + 1u);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        return true;
+    }
+
+}
@@ -109,10 +109,10 @@ namespace ace
 			return;
 		}
 
-		const auto& buffer = p_file.ReadAll();
+		const File::View view = p_file.Map();
 		Int32 comp = 0;
 
-		UInt8* pixels = stbi_load_from_memory(buffer.get(), p_file.Size(), &w, &h, &comp, 0);
+		UInt8* pixels = stbi_load_from_memory(view.Get(), view.size, &w, &h, &comp, 0);
 		m_pixels.reset(pixels);
 
 		this->format = static_cast<PixelFormat>(comp);
@@ -1,29 +1,92 @@
 #include <Ace/Json.h>
+#include <Ace/Log.h>
+
+#include <rapidjson/filewritestream.h>
+#include <rapidjson/prettywriter.h>
+
+#include <cstdio>
 
 namespace ace
 {
 
+	Json::Arena::Arena(UInt32 capacity) :
+		m_buffer(new char[capacity]),
+		m_capacity(capacity),
+		m_allocator(new rapidjson::MemoryPoolAllocator<>(m_buffer.get(), capacity))
+	{
+
+	}
+
+	Json::Arena::~Arena()
+	{
+
+	}
+
+	void Json::Arena::Reset()
+	{
+		// Overflowed into heap chunks, grow so the next document of this size fits in the buffer.
+		const UInt32 capacity = static_cast<UInt32>(m_allocator->Capacity());
+		if (capacity > m_capacity)
+		{
+			m_allocator.reset();
+			m_buffer.reset(new char[capacity]);
+			m_capacity = capacity;
+			m_allocator.reset(new rapidjson::MemoryPoolAllocator<>(m_buffer.get(), capacity));
+			return;
+		}
+
+		m_allocator->Clear();
+	}
+
+	UInt32 Json::Arena::GetSize() const
+	{
+		return static_cast<UInt32>(m_allocator->Size());
+	}
+
+	UInt32 Json::Arena::GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	rapidjson::MemoryPoolAllocator<>* Json::Arena::GetAllocator()
+	{
+		return m_allocator.get();
+	}
+
 	Json::Json()
 	{
 		
 	}
 
+	Json::Json(Arena& arena) : document(arena.GetAllocator())
+	{
+
+	}
 
 	bool Json::Parse(const File& file)
 	{
-		auto data = file.ReadAll();
-        std::string str;
+		const File::View view = file.Map();
 
-        //Would this work instead of loop
-        //str = *data;
-		
-		str.reserve(file.Size());
-		for (UInt32 i = 0u; i < file.Size(); ++i)
+		// Mapped data is not null terminated.
+		document.Parse(reinterpret_cast<const char*>(view.Get()), view.size);
+		return !document.HasParseError();
+	}
+
+	bool Json::ParseInsitu(const File& file)
+	{
+		if (!file)
 		{
-			str.push_back(data.get()[i]);
+			return false;
 		}
-		
-		document.Parse(str.c_str());
+
+		// Null terminated, the document keeps pointing into it.
+		m_buffer = file.ReadAllText();
+		return ParseInsitu(m_buffer.get());
+	}
+
+	bool Json::ParseInsitu(char* buffer)
+	{
+		document.ParseInsitu(buffer);
 		return !document.HasParseError();
 	}
 
@@ -33,14 +96,32 @@ namespace ace
 		return !document.HasParseError();
 	}
 
-
-	void Json::Write(Path path)
+	bool Json::Write(const Path& path, bool pretty) const
 	{
-		rapidjson::StringBuffer buffer;
-		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-		document.Accept(writer);
+		std::FILE* file = std::fopen(path.GetPath().c_str(), "wb");
+		if (file == nullptr)
+		{
+			Logger::LogError("Json: Failed to open %s for writing", path.GetPath().c_str());
+			return false;
+		}
+
+		char buffer[16384];
+		rapidjson::FileWriteStream stream(file, buffer, sizeof(buffer));
+
+		bool result;
+		if (pretty)
+		{
+			rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(stream);
+			result = document.Accept(writer);
+		}
+		else
+		{
+			rapidjson::Writer<rapidjson::FileWriteStream> writer(stream);
+			result = document.Accept(writer);
+		}
 
-		File f(path, "w");
-		f.Write(buffer.GetString());
+		stream.Flush();
+		result = std::ferror(file) == 0 && result;
+		return std::fclose(file) == 0 && result;
 	}
 }
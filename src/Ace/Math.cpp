@@ -43,6 +43,11 @@ namespace ace
 			return atan(a);
 		}
 
+		float Atan2(float y, float x)
+		{
+			return atan2(y, x);
+		}
+
 		float Ceil(float a)
 		{
 			return ceil(a);
@@ -1,10 +1,13 @@
 #include <Ace/Module.h>
 
+#include <Ace/AssetCache.h>
+#include <Ace/AssetLoader.h>
 #include <Ace/Audio.h>
 #include <Ace/EntityManager.h>
 #include <Ace/Event.h>
 #include <Ace/Time.h>
 #include <Ace/Platform.h>
+#include <Ace/Profiler.h>
 #include <Ace/Camera.h>
 
 #include <SDL.h>
@@ -34,7 +37,9 @@ namespace ace
 			}
 
             SDL_Init(SDL_INIT_EVERYTHING);
+			ACE_PROFILE_THREAD("Main");
 			Audio::Init();
+			AssetLoader::Init();
 
 			m_isInitialized = true;
         }
@@ -46,10 +51,16 @@ namespace ace
 
         void Update()
         {
-            Event::Update();
+			// Paced first, so events are polled as late as possible before the frame.
 			Time::Update();
+
+			ACE_PROFILE_SCOPE("ace::Update");
+            Event::Update();
 			EntityManager::Update();
+			EventDispatcher::Dispatch(EventPhase::Update);
 			Camera::UpdateMainCamera();
+			AssetLoader::Update();
+			AssetCache::Update();
         }
 
         void Quit()
@@ -59,6 +70,8 @@ namespace ace
 				return;
 			}
 
+			AssetLoader::Quit();
+			AssetCache::Clear();
 			Audio::Quit();
             SDL_Quit();
 
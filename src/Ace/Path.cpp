@@ -4,44 +4,42 @@
 
 namespace ace
 {
-	//std::string constructor
-	Path::Path(std::string p, bool isAbsolute)
+	// SDL_GetBasePath allocates and queries the OS on every call, the result never changes.
+	static const std::string& GetBasePath()
 	{
-		if (!isAbsolute)
+		static const std::string basePath = []()
 		{
-			char *base_path = SDL_GetBasePath();
+			std::string result;
+			char* base_path = SDL_GetBasePath();
 			if (base_path)
 			{
-				m_data_path = base_path + p;
+				result = base_path;
 				SDL_free(base_path);
 			}
-			else
-			{
-				m_data_path = p;
-			}
+			return result;
+		}();
+		return basePath;
+	}
+
+	//std::string constructor
+	Path::Path(std::string p, bool isAbsolute)
+	{
+		if (!isAbsolute)
+		{
+			m_data_path.reserve(GetBasePath().size() + p.size());
+			m_data_path = GetBasePath();
+			m_data_path += p;
 		}
 		else
 		{
-			m_data_path = p;
+			m_data_path = std::move(p);
 		}
 	}
 
 	//Const char constructor
-	Path::Path(const char* c)
+	Path::Path(const char* c) : Path(std::string(c))
 	{
-		//This changes const char to std::string
-		std::string p(c);
 
-		char *base_path = SDL_GetBasePath();
-		if (base_path)
-		{
-			m_data_path = base_path + p;
-			SDL_free(base_path);
-		}
-		else
-		{
-			m_data_path = p;
-		}
 	}
 
 	Path::~Path()
@@ -0,0 +1,703 @@
+#include <Ace/PhysicsWorld.h>
+#include <Ace/CollisionSystem.h>
+#include <Ace/EntityHandle.h>
+#include <Ace/Log.h>
+#include <Ace/Math.h>
+#include <Ace/Matrix2.h>
+
+#include <algorithm> // std::sort, std::lower_bound
+
+namespace ace
+{
+    static const float s_baumgarte = 0.2f;
+    static const float s_linearSlop = 0.005f;
+    static const float s_restitutionThreshold = 1.f;
+    static const float s_linearSleepTolerance = 0.01f;
+    static const float s_angularSleepTolerance = math::Rad(2.f);
+    static const float s_timeToSleep = 0.5f;
+    static const UInt32 s_maxSteps = 8u;
+
+    static inline float Cross(const Vector2& a, const Vector2& b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    static inline Vector2 Cross(const float w, const Vector2& r)
+    {
+        return Vector2(-w * r.y, w * r.x);
+    }
+
+    // Moment of inertia around the position of the shape.
+    static float ComputeInertia(const Collidable& shape, const float mass)
+    {
+        if (shape.GetType() == CollidableType::Circle)
+        {
+            const float radius = static_cast<const Circle&>(shape).GetRadius();
+            return 0.5f * mass * radius * radius;
+        }
+
+        const std::vector<Vector2> vertices(shape.GetVertices());
+
+        float numerator = 0.f;
+        float denominator = 0.f;
+        for (UInt32 i = 0u; i < vertices.size(); ++i)
+        {
+            const Vector2 a(vertices[i] - shape.GetLocalPosition());
+            const Vector2 b(vertices[(i + 1u) < vertices.size() ? (i + 1u) : 0u] - shape.GetLocalPosition());
+            const float cross = math::Abs(Cross(a, b));
+            numerator += cross * (Vector2::Dot(a, a) + Vector2::Dot(a, b) + Vector2::Dot(b, b));
+            denominator += cross;
+        }
+        return math::IsNearEpsilon(denominator) ? 0.f : mass * numerator / (6.f * denominator);
+    }
+
+    template <typename T>
+    static inline void SwapRemove(std::vector<T>& data, const UInt32 index)
+    {
+        data[index] = data.back();
+        data.pop_back();
+    }
+
+
+    PhysicsWorld::PhysicsWorld(const Vector2& gravity, const float timeStep) :
+        m_gravity(gravity),
+        m_timeStep(timeStep),
+        m_accumulator(0.f),
+        m_iterations(8u)
+    {
+
+    }
+
+    PhysicsWorld::~PhysicsWorld()
+    {
+        for (UInt32 i = 0u; i < m_shapes.size(); ++i)
+        {
+            if (m_entityIDs[i] == 0u)
+            {
+                CollisionSystem::Remove(*m_shapes[i]);
+            }
+        }
+    }
+
+    PhysicsWorld::BodyID PhysicsWorld::CreateBody(Collidable& shape, const float mass, const Vector2& velocity)
+    {
+        CollisionSystem::Add(shape);
+        return AddBody(shape, mass, velocity, nullptr, Vector2());
+    }
+
+    PhysicsWorld::BodyID PhysicsWorld::CreateBody(EntityHandle& entity, const float mass, const Vector2& velocity)
+    {
+        Vector2 offset;
+        Collidable* shape = CollisionSystem::FindCollider(entity, offset);
+        if (shape == nullptr)
+        {
+            Logger::LogError("PhysicsWorld: Entity %u has no collider", entity.id);
+            return InvalidBody;
+        }
+        return AddBody(*shape, mass, velocity, &entity, offset);
+    }
+
+    PhysicsWorld::BodyID PhysicsWorld::AddBody(Collidable& shape, const float mass, const Vector2& velocity, EntityHandle* entity, const Vector2& offset)
+    {
+        const UInt32 index = static_cast<UInt32>(m_shapes.size());
+        const bool isStatic = mass <= 0.f;
+        const float inertia = isStatic ? 0.f : ComputeInertia(shape, mass);
+
+        BodyID id;
+        if (m_freeIDs.empty())
+        {
+            id = static_cast<BodyID>(m_indices.size());
+            m_indices.push_back(index);
+        }
+        else
+        {
+            id = m_freeIDs.back();
+            m_freeIDs.pop_back();
+            m_indices[id] = index;
+        }
+
+        const Matrix2& rotation = shape.GetRotation();
+
+        m_positionX.push_back(shape.GetLocalPosition().x);
+        m_positionY.push_back(shape.GetLocalPosition().y);
+        m_angle.push_back(math::Atan2(rotation(1, 0), rotation(0, 0)));
+        m_velocityX.push_back(isStatic ? 0.f : velocity.x);
+        m_velocityY.push_back(isStatic ? 0.f : velocity.y);
+        m_angularVelocity.push_back(0.f);
+        m_forceX.push_back(0.f);
+        m_forceY.push_back(0.f);
+        m_inverseMass.push_back(isStatic ? 0.f : 1.f / mass);
+        m_inverseInertia.push_back(math::IsNearEpsilon(inertia) ? 0.f : 1.f / inertia);
+        m_active.push_back(isStatic ? 0.f : 1.f);
+        m_restitution.push_back(0.f);
+        m_friction.push_back(0.5f);
+        m_sleepTime.push_back(0.f);
+        m_shapes.push_back(&shape);
+        m_ids.push_back(id);
+        m_entityIDs.push_back(entity != nullptr ? entity->id : 0u);
+        m_managers.push_back(entity != nullptr ? entity->manager : nullptr);
+        m_entities.push_back(entity);
+        m_offsets.push_back(offset);
+
+        shape.SetStatic(isStatic);
+        shape.SetSleeping(false);
+        shape.UpdateAABB();
+
+        return id;
+    }
+
+    void PhysicsWorld::DestroyBody(const BodyID body)
+    {
+        if (body >= m_indices.size() || m_indices[body] == InvalidBody)
+        {
+            return;
+        }
+
+        const UInt32 index = m_indices[body];
+
+        // Shapes of entity bodies may already be gone.
+        if (m_entityIDs[index] == 0u)
+        {
+            CollisionSystem::Remove(*m_shapes[index]);
+        }
+
+        SwapRemove(m_positionX, index);
+        SwapRemove(m_positionY, index);
+        SwapRemove(m_angle, index);
+        SwapRemove(m_velocityX, index);
+        SwapRemove(m_velocityY, index);
+        SwapRemove(m_angularVelocity, index);
+        SwapRemove(m_forceX, index);
+        SwapRemove(m_forceY, index);
+        SwapRemove(m_inverseMass, index);
+        SwapRemove(m_inverseInertia, index);
+        SwapRemove(m_active, index);
+        SwapRemove(m_restitution, index);
+        SwapRemove(m_friction, index);
+        SwapRemove(m_sleepTime, index);
+        SwapRemove(m_shapes, index);
+        SwapRemove(m_ids, index);
+        SwapRemove(m_entityIDs, index);
+        SwapRemove(m_managers, index);
+        SwapRemove(m_entities, index);
+        SwapRemove(m_offsets, index);
+
+        if (index < m_shapes.size())
+        {
+            m_indices[m_ids[index]] = index;
+        }
+
+        m_indices[body] = InvalidBody;
+        m_freeIDs.push_back(body);
+
+        // Dense indices changed, cached impulses can't be matched safely anymore.
+        m_previousContacts.clear();
+    }
+
+    UInt32 PhysicsWorld::Step(const float deltaTime)
+    {
+        Refresh();
+
+        m_accumulator += deltaTime;
+
+        UInt32 steps = 0u;
+        while (m_accumulator >= m_timeStep && steps < s_maxSteps)
+        {
+            SubStep(m_timeStep);
+            m_accumulator -= m_timeStep;
+            ++steps;
+        }
+
+        // Drop the backlog instead of spiralling when the frame took too long.
+        if (steps == s_maxSteps)
+        {
+            m_accumulator = 0.f;
+        }
+
+        if (steps != 0u)
+        {
+            WriteTransforms();
+        }
+
+        return steps;
+    }
+
+    void PhysicsWorld::Refresh()
+    {
+        // Backwards, DestroyBody moves the last body into the destroyed one's place.
+        for (UInt32 i = static_cast<UInt32>(m_shapes.size()); i-- > 0u;)
+        {
+            if (m_entityIDs[i] == 0u)
+            {
+                continue;
+            }
+
+            EntityHandle* entity = EntityManager::FindEntity(m_entityIDs[i], *m_managers[i]);
+            Collidable* shape = entity != nullptr ? CollisionSystem::FindCollider(*entity, m_offsets[i]) : nullptr;
+            if (shape == nullptr)
+            {
+                DestroyBody(m_ids[i]);
+                continue;
+            }
+
+            m_entities[i] = entity;
+            m_shapes[i] = shape;
+
+            // A replaced collider starts with default flags and the pose of its Transform.
+            shape->SetStatic(m_inverseMass[i] == 0.f);
+            shape->SetSleeping(m_inverseMass[i] != 0.f && m_active[i] == 0.f);
+            SyncShape(i);
+        }
+
+        m_lookup.clear();
+        for (UInt32 i = 0u; i < m_shapes.size(); ++i)
+        {
+            m_lookup.emplace_back(m_shapes[i], i);
+        }
+        std::sort(m_lookup.begin(), m_lookup.end());
+    }
+
+    void PhysicsWorld::WriteTransforms()
+    {
+        for (UInt32 i = 0u; i < m_entities.size(); ++i)
+        {
+            if (m_entities[i] == nullptr)
+            {
+                continue;
+            }
+
+            const float angle = m_angle[i];
+            const Vector2 origin(Vector2(m_positionX[i], m_positionY[i]) - (Matrix2::Rotation(math::Deg(angle)) * m_offsets[i]));
+
+            // Scene multiplies row vectors with Quaternion::ToMatrix4, which turns the other way.
+            Transform& transform = m_entities[i]->transform;
+            transform.position.x = origin.x;
+            transform.position.y = origin.y;
+            transform.rotation.vector = Vector3(0.f, 0.f, -math::Sin(angle * 0.5f));
+            transform.rotation.scalar = math::Cos(angle * 0.5f);
+        }
+    }
+
+    UInt32 PhysicsWorld::FindBody(const Collidable* shape) const
+    {
+        auto itr = std::lower_bound(m_lookup.begin(), m_lookup.end(), std::make_pair(shape, 0u));
+        return (itr != m_lookup.end() && itr->first == shape) ? itr->second : InvalidBody;
+    }
+
+    void PhysicsWorld::SubStep(const float h)
+    {
+        const UInt32 count = static_cast<UInt32>(m_shapes.size());
+
+        Collide(h);
+
+        // Semi-implicit Euler, velocities first. Branchless over the arrays so the loop vectorizes,
+        // static and sleeping bodies have m_active = 0.
+        {
+            float* vx = m_velocityX.data();
+            float* vy = m_velocityY.data();
+            const float* fx = m_forceX.data();
+            const float* fy = m_forceY.data();
+            const float* im = m_inverseMass.data();
+            const float* active = m_active.data();
+            const float gx = m_gravity.x;
+            const float gy = m_gravity.y;
+
+            for (UInt32 i = 0u; i < count; ++i)
+            {
+                vx[i] += (gx + fx[i] * im[i]) * h * active[i];
+                vy[i] += (gy + fy[i] * im[i]) * h * active[i];
+            }
+        }
+
+        std::fill(m_forceX.begin(), m_forceX.end(), 0.f);
+        std::fill(m_forceY.begin(), m_forceY.end(), 0.f);
+
+        Solve();
+
+        {
+            float* px = m_positionX.data();
+            float* py = m_positionY.data();
+            float* angle = m_angle.data();
+            const float* vx = m_velocityX.data();
+            const float* vy = m_velocityY.data();
+            const float* w = m_angularVelocity.data();
+            const float* active = m_active.data();
+
+            for (UInt32 i = 0u; i < count; ++i)
+            {
+                px[i] += vx[i] * h * active[i];
+                py[i] += vy[i] * h * active[i];
+                angle[i] += w[i] * h * active[i];
+            }
+        }
+
+        UpdateSleep(h);
+
+        for (UInt32 i = 0u; i < count; ++i)
+        {
+            if (m_active[i] != 0.f)
+            {
+                SyncShape(i);
+            }
+        }
+    }
+
+    void PhysicsWorld::Collide(const float h)
+    {
+        std::swap(m_contacts, m_previousContacts);
+        m_contacts.clear();
+
+        // Pairs found touching by the last CollisionSystem::Update, manifolds are computed at the current poses.
+        for (const auto& pair : CollisionSystem::GetInstance().m_contacts)
+        {
+            UInt32 a = FindBody(pair.colliderA);
+            UInt32 b = FindBody(pair.colliderB);
+            if (a == InvalidBody || b == InvalidBody)
+            {
+                continue;
+            }
+
+            if (m_ids[b] < m_ids[a])
+            {
+                std::swap(a, b);
+            }
+
+            Manifold manifold;
+            if (!Collidable::GetManifold(*m_shapes[a], *m_shapes[b], manifold))
+            {
+                continue;
+            }
+
+            // An awake body touching a sleeping one wakes it, the island is re-evaluated after the step.
+            if (m_active[a] == 0.f && m_inverseMass[a] != 0.f) SetAwake(a, true);
+            if (m_active[b] == 0.f && m_inverseMass[b] != 0.f) SetAwake(b, true);
+
+            ContactConstraint constraint;
+            constraint.a = a;
+            constraint.b = b;
+            constraint.idA = m_ids[a];
+            constraint.idB = m_ids[b];
+            constraint.normal = manifold.normal;
+            constraint.friction = math::Sqrt(m_friction[a] * m_friction[b]);
+            constraint.count = manifold.count;
+
+            const float restitution = math::Max(m_restitution[a], m_restitution[b]);
+            const Vector2 tangent(manifold.normal.y, -manifold.normal.x);
+            const float imA = m_inverseMass[a], imB = m_inverseMass[b];
+            const float iiA = m_inverseInertia[a], iiB = m_inverseInertia[b];
+
+            for (UInt8 i = 0u; i < manifold.count; ++i)
+            {
+                ContactPoint& point = constraint.points[i];
+                point.rA = manifold.points[i] - Vector2(m_positionX[a], m_positionY[a]);
+                point.rB = manifold.points[i] - Vector2(m_positionX[b], m_positionY[b]);
+                point.normalImpulse = 0.f;
+                point.tangentImpulse = 0.f;
+
+                const float rnA = Cross(point.rA, manifold.normal);
+                const float rnB = Cross(point.rB, manifold.normal);
+                const float normalMass = imA + imB + iiA * rnA * rnA + iiB * rnB * rnB;
+                point.normalMass = normalMass > 0.f ? 1.f / normalMass : 0.f;
+
+                const float rtA = Cross(point.rA, tangent);
+                const float rtB = Cross(point.rB, tangent);
+                const float tangentMass = imA + imB + iiA * rtA * rtA + iiB * rtB * rtB;
+                point.tangentMass = tangentMass > 0.f ? 1.f / tangentMass : 0.f;
+
+                const Vector2 dv(
+                    Vector2(m_velocityX[b], m_velocityY[b]) + Cross(m_angularVelocity[b], point.rB) -
+                    Vector2(m_velocityX[a], m_velocityY[a]) - Cross(m_angularVelocity[a], point.rA)
+                );
+                const float vn = Vector2::Dot(dv, manifold.normal);
+
+                point.bias = s_baumgarte / h * math::Max(manifold.depths[i] - s_linearSlop, 0.f);
+                if (vn < -s_restitutionThreshold)
+                {
+                    point.bias = math::Max(point.bias, -restitution * vn);
+                }
+            }
+
+            // Warm start from the same pair in the previous step.
+            auto previous = std::lower_bound(m_previousContacts.begin(), m_previousContacts.end(), constraint);
+            if (previous != m_previousContacts.end() && previous->idA == constraint.idA && previous->idB == constraint.idB)
+            {
+                for (UInt8 i = 0u; i < constraint.count && i < previous->count; ++i)
+                {
+                    constraint.points[i].normalImpulse = previous->points[i].normalImpulse;
+                    constraint.points[i].tangentImpulse = previous->points[i].tangentImpulse;
+                }
+            }
+
+            m_contacts.push_back(constraint);
+        }
+
+        std::sort(m_contacts.begin(), m_contacts.end());
+    }
+
+    void PhysicsWorld::Solve()
+    {
+        // Warm starting.
+        for (const auto& contact : m_contacts)
+        {
+            const UInt32 a = contact.a, b = contact.b;
+            const Vector2 tangent(contact.normal.y, -contact.normal.x);
+
+            for (UInt8 i = 0u; i < contact.count; ++i)
+            {
+                const ContactPoint& point = contact.points[i];
+                const Vector2 impulse(contact.normal * point.normalImpulse + tangent * point.tangentImpulse);
+
+                m_velocityX[a] -= impulse.x * m_inverseMass[a];
+                m_velocityY[a] -= impulse.y * m_inverseMass[a];
+                m_angularVelocity[a] -= m_inverseInertia[a] * Cross(point.rA, impulse);
+
+                m_velocityX[b] += impulse.x * m_inverseMass[b];
+                m_velocityY[b] += impulse.y * m_inverseMass[b];
+                m_angularVelocity[b] += m_inverseInertia[b] * Cross(point.rB, impulse);
+            }
+        }
+
+        for (UInt32 iteration = 0u; iteration < m_iterations; ++iteration)
+        {
+            for (auto& contact : m_contacts)
+            {
+                const UInt32 a = contact.a, b = contact.b;
+                const float imA = m_inverseMass[a], imB = m_inverseMass[b];
+                const float iiA = m_inverseInertia[a], iiB = m_inverseInertia[b];
+                const Vector2 tangent(contact.normal.y, -contact.normal.x);
+
+                Vector2 vA(m_velocityX[a], m_velocityY[a]);
+                Vector2 vB(m_velocityX[b], m_velocityY[b]);
+                float wA = m_angularVelocity[a];
+                float wB = m_angularVelocity[b];
+
+                for (UInt8 i = 0u; i < contact.count; ++i)
+                {
+                    ContactPoint& point = contact.points[i];
+
+                    // Friction first, normal impulses have the final say on penetration.
+                    Vector2 dv(vB + Cross(wB, point.rB) - vA - Cross(wA, point.rA));
+                    const float maxFriction = contact.friction * point.normalImpulse;
+                    const float oldTangent = point.tangentImpulse;
+                    point.tangentImpulse = math::Clamp(oldTangent - point.tangentMass * Vector2::Dot(dv, tangent), -maxFriction, maxFriction);
+
+                    Vector2 impulse(tangent * (point.tangentImpulse - oldTangent));
+                    vA -= impulse * imA;
+                    wA -= iiA * Cross(point.rA, impulse);
+                    vB += impulse * imB;
+                    wB += iiB * Cross(point.rB, impulse);
+
+                    dv = vB + Cross(wB, point.rB) - vA - Cross(wA, point.rA);
+                    const float oldNormal = point.normalImpulse;
+                    point.normalImpulse = math::Max(oldNormal - point.normalMass * (Vector2::Dot(dv, contact.normal) - point.bias), 0.f);
+
+                    impulse = contact.normal * (point.normalImpulse - oldNormal);
+                    vA -= impulse * imA;
+                    wA -= iiA * Cross(point.rA, impulse);
+                    vB += impulse * imB;
+                    wB += iiB * Cross(point.rB, impulse);
+                }
+
+                m_velocityX[a] = vA.x;
+                m_velocityY[a] = vA.y;
+                m_angularVelocity[a] = wA;
+                m_velocityX[b] = vB.x;
+                m_velocityY[b] = vB.y;
+                m_angularVelocity[b] = wB;
+            }
+        }
+    }
+
+    void PhysicsWorld::UpdateSleep(const float h)
+    {
+        const UInt32 count = static_cast<UInt32>(m_shapes.size());
+        const float linear = s_linearSleepTolerance * s_linearSleepTolerance;
+        const float angular = s_angularSleepTolerance * s_angularSleepTolerance;
+
+        m_islands.resize(count);
+        for (UInt32 i = 0u; i < count; ++i)
+        {
+            m_islands[i] = i;
+
+            if (m_active[i] == 0.f)
+            {
+                continue;
+            }
+
+            const float speed = m_velocityX[i] * m_velocityX[i] + m_velocityY[i] * m_velocityY[i];
+            const float spin = m_angularVelocity[i] * m_angularVelocity[i];
+            m_sleepTime[i] = (speed < linear && spin < angular) ? m_sleepTime[i] + h : 0.f;
+        }
+
+        // Static bodies don't join islands, otherwise the whole level would be one island.
+        for (const auto& contact : m_contacts)
+        {
+            if (m_inverseMass[contact.a] == 0.f || m_inverseMass[contact.b] == 0.f)
+            {
+                continue;
+            }
+            m_islands[FindRoot(contact.a)] = FindRoot(contact.b);
+        }
+
+        // Island sleeps when its most restless body has been resting long enough.
+        std::vector<float> islandTime(count, s_timeToSleep);
+        for (UInt32 i = 0u; i < count; ++i)
+        {
+            if (m_inverseMass[i] != 0.f)
+            {
+                const UInt32 root = FindRoot(i);
+                islandTime[root] = math::Min(islandTime[root], m_sleepTime[i]);
+            }
+        }
+
+        for (UInt32 i = 0u; i < count; ++i)
+        {
+            if (m_inverseMass[i] == 0.f)
+            {
+                continue;
+            }
+
+            const bool sleep = islandTime[FindRoot(i)] >= s_timeToSleep;
+            if (sleep == (m_active[i] == 0.f))
+            {
+                continue;
+            }
+
+            SetAwake(i, !sleep);
+        }
+    }
+
+    UInt32 PhysicsWorld::FindRoot(UInt32 index)
+    {
+        while (m_islands[index] != index)
+        {
+            m_islands[index] = m_islands[m_islands[index]];
+            index = m_islands[index];
+        }
+        return index;
+    }
+
+    void PhysicsWorld::SyncShape(const UInt32 index)
+    {
+        Collidable& shape = *m_shapes[index];
+        shape.GetLocalPosition() = Vector2(m_positionX[index], m_positionY[index]);
+        shape.GetRotation() = Matrix2::Rotation(math::Deg(m_angle[index]));
+        shape.UpdateAABB();
+    }
+
+    void PhysicsWorld::SetAwake(const UInt32 index, const bool awake)
+    {
+        if (m_inverseMass[index] == 0.f)
+        {
+            return;
+        }
+
+        m_active[index] = awake ? 1.f : 0.f;
+        m_shapes[index]->SetSleeping(!awake);
+
+        if (awake)
+        {
+            m_sleepTime[index] = 0.f;
+        }
+        else
+        {
+            m_velocityX[index] = 0.f;
+            m_velocityY[index] = 0.f;
+            m_angularVelocity[index] = 0.f;
+        }
+    }
+
+    Vector2 PhysicsWorld::GetPosition(const BodyID body) const
+    {
+        const UInt32 index = m_indices[body];
+        return Vector2(m_positionX[index], m_positionY[index]);
+    }
+
+    void PhysicsWorld::SetPosition(const BodyID body, const Vector2& position)
+    {
+        const UInt32 index = m_indices[body];
+        m_positionX[index] = position.x;
+        m_positionY[index] = position.y;
+        SetAwake(index, true);
+        SyncShape(index);
+    }
+
+    float PhysicsWorld::GetAngle(const BodyID body) const
+    {
+        return math::Deg(m_angle[m_indices[body]]);
+    }
+
+    Vector2 PhysicsWorld::GetVelocity(const BodyID body) const
+    {
+        const UInt32 index = m_indices[body];
+        return Vector2(m_velocityX[index], m_velocityY[index]);
+    }
+
+    void PhysicsWorld::SetVelocity(const BodyID body, const Vector2& velocity)
+    {
+        const UInt32 index = m_indices[body];
+        if (m_inverseMass[index] == 0.f)
+        {
+            return;
+        }
+        SetAwake(index, true);
+        m_velocityX[index] = velocity.x;
+        m_velocityY[index] = velocity.y;
+    }
+
+    float PhysicsWorld::GetAngularVelocity(const BodyID body) const
+    {
+        return m_angularVelocity[m_indices[body]];
+    }
+
+    void PhysicsWorld::SetAngularVelocity(const BodyID body, const float velocity)
+    {
+        const UInt32 index = m_indices[body];
+        if (m_inverseMass[index] == 0.f)
+        {
+            return;
+        }
+        SetAwake(index, true);
+        m_angularVelocity[index] = velocity;
+    }
+
+    void PhysicsWorld::ApplyForce(const BodyID body, const Vector2& force)
+    {
+        const UInt32 index = m_indices[body];
+        SetAwake(index, true);
+        m_forceX[index] += force.x;
+        m_forceY[index] += force.y;
+    }
+
+    void PhysicsWorld::ApplyImpulse(const BodyID body, const Vector2& impulse, const Vector2& point)
+    {
+        const UInt32 index = m_indices[body];
+        if (m_inverseMass[index] == 0.f)
+        {
+            return;
+        }
+        SetAwake(index, true);
+        m_velocityX[index] += impulse.x * m_inverseMass[index];
+        m_velocityY[index] += impulse.y * m_inverseMass[index];
+        m_angularVelocity[index] += m_inverseInertia[index] * Cross(point - Vector2(m_positionX[index], m_positionY[index]), impulse);
+    }
+
+    void PhysicsWorld::SetMaterial(const BodyID body, const float restitution, const float friction)
+    {
+        const UInt32 index = m_indices[body];
+        m_restitution[index] = math::Clamp(restitution, 0.f, 1.f);
+        m_friction[index] = math::Max(friction, 0.f);
+    }
+
+    bool PhysicsWorld::IsSleeping(const BodyID body) const
+    {
+        const UInt32 index = m_indices[body];
+        return m_inverseMass[index] != 0.f && m_active[index] == 0.f;
+    }
+
+    void PhysicsWorld::Wake(const BodyID body)
+    {
+        SetAwake(m_indices[body], true);
+    }
+
+}
@@ -0,0 +1,230 @@
+#include <Ace/Profiler.h>
+
+#include <Ace/Log.h>
+
+#include <SDL_atomic.h>
+#include <SDL_rwops.h>
+#include <SDL_timer.h>
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ace
+{
+    // Zones kept per thread, about 1.5 MB each.
+    static const UInt32 ZoneCapacity = 1u << 16u;
+
+    // Deeper zones are not recorded.
+    static const UInt32 MaxDepth = 64u;
+
+    struct Zone
+    {
+        const char* name;
+        // SDL's counter type, UInt64 is only 32 bits wide on some platforms.
+        Uint64 start;
+        Uint64 end;
+    };
+
+    // Written by its thread only, read by EndCapture once recording has stopped and the thread is not writing.
+    struct ThreadZones
+    {
+        std::vector<Zone> zones;
+        std::atomic<UInt32> written;
+        std::atomic<bool> isWriting;
+        UInt32 captureStart;
+
+        const char* name;
+
+        // Open zones, by depth.
+        const char* openNames[MaxDepth];
+        Uint64 openStarts[MaxDepth];
+        UInt32 depth;
+
+        ThreadZones() : zones(ZoneCapacity), written(0u), isWriting(false), captureStart(0u), name(nullptr), depth(0u)
+        {
+
+        }
+    };
+
+    static std::atomic<bool> g_isCapturing(false);
+    static Uint64 g_captureStart;
+
+    // Buffers outlive their threads, zones of finished workers are still exported.
+    static SDL_SpinLock g_threadsLock;
+    static std::vector<std::unique_ptr<ThreadZones>> g_threads;
+
+    static thread_local ThreadZones* t_zones = nullptr;
+
+    static ThreadZones& GetThreadZones()
+    {
+        if (t_zones == nullptr)
+        {
+            std::unique_ptr<ThreadZones> zones(new ThreadZones());
+            t_zones = zones.get();
+
+            SDL_AtomicLock(&g_threadsLock);
+            g_threads.emplace_back(std::move(zones));
+            SDL_AtomicUnlock(&g_threadsLock);
+        }
+        return *t_zones;
+    }
+
+    void Profiler::BeginCapture()
+    {
+        SDL_AtomicLock(&g_threadsLock);
+        for (auto& zones : g_threads)
+        {
+            zones->captureStart = zones->written.load(std::memory_order_acquire);
+        }
+        SDL_AtomicUnlock(&g_threadsLock);
+
+        g_captureStart = SDL_GetPerformanceCounter();
+        g_isCapturing.store(true, std::memory_order_release);
+    }
+
+    bool Profiler::IsCapturing()
+    {
+        return g_isCapturing.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        GetThreadZones().name = name;
+    }
+
+    bool Profiler::Begin(const char* name)
+    {
+        if (!g_isCapturing.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        ThreadZones& zones = GetThreadZones();
+        if (zones.depth == MaxDepth)
+        {
+            return false;
+        }
+
+        zones.openNames[zones.depth] = name;
+        zones.openStarts[zones.depth] = SDL_GetPerformanceCounter();
+        ++zones.depth;
+        return true;
+    }
+
+    void Profiler::End()
+    {
+        const Uint64 end = SDL_GetPerformanceCounter();
+
+        ThreadZones& zones = *t_zones;
+        --zones.depth;
+
+        // Pairs with EndCapture: either it waits for this write, or this sees recording has stopped
+        // and drops the zone, which ends after the capture anyway.
+        zones.isWriting.store(true, std::memory_order_seq_cst);
+        if (g_isCapturing.load(std::memory_order_seq_cst))
+        {
+            const UInt32 written = zones.written.load(std::memory_order_relaxed);
+            zones.zones[written % ZoneCapacity] = { zones.openNames[zones.depth], zones.openStarts[zones.depth], end };
+            zones.written.store(written + 1u, std::memory_order_release);
+        }
+        zones.isWriting.store(false, std::memory_order_release);
+    }
+
+    // Names are code identifiers, only quotes and backslashes need escaping.
+    static void AppendString(std::string& json, const char* text)
+    {
+        json += '"';
+        for (; *text != '\0'; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+            {
+                json += '\\';
+            }
+            json += *text;
+        }
+        json += '"';
+    }
+
+    bool Profiler::EndCapture(const char* path)
+    {
+        g_isCapturing.store(false, std::memory_order_seq_cst);
+
+        const double toMicroseconds = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+        std::string json("{\"traceEvents\":[\n");
+        bool isFirst = true;
+        char number[96];
+
+        SDL_AtomicLock(&g_threadsLock);
+        for (UInt32 thread = 0u; thread < g_threads.size(); ++thread)
+        {
+            const ThreadZones& zones = *g_threads[thread];
+
+            if (zones.name != nullptr)
+            {
+                json += isFirst ? "" : ",\n";
+                std::snprintf(number, sizeof(number), "{\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", thread);
+                json += number;
+                AppendString(json, zones.name);
+                json += "}}";
+                isFirst = false;
+            }
+
+            // A zone being written when recording stopped is finished first, no zone is written afterwards.
+            while (zones.isWriting.load(std::memory_order_acquire))
+            {
+
+            }
+
+            const UInt32 written = zones.written.load(std::memory_order_acquire);
+            UInt32 first = zones.captureStart;
+            // The oldest zones of a full ring were overwritten.
+            if (written - first > ZoneCapacity)
+            {
+                first = written - ZoneCapacity;
+            }
+
+            for (UInt32 i = first; i != written; ++i)
+            {
+                const Zone& zone = zones.zones[i % ZoneCapacity];
+
+                // Zones opened before the capture started.
+                if (zone.start < g_captureStart)
+                {
+                    continue;
+                }
+
+                json += isFirst ? "{\"ph\":\"X\",\"pid\":0,\"tid\":" : ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":";
+                std::snprintf(number, sizeof(number), "%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", thread,
+                    static_cast<double>(zone.start - g_captureStart) * toMicroseconds,
+                    static_cast<double>(zone.end - zone.start) * toMicroseconds);
+                json += number;
+                AppendString(json, zone.name);
+                json += '}';
+                isFirst = false;
+            }
+        }
+        SDL_AtomicUnlock(&g_threadsLock);
+
+        json += "\n]}\n";
+
+        SDL_RWops* file = SDL_RWFromFile(path, "wb");
+        if (file == nullptr)
+        {
+            Logger::LogError("Profiler could not open %s: %s", path, SDL_GetError());
+            return false;
+        }
+
+        const bool isWritten = SDL_RWwrite(file, json.data(), 1u, json.size()) == json.size();
+        SDL_RWclose(file);
+        if (!isWritten)
+        {
+            Logger::LogError("Profiler could not write %s", path);
+        }
+        return isWritten;
+    }
+
+}
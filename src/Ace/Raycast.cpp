@@ -15,7 +15,7 @@ namespace ace
     Raycast::Raycast(const Vector2& start, const Vector2& ray) :
         start(start),
         unitDirection(ray.Normalize()),
-        invDirection(unitDirection.Invert())
+        invDirection(1.f / unitDirection.x, 1.f / unitDirection.y)
         // length(ray.Length())
     {
 
@@ -24,7 +24,7 @@ namespace ace
     Raycast::Raycast(const Vector2& start, const Vector2& direction, const float length) :
         start(start),
         unitDirection(direction.Normalize()),
-        invDirection(unitDirection.Invert())
+        invDirection(1.f / unitDirection.x, 1.f / unitDirection.y)
         //length(math::Abs(length))
     {
 
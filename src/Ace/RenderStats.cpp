@@ -0,0 +1,42 @@
+#include <Ace/GraphicsDevice.h>
+#include <Ace/RenderStats.h>
+
+namespace ace
+{
+    // Backend independent, a stub backend counts the same way as OpenGL.
+    static RenderStats s_frameStats;
+    static RenderStats s_lastStats;
+
+    const RenderStats& GraphicsDevice::GetStats()
+    {
+        return s_lastStats;
+    }
+
+    const RenderStats& GraphicsDevice::GetFrameStats()
+    {
+        return s_frameStats;
+    }
+
+    RenderStats& GraphicsDevice::CountStats()
+    {
+        return s_frameStats;
+    }
+
+    void GraphicsDevice::CountDraw(UInt32 vertices, UInt32 indices)
+    {
+        ++s_frameStats.drawCalls;
+        s_frameStats.vertices += vertices;
+        s_frameStats.indices += indices;
+    }
+
+    void GraphicsDevice::CountUpload(UInt32 bytes)
+    {
+        s_frameStats.bytesUploaded += bytes;
+    }
+
+    void GraphicsDevice::EndStatsFrame()
+    {
+        s_lastStats = s_frameStats;
+        s_frameStats = RenderStats();
+    }
+}
@@ -6,6 +6,9 @@
 #include <Ace/SpriteManager.h>
 
 #include <Ace/Platform.h>
+#include <Ace/Profiler.h>
+
+#include <cstring> // std::memcmp
 
 #if ACE_DEBUG
     #include <Ace/Log.h>
@@ -25,11 +28,17 @@ namespace ace
             return;
         }
 
-        entity->transform.model =
+        const Matrix4 model =
            (Matrix4::Scale(entity->transform.scale.x, entity->transform.scale.y, entity->transform.scale.z) *
            entity->transform.rotation.ToMatrix4() *
            Matrix4::Translation(entity->transform.position)) * parentModel;
 
+        if (std::memcmp(model.array, entity->transform.model.array, sizeof(model.array)) != 0)
+        {
+            entity->transform.model = model;
+            ++entity->transform.version;
+        }
+
         const UInt32 count = entity.ChildCount();
         for (UInt32 i = 0u; i < count; ++i)
         {
@@ -74,6 +83,7 @@ namespace ace
 
     void Scene::Update()
     {
+        ACE_PROFILE_SCOPE("Scene::Update");
         ComputeMatrices(*m_root, math::Matrix4::Identity());
     }
 
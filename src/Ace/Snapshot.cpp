@@ -0,0 +1,622 @@
+#include <Ace/Snapshot.h>
+#include <Ace/File.h>
+#include <Ace/Log.h>
+
+#include <algorithm> // std::min
+#include <cstddef> // offsetof
+#include <cstdio>
+#include <cstring> // memcpy, memcmp
+
+namespace ace
+{
+    /**
+        Snapshot layout, little endian:
+
+        SnapshotHeader
+        UInt32 firstChild[entityCount + 1]      Children of entity i are children[firstChild[i] .. firstChild[i + 1]).
+        UInt32 children[childCount]
+        SnapshotTransform transforms[entityCount]
+        Per pool: PoolHeader, UInt32 owners[count], data[dataSize]
+
+        Entities are in depth first order, so children always come after their parent.
+        Every array and blob starts at a multiple of 16 bytes.
+    */
+
+    static const UInt32 SnapshotMagic = 0x53454341u; // "ACES"
+    static const UInt32 DeltaMagic = 0x44454341u; // "ACED"
+    static const UInt32 SnapshotVersion = 1u;
+    static const UInt32 DeltaBlockSize = 64u;
+
+    struct SnapshotHeader
+    {
+        UInt32 magic;
+        UInt32 version;
+        UInt32 entityCount;
+        UInt32 childCount;
+        UInt32 poolCount;
+        UInt32 reserved[3];
+    };
+
+    struct SnapshotTransform
+    {
+        float position[3];
+        float rotation[4];
+        float scale[3];
+    };
+
+    struct PoolHeader
+    {
+        UInt32 hash;
+        UInt32 elementSize;     // 0 for serialized pools.
+        UInt32 count;
+        UInt32 dataSize;
+    };
+
+    struct DeltaHeader
+    {
+        UInt32 magic;
+        UInt32 version;
+        UInt32 baseSize;
+        UInt32 baseHash;
+        UInt32 size;
+        UInt32 runCount;
+        UInt32 reserved[2];
+    };
+
+    // FNV-1a
+    static UInt32 Hash(const UInt8* data, UInt32 size)
+    {
+        UInt32 hash = 2166136261u;
+        for (UInt32 i = 0u; i < size; ++i)
+        {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    std::vector<Snapshot::TypeInfo>& Snapshot::GetTypes()
+    {
+        static std::vector<TypeInfo> types;
+        return types;
+    }
+
+    Snapshot::Writer::Writer(std::vector<UInt8>& data) : m_data(data)
+    {
+
+    }
+
+    void Snapshot::Writer::Write(const void* data, UInt32 size)
+    {
+        const UInt8* bytes = static_cast<const UInt8*>(data);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    void Snapshot::Writer::WriteString(const std::string& string)
+    {
+        Write(static_cast<UInt32>(string.size()));
+        Write(string.data(), static_cast<UInt32>(string.size()));
+    }
+
+    void Snapshot::Writer::Align()
+    {
+        m_data.resize((m_data.size() + 15u) & ~static_cast<size_t>(15u), 0u);
+    }
+
+    UInt32 Snapshot::Writer::Tell() const
+    {
+        return static_cast<UInt32>(m_data.size());
+    }
+
+    void Snapshot::Writer::Patch(UInt32 offset, UInt32 value)
+    {
+        std::memcpy(m_data.data() + offset, &value, sizeof(value));
+    }
+
+    Snapshot::Reader::Reader(const UInt8* data, UInt32 size) : m_data(data), m_size(size), m_offset(0u)
+    {
+
+    }
+
+    bool Snapshot::Reader::Read(void* data, UInt32 size)
+    {
+        const UInt8* source = Skip(size);
+        if (source == nullptr)
+        {
+            return false;
+        }
+        std::memcpy(data, source, size);
+        return true;
+    }
+
+    bool Snapshot::Reader::ReadString(std::string& string)
+    {
+        UInt32 size = 0u;
+        if (!Read(size))
+        {
+            return false;
+        }
+
+        const UInt8* source = Skip(size);
+        if (source == nullptr)
+        {
+            return false;
+        }
+        string.assign(reinterpret_cast<const char*>(source), size);
+        return true;
+    }
+
+    const UInt8* Snapshot::Reader::Skip(UInt32 size)
+    {
+        if (size > m_size - m_offset)
+        {
+            return nullptr;
+        }
+        const UInt8* data = m_data + m_offset;
+        m_offset += size;
+        return data;
+    }
+
+    bool Snapshot::Reader::Align()
+    {
+        const UInt32 aligned = (m_offset + 15u) & ~15u;
+        if (aligned > m_size)
+        {
+            return false;
+        }
+        m_offset = aligned;
+        return true;
+    }
+
+    UInt32 Snapshot::Reader::Tell() const
+    {
+        return m_offset;
+    }
+
+    void Snapshot::AddType(const std::string& name, UInt32 elementSize,
+        void(*save)(UInt32, const Context&, Writer&),
+        bool(*load)(const Context&, const UInt32*, UInt32, const UInt8*, UInt32))
+    {
+        const TypeInfo info{ name, Hash(reinterpret_cast<const UInt8*>(name.data()), static_cast<UInt32>(name.size())), elementSize, save, load };
+
+        for (auto& itr : GetTypes())
+        {
+            if (itr.name == name)
+            {
+                itr = info;
+                return;
+            }
+            if (itr.hash == info.hash)
+            {
+                Logger::LogError("Snapshot: Type names %s and %s collide", itr.name.c_str(), name.c_str());
+                return;
+            }
+        }
+        GetTypes().push_back(info);
+    }
+
+    UInt32 Snapshot::BeginPool(Writer& writer, UInt32 hash, UInt32 elementSize, const std::vector<UInt32>& owners)
+    {
+        const UInt32 header = writer.Tell();
+        const PoolHeader pool{ hash, elementSize, static_cast<UInt32>(owners.size()), 0u };
+        writer.Write(pool);
+        writer.Write(owners.data(), static_cast<UInt32>(owners.size() * sizeof(UInt32)));
+        writer.Align();
+        return header;
+    }
+
+    void Snapshot::EndPool(Writer& writer, UInt32 header, UInt32 dataStart)
+    {
+        writer.Patch(header + offsetof(PoolHeader, dataSize), writer.Tell() - dataStart);
+        writer.Align();
+    }
+
+    void Snapshot::Attach(EntityHandle* entity, EntityManager::ComponentBaseHandle* handle)
+    {
+        entity->PushComponentHandle(handle);
+    }
+
+    void Snapshot::Collect(EntityHandle* entity, std::vector<EntityHandle*>& entities)
+    {
+        entities.push_back(entity);
+        for (const auto child : entity->m_children)
+        {
+            Collect(child, entities);
+        }
+    }
+
+    std::vector<UInt8> Snapshot::Capture(EntityManager& manager)
+    {
+        std::vector<EntityHandle*> entities;
+        entities.reserve(manager.m_entities.size());
+
+        // Depth first from every root of the manager.
+        for (const auto itr : manager.m_entities)
+        {
+            EntityHandle* parent = itr->GetParent();
+            if (parent == nullptr || parent->manager != &manager)
+            {
+                Collect(itr, entities);
+            }
+        }
+        return Write(entities);
+    }
+
+    std::vector<UInt8> Snapshot::Capture(EntityHandle* root)
+    {
+        std::vector<EntityHandle*> entities;
+        if (root != nullptr)
+        {
+            Collect(root, entities);
+            entities.erase(entities.begin());
+        }
+        return Write(entities);
+    }
+
+    std::vector<UInt8> Snapshot::Write(const std::vector<EntityHandle*>& entities)
+    {
+        Context context;
+        context.entities = entities;
+        context.indices.reserve(entities.size());
+        for (UInt32 i = 0u; i < entities.size(); ++i)
+        {
+            context.indices.emplace(entities[i], i);
+        }
+
+        std::vector<UInt32> firstChild;
+        std::vector<UInt32> children;
+        firstChild.reserve(entities.size() + 1u);
+        children.reserve(entities.size());
+
+        for (const auto entity : entities)
+        {
+            firstChild.push_back(static_cast<UInt32>(children.size()));
+            for (const auto child : entity->m_children)
+            {
+                const auto itr = context.indices.find(child);
+                if (itr != context.indices.end())
+                {
+                    children.push_back(itr->second);
+                }
+            }
+        }
+        firstChild.push_back(static_cast<UInt32>(children.size()));
+
+        std::vector<UInt8> data;
+        Writer writer(data);
+
+        SnapshotHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = SnapshotMagic;
+        header.version = SnapshotVersion;
+        header.entityCount = static_cast<UInt32>(entities.size());
+        header.childCount = static_cast<UInt32>(children.size());
+        header.poolCount = static_cast<UInt32>(GetTypes().size());
+        writer.Write(header);
+
+        writer.Write(firstChild.data(), static_cast<UInt32>(firstChild.size() * sizeof(UInt32)));
+        writer.Align();
+        writer.Write(children.data(), static_cast<UInt32>(children.size() * sizeof(UInt32)));
+        writer.Align();
+
+        for (const auto entity : entities)
+        {
+            const Transform& transform = entity->transform;
+            const SnapshotTransform saved{
+                { transform.position.x, transform.position.y, transform.position.z },
+                { transform.rotation.vector.x, transform.rotation.vector.y, transform.rotation.vector.z, transform.rotation.scalar },
+                { transform.scale.x, transform.scale.y, transform.scale.z }
+            };
+            writer.Write(saved);
+        }
+        writer.Align();
+
+        for (const auto& itr : GetTypes())
+        {
+            itr.save(itr.hash, context, writer);
+        }
+        return data;
+    }
+
+    bool Snapshot::Restore(const UInt8* data, UInt32 size, EntityManager& manager, EntityHandle* parent)
+    {
+        Reader reader(data, size);
+
+        SnapshotHeader header;
+        if (!reader.Read(header) || header.magic != SnapshotMagic)
+        {
+            Logger::LogError("Snapshot: Not a snapshot");
+            return false;
+        }
+        if (header.version != SnapshotVersion)
+        {
+            Logger::LogError("Snapshot: Unsupported version %u", header.version);
+            return false;
+        }
+
+        const UInt32 entityCount = header.entityCount;
+        const UInt32* firstChild = nullptr;
+        const UInt32* children = nullptr;
+        const SnapshotTransform* transforms = nullptr;
+
+        // Validate the whole snapshot before creating anything.
+        if (entityCount >= (1u << 28u) || header.childCount >= entityCount + 1u ||
+            (firstChild = reinterpret_cast<const UInt32*>(reader.Skip((entityCount + 1u) * sizeof(UInt32)))) == nullptr || !reader.Align() ||
+            (children = reinterpret_cast<const UInt32*>(reader.Skip(header.childCount * sizeof(UInt32)))) == nullptr || !reader.Align() ||
+            (transforms = reinterpret_cast<const SnapshotTransform*>(reader.Skip(entityCount * sizeof(SnapshotTransform)))) == nullptr || !reader.Align() ||
+            firstChild[0] != 0u || firstChild[entityCount] != header.childCount)
+        {
+            Logger::LogError("Snapshot: Corrupted hierarchy");
+            return false;
+        }
+
+        // A child listed under two parents would be moved by the second AddChild and lose its place.
+        std::vector<bool> hasParent(entityCount, false);
+        for (UInt32 i = 0u; i < entityCount; ++i)
+        {
+            if (firstChild[i] > firstChild[i + 1u])
+            {
+                Logger::LogError("Snapshot: Corrupted hierarchy");
+                return false;
+            }
+
+            // Depth first order, so a child after its parent also rules out cycles.
+            for (UInt32 j = firstChild[i]; j < firstChild[i + 1u]; ++j)
+            {
+                if (children[j] <= i || children[j] >= entityCount || hasParent[children[j]])
+                {
+                    Logger::LogError("Snapshot: Corrupted hierarchy");
+                    return false;
+                }
+                hasParent[children[j]] = true;
+            }
+        }
+
+        struct PoolRange
+        {
+            const TypeInfo* type;
+            const UInt32* owners;
+            const UInt8* data;
+            UInt32 count;
+            UInt32 size;
+        };
+
+        std::vector<PoolRange> pools;
+        pools.reserve(header.poolCount);
+
+        for (UInt32 i = 0u; i < header.poolCount; ++i)
+        {
+            PoolHeader pool;
+            PoolRange range;
+
+            if (!reader.Read(pool) || pool.count > size / sizeof(UInt32) ||
+                (range.owners = reinterpret_cast<const UInt32*>(reader.Skip(pool.count * sizeof(UInt32)))) == nullptr || !reader.Align() ||
+                (range.data = reader.Skip(pool.dataSize)) == nullptr || !reader.Align())
+            {
+                Logger::LogError("Snapshot: Corrupted component pool %u", i);
+                return false;
+            }
+
+            range.type = nullptr;
+            range.count = pool.count;
+            range.size = pool.dataSize;
+
+            for (const auto& itr : GetTypes())
+            {
+                if (itr.hash == pool.hash)
+                {
+                    range.type = &itr;
+                }
+            }
+
+            if (range.type == nullptr)
+            {
+                Logger::LogError("Snapshot: Skipping unregistered component type %08x", pool.hash);
+                continue;
+            }
+
+            if (range.type->elementSize != pool.elementSize)
+            {
+                Logger::LogError("Snapshot: Component %s changed size or serialization", range.type->name.c_str());
+                return false;
+            }
+
+            // Plain pools are loaded with a single copy, their data must hold exactly count elements.
+            if (pool.elementSize != 0u && (pool.dataSize % pool.elementSize != 0u || pool.dataSize / pool.elementSize != pool.count))
+            {
+                Logger::LogError("Snapshot: Corrupted component pool %s", range.type->name.c_str());
+                return false;
+            }
+
+            for (UInt32 j = 0u; j < pool.count; ++j)
+            {
+                if (range.owners[j] >= entityCount)
+                {
+                    Logger::LogError("Snapshot: Corrupted component pool %s", range.type->name.c_str());
+                    return false;
+                }
+            }
+            pools.push_back(range);
+        }
+
+        Context context;
+        context.entities.reserve(entityCount);
+        const size_t firstEntity = manager.m_entities.size();
+        manager.m_entities.reserve(firstEntity + entityCount);
+
+        for (UInt32 i = 0u; i < entityCount; ++i)
+        {
+            EntityHandle* entity = manager.CreateEntity();
+            const SnapshotTransform& saved = transforms[i];
+
+            entity->transform.position = Vector3(saved.position[0], saved.position[1], saved.position[2]);
+            entity->transform.rotation.vector = Vector3(saved.rotation[0], saved.rotation[1], saved.rotation[2]);
+            entity->transform.rotation.scalar = saved.rotation[3];
+            entity->transform.scale = Vector3(saved.scale[0], saved.scale[1], saved.scale[2]);
+            context.entities.push_back(entity);
+        }
+
+        for (UInt32 i = 0u; i < entityCount; ++i)
+        {
+            // AddChild pushes to the front, reverse keeps the saved order.
+            for (UInt32 j = firstChild[i + 1u]; j-- > firstChild[i];)
+            {
+                context.entities[i]->AddChild(context.entities[children[j]]);
+            }
+        }
+
+        for (const auto& itr : pools)
+        {
+            if (!itr.type->load(context, itr.owners, itr.count, itr.data, itr.size))
+            {
+                // A serializer rejected its data. Nothing is left half restored, the entities are destroyed
+                // along with the components already loaded, before any of them is given to parent.
+                Logger::LogError("Snapshot: Failed to load component %s", itr.type->name.c_str());
+                for (EntityHandle* entity : context.entities)
+                {
+                    entity->DestroyComponents();
+                    delete entity;
+                }
+                manager.m_entities.erase(manager.m_entities.begin() + firstEntity, manager.m_entities.begin() + firstEntity + entityCount);
+                return false;
+            }
+        }
+
+        if (parent != nullptr)
+        {
+            for (UInt32 i = entityCount; i-- > 0u;)
+            {
+                if (!hasParent[i])
+                {
+                    parent->AddChild(context.entities[i]);
+                }
+            }
+        }
+        return true;
+    }
+
+    bool Snapshot::Restore(const UInt8* data, UInt32 size, EntityManager& manager)
+    {
+        return Restore(data, size, manager, nullptr);
+    }
+
+    bool Snapshot::Restore(const UInt8* data, UInt32 size, EntityHandle* parent)
+    {
+        return Restore(data, size, parent ? *parent->manager : EntityManager::DefaultManager(), parent);
+    }
+
+    bool Snapshot::Save(const Path& path, const std::vector<UInt8>& data)
+    {
+        std::FILE* file = std::fopen(path.GetPath().c_str(), "wb");
+        if (file == nullptr)
+        {
+            Logger::LogError("Snapshot: Failed to open %s for writing", path.GetPath().c_str());
+            return false;
+        }
+
+        const bool written = std::fwrite(data.data(), 1u, data.size(), file) == data.size();
+        return std::fclose(file) == 0 && written;
+    }
+
+    bool Snapshot::Load(const Path& path, EntityHandle* parent)
+    {
+        const File::View view = File(path).Map();
+        return view && Restore(view.Get(), view.size, parent);
+    }
+
+    bool Snapshot::Load(const Path& deltaPath, const Path& basePath, EntityHandle* parent)
+    {
+        const File::View delta = File(deltaPath).Map();
+        const File::View base = File(basePath).Map();
+
+        std::vector<UInt8> snapshot;
+        return delta && base &&
+            Patch(base.Get(), base.size, delta.Get(), delta.size, snapshot) &&
+            Restore(snapshot.data(), static_cast<UInt32>(snapshot.size()), parent);
+    }
+
+    std::vector<UInt8> Snapshot::Diff(const std::vector<UInt8>& base, const std::vector<UInt8>& current)
+    {
+        std::vector<UInt8> data;
+        Writer writer(data);
+
+        DeltaHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = DeltaMagic;
+        header.version = SnapshotVersion;
+        header.baseSize = static_cast<UInt32>(base.size());
+        header.baseHash = Hash(base.data(), header.baseSize);
+        header.size = static_cast<UInt32>(current.size());
+        writer.Write(header);
+
+        const UInt32 size = header.size;
+        UInt32 offset = 0u;
+
+        while (offset < size)
+        {
+            // Skip unchanged blocks.
+            const auto isChanged = [&](const UInt32 block)
+            {
+                const UInt32 length = std::min(DeltaBlockSize, size - block);
+                return block + length > base.size() || std::memcmp(base.data() + block, current.data() + block, length) != 0;
+            };
+
+            if (!isChanged(offset))
+            {
+                offset += DeltaBlockSize;
+                continue;
+            }
+
+            UInt32 end = offset + DeltaBlockSize;
+            while (end < size && isChanged(end))
+            {
+                end += DeltaBlockSize;
+            }
+            end = std::min(end, size);
+
+            writer.Write(offset);
+            writer.Write(end - offset);
+            writer.Write(current.data() + offset, end - offset);
+            ++header.runCount;
+            offset = end;
+        }
+
+        writer.Patch(offsetof(DeltaHeader, runCount), header.runCount);
+        return data;
+    }
+
+    bool Snapshot::Patch(const UInt8* base, UInt32 baseSize, const UInt8* delta, UInt32 deltaSize, std::vector<UInt8>& result)
+    {
+        Reader reader(delta, deltaSize);
+
+        DeltaHeader header;
+        if (!reader.Read(header) || header.magic != DeltaMagic || header.version != SnapshotVersion)
+        {
+            Logger::LogError("Snapshot: Not a delta");
+            return false;
+        }
+
+        if (header.baseSize != baseSize || header.baseHash != Hash(base, baseSize))
+        {
+            Logger::LogError("Snapshot: Delta was made from a different base");
+            return false;
+        }
+
+        result.assign(base, base + std::min(baseSize, header.size));
+        result.resize(header.size, 0u);
+
+        for (UInt32 i = 0u; i < header.runCount; ++i)
+        {
+            UInt32 offset = 0u, length = 0u;
+            const UInt8* run = nullptr;
+
+            if (!reader.Read(offset) || !reader.Read(length) || (run = reader.Skip(length)) == nullptr ||
+                offset > header.size || length > header.size - offset)
+            {
+                Logger::LogError("Snapshot: Corrupted delta");
+                return false;
+            }
+            std::memcpy(result.data() + offset, run, length);
+        }
+        return true;
+    }
+}
@@ -8,6 +8,7 @@
 #include <Ace/EntityManager.h>
 #include <Ace/GraphicsDevice.h>
 #include <Ace/Math.h>
+#include <Ace/Profiler.h>
 #include <Ace/Transform.h>
 
 #include <algorithm>
@@ -92,6 +93,7 @@ namespace ace
 
     void SpriteManager::DrawImpl(const Scene& scene, const Camera& camera, const Material* customMaterial)
     {
+        ACE_PROFILE_SCOPE("SpriteManager::DrawImpl");
         static const UInt32 maxCount = 64u;
         std::vector<Group> groups(Sort(scene));
 
@@ -99,6 +101,8 @@ namespace ace
         for (const auto& itr : groups)
             count += (itr.end - itr.start);
 
+        GraphicsDevice::CountStats().spritesBatched += count;
+
         //Checks and grows m_indexTable if needed
         HandleIndices(count);
 
@@ -129,7 +133,8 @@ namespace ace
             {
                 const UInt32 elementsCount = 64u < (indexCount - (i * 64u)) ? 64u : (indexCount - (i * 64u));
                 GraphicsDevice::SetMaterial(GetTargetMaterial(customMaterial ? *customMaterial : itr.material, camera, 64u * i, elementsCount));
-                GraphicsDevice::Draw( 0u, elementsCount * 6u, m_indexTable + (elementsCount * 6u * i)); //  + (i * maxCount)
+                // Indexed, the vertex count only feeds RenderStats.
+                GraphicsDevice::Draw(elementsCount * 4u, elementsCount * 6u, m_indexTable + (elementsCount * 6u * i)); //  + (i * maxCount)
             }
 
            // const UInt32 index6 = indexCount * 6u;
@@ -199,6 +204,8 @@ namespace ace
 
     std::vector<SpriteManager::Group> SpriteManager::Sort(const Scene& scene)
     {
+        ACE_PROFILE_SCOPE("SpriteManager::Sort");
+
         //Temp storage
         std::vector<EntityManager::EntityHandle*> handles;
         std::vector<Sprite> sprites;
@@ -257,6 +264,10 @@ namespace ace
                     matrix.emplace_back(e->transform.model);
                     handles.emplace_back(e);
                 }
+                else
+                {
+                    ++GraphicsDevice::CountStats().spritesCulled;
+                }
             }
         }
 
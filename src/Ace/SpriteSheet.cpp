@@ -1,10 +1,40 @@
 #include <Ace/SpriteSheet.h>
+#include <Ace/AssetCache.h>
 #include <Ace/Path.h>
-#include <Ace/Json.h>
 #include <Ace/Assert.h>
+#include <Ace/Log.h>
+
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+#include <cstring> // memchr, memcmp, strcmp
 
 namespace ace
 {
+	static const UInt32 InvalidSprite = ~0u;
+
+	// FNV-1a
+	static UInt32 HashName(const char* name, UInt32 length)
+	{
+		UInt32 hash = 2166136261u;
+		for (UInt32 i = 0u; i < length; ++i)
+		{
+			hash = (hash ^ static_cast<UInt8>(name[i])) * 16777619u;
+		}
+		return hash;
+	}
+
+	static void Insert(std::vector<UInt32>& buckets, UInt32 hash, UInt32 value)
+	{
+		const UInt32 mask = static_cast<UInt32>(buckets.size()) - 1u;
+		UInt32 i = hash & mask;
+		while (buckets[i] != 0u)
+		{
+			i = (i + 1u) & mask;
+		}
+		buckets[i] = value;
+	}
+
 	inline std::string ParsePath(const char* path)
 	{
 		UInt16 fileTypePos = 0;
@@ -35,53 +65,179 @@ namespace ace
 
     }
 
-	SpriteSheet::SpriteSheet(const Path& path) : image(nullptr, 0, 0, PixelFormat::Unknown)
+	// Reads the packer/sprites schema straight into the sheet, without building a DOM.
+	struct SpriteSheet::Parser : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, SpriteSheet::Parser>
 	{
-		Json Jameson;
-		std::string jsonName = path.GetPath();
+		enum class Section { None, Packer, Sprites };
+		enum Field { Name = 1 << 0, X = 1 << 1, Y = 1 << 2, W = 1 << 3, H = 1 << 4, FileName = 1 << 5, NoField = 0 };
+
+		SpriteSheet& sheet;
+		std::string fileName;
+
+		Int32 depth;
+		Section section;
+		Field field;
 
-		if (Jameson.Parse(path))
+		UInt32 fields;
+		std::string name;
+		Rect location;
+		UInt32 skipped;
+
+		Parser(SpriteSheet& sheet) :
+			sheet(sheet), fileName(), depth(0), section(Section::None), field(NoField),
+			fields(0u), name(), location(), skipped(0u)
 		{
-			SpriteData Data;
 
-			auto root = Jameson.document.GetObject();
-			ACE_ASSERT(root.HasMember("packer"), "Jsonfile does not have a member: packer", jsonName);
-			ACE_ASSERT(root["packer"].HasMember("filename"), "Packer does not have a member: filename", jsonName);
-			ACE_ASSERT(root.HasMember("sprites"), "Jsonfile does not have a member: sprites", jsonName);
+		}
 
-			const char* fileName = root["packer"]["filename"].GetString();
-			ACE_ASSERT(fileName != nullptr, "Jsonfile does not have valid name %s", jsonName);
-			
-			auto spritecount = root["sprites"].Size();
+		bool Key(const char* key, rapidjson::SizeType length, bool)
+		{
+			field = NoField;
 
-			std::string path = ParsePath(jsonName.c_str());
-			File imageFile(Path(path + fileName, true));
-			image = Image(imageFile);
-			
-			for (int i = 0; i < spritecount; ++i)
+			if (depth == 1)
+			{
+				section = std::strcmp(key, "packer") == 0 ? Section::Packer :
+					std::strcmp(key, "sprites") == 0 ? Section::Sprites : Section::None;
+			}
+			else if (depth == 2 && section == Section::Packer)
+			{
+				field = std::strcmp(key, "filename") == 0 ? FileName : NoField;
+			}
+			else if (depth == 3 && section == Section::Sprites && length == 1u)
 			{
-				ACE_ASSERT(root["sprites"][i].HasMember("name"), "Sprites does not have a member: name", jsonName);
-				ACE_ASSERT(root["sprites"][i].HasMember("x"), "Sprites does not have a member: x", jsonName);
-				ACE_ASSERT(root["sprites"][i].HasMember("y"), "Sprites does not have a member: y", jsonName);
-				ACE_ASSERT(root["sprites"][i].HasMember("w"), "Sprites does not have a member: w", jsonName);
-				ACE_ASSERT(root["sprites"][i].HasMember("h"), "Sprites does not have a member: h", jsonName);
-
-
-
-				const char* spriteName = root["sprites"][i]["name"].GetString();
-				ACE_ASSERT(spriteName != nullptr, "Sprite does not have valid name %s", jsonName);
-			
-				float x = root["sprites"][i]["x"].GetUint();
-				float y = root["sprites"][i]["y"].GetUint();
-				float w = root["sprites"][i]["w"].GetUint();
-				float h = root["sprites"][i]["h"].GetUint();
-					
-                AddSprite(spriteName, Rect(x, y, w, h));
+				field = key[0] == 'x' ? X : key[0] == 'y' ? Y : key[0] == 'w' ? W : key[0] == 'h' ? H : NoField;
 			}
+			else if (depth == 3 && section == Section::Sprites)
+			{
+				field = std::strcmp(key, "name") == 0 ? Name : NoField;
+			}
+			return true;
+		}
+
+		bool String(const char* string, rapidjson::SizeType length, bool)
+		{
+			if (field == FileName)
+			{
+				fileName.assign(string, length);
+			}
+			else if (field == Name)
+			{
+				name.assign(string, length);
+				fields |= Name;
+			}
+			field = NoField;
+			return true;
+		}
+
+		bool Number(const float value)
+		{
+			switch (field)
+			{
+			case X: location.x = value; break;
+			case Y: location.y = value; break;
+			case W: location.width = value; break;
+			case H: location.height = value; break;
+			default: break;
+			}
+			fields |= field;
+			field = NoField;
+			return true;
+		}
+
+		bool Int(int value) { return Number(static_cast<float>(value)); }
+		bool Uint(unsigned value) { return Number(static_cast<float>(value)); }
+		bool Int64(int64_t value) { return Number(static_cast<float>(value)); }
+		bool Uint64(uint64_t value) { return Number(static_cast<float>(value)); }
+		bool Double(double value) { return Number(static_cast<float>(value)); }
+
+		bool StartObject()
+		{
+			if (++depth == 3 && section == Section::Sprites)
+			{
+				fields = 0u;
+			}
+			field = NoField;
+			return true;
+		}
+
+		bool EndObject(rapidjson::SizeType)
+		{
+			if (depth == 3 && section == Section::Sprites)
+			{
+				if (fields == (Name | X | Y | W | H))
+				{
+					sheet.AddSprite(name.c_str(), static_cast<UInt32>(name.size()), location);
+				}
+				else
+				{
+					++skipped;
+				}
+			}
+			--depth;
+			return true;
+		}
+
+		bool StartArray()
+		{
+			++depth;
+			field = NoField;
+			return true;
+		}
+
+		bool EndArray(rapidjson::SizeType)
+		{
+			--depth;
+			return true;
+		}
+	};
+
+	SpriteSheet::SpriteSheet(const Path& path) : image(nullptr, 0, 0, PixelFormat::Unknown)
+	{
+		const std::string jsonName = path.GetPath();
+		const File::View view = File(path).Map();
+		const char* json = reinterpret_cast<const char*>(view.Get());
+
+		if (!view)
+		{
+			Logger::LogError("SpriteSheet: Failed to open %s", jsonName.c_str());
+			return;
+		}
+
+		// Every sprite is an object, so this is an upper bound for the sprite count.
+		UInt32 objects = 0u;
+		for (const char* itr = json; (itr = static_cast<const char*>(std::memchr(itr, '{', json + view.size - itr))) != nullptr; ++itr)
+		{
+			++objects;
+		}
+		Reserve(objects, view.size / 4u);
+
+		Parser parser(*this);
+		rapidjson::MemoryStream stream(json, view.size);
+		rapidjson::Reader reader;
+
+		if (reader.Parse(stream, parser).IsError())
+		{
+			Logger::LogError("SpriteSheet: Failed to parse %s at %u", jsonName.c_str(), static_cast<UInt32>(reader.GetErrorOffset()));
+			return;
+		}
+
+		if (parser.fileName.empty())
+		{
+			Logger::LogError("SpriteSheet: Missing packer filename in %s", jsonName.c_str());
+			return;
+		}
+
+		if (parser.skipped > 0u)
+		{
+			Logger::LogError("SpriteSheet: Skipped %u sprites without name, x, y, w or h in %s", parser.skipped, jsonName.c_str());
 		}
-		else
+
+		image = *AssetCache::Get<Image>(Path(ParsePath(jsonName.c_str()) + parser.fileName, true));
+
+		// Sprites can come before the packer, so texture coordinates are only known now.
+		for (auto& itr : sprites)
 		{
-			//TODO: Error jos json menee mnkn
+			UpdateTexcoord(itr);
 		}
 	}
 
@@ -90,42 +246,108 @@ namespace ace
 
 	}
 
-    void SpriteSheet::AddSprite(std::string name, const Rect& location)
+    void SpriteSheet::AddSprite(const std::string& name, const Rect& location)
     {
-        SpriteData data{ name, location };
-        data.texcoord = Rect(location.x / image.w, location.y / image.h, location.width / image.w, location.height / image.h);
-        sprites.push_back(data);
+        AddSprite(name.c_str(), static_cast<UInt32>(name.size()), location);
+        UpdateTexcoord(sprites.back());
     }
 
-	UInt32 SpriteSheet::GetSpriteCount() const
+	void SpriteSheet::Reserve(UInt32 count, UInt32 nameBytes)
 	{
-		return sprites.size();
+		sprites.reserve(count);
+		m_names.reserve(nameBytes);
+
+		UInt32 bucketCount = 16u;
+		while (bucketCount < count * 2u)
+		{
+			bucketCount <<= 1u;
+		}
+		if (bucketCount > m_buckets.size())
+		{
+			Rehash(bucketCount);
+		}
 	}
 
-	const SpriteSheet::SpriteData* SpriteSheet::GetSprite(const std::string& Spritename) const
+	void SpriteSheet::AddSprite(const char* name, UInt32 length, const Rect& location)
 	{
-		for (const auto& itr : sprites)
+		SpriteData data;
+		data.nameOffset = static_cast<UInt32>(m_names.size());
+		data.nameLength = length;
+		data.nameHash = HashName(name, length);
+		data.location = location;
+		data.texcoord = Rect();
+
+		m_names.append(name, length);
+		sprites.push_back(data);
+
+		// Keep the table at most half full.
+		if (sprites.size() * 2u > m_buckets.size())
+		{
+			Rehash(m_buckets.empty() ? 16u : static_cast<UInt32>(m_buckets.size()) * 2u);
+			return;
+		}
+
+		// Duplicate names keep resolving to the first sprite.
+		if (FindSprite(name, length) == InvalidSprite)
 		{
-			if (Spritename == itr.SpriteName)
+			Insert(m_buckets, data.nameHash, static_cast<UInt32>(sprites.size()));
+		}
+	}
+
+	void SpriteSheet::UpdateTexcoord(SpriteData& sprite) const
+	{
+		const Rect& location = sprite.location;
+		sprite.texcoord = Rect(location.x / image.w, location.y / image.h, location.width / image.w, location.height / image.h);
+	}
+
+	UInt32 SpriteSheet::FindSprite(const char* name, UInt32 length) const
+	{
+		if (m_buckets.empty())
+		{
+			return InvalidSprite;
+		}
+
+		const UInt32 hash = HashName(name, length);
+		const UInt32 mask = static_cast<UInt32>(m_buckets.size()) - 1u;
+
+		for (UInt32 i = hash & mask; m_buckets[i] != 0u; i = (i + 1u) & mask)
+		{
+			const SpriteData& sprite = sprites[m_buckets[i] - 1u];
+			if (sprite.nameHash == hash && sprite.nameLength == length && std::memcmp(m_names.data() + sprite.nameOffset, name, length) == 0)
 			{
-				return &itr;
+				return m_buckets[i] - 1u;
 			}
 		}
-
-		return nullptr;
+		return InvalidSprite;
 	}
 
-	SpriteSheet::SpriteData* SpriteSheet::GetSprite(const std::string& Spritename)
+	void SpriteSheet::Rehash(UInt32 bucketCount)
 	{
-		for (auto& itr : sprites)
+		m_buckets.assign(bucketCount, 0u);
+
+		for (UInt32 i = 0u; i < sprites.size(); ++i)
 		{
-			if (Spritename == itr.SpriteName)
+			const SpriteData& sprite = sprites[i];
+			if (FindSprite(m_names.data() + sprite.nameOffset, sprite.nameLength) == InvalidSprite)
 			{
-				return &itr;
+				Insert(m_buckets, sprite.nameHash, i + 1u);
 			}
 		}
+	}
 
-		return nullptr;
+	UInt32 SpriteSheet::GetSpriteCount() const
+	{
+		return sprites.size();
+	}
+
+	const SpriteSheet::SpriteData* SpriteSheet::GetSprite(const std::string& Spritename) const
+	{
+		return GetSprite(FindSprite(Spritename.c_str(), static_cast<UInt32>(Spritename.size())));
+	}
+
+	SpriteSheet::SpriteData* SpriteSheet::GetSprite(const std::string& Spritename)
+	{
+		return GetSprite(FindSprite(Spritename.c_str(), static_cast<UInt32>(Spritename.size())));
 	}
 
 	const SpriteSheet::SpriteData* SpriteSheet::GetSprite(UInt32 index) const
@@ -149,4 +371,9 @@ namespace ace
 
 		return nullptr;
 	}
+
+	std::string SpriteSheet::GetSpriteName(const SpriteData& sprite) const
+	{
+		return m_names.substr(sprite.nameOffset, sprite.nameLength);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <Ace/TextBatch.h>
+#include <Ace/GraphicsDevice.h>
+#include <Ace/Math.h>
+
+namespace ace
+{
+    TextBatch::TextBatch(GlyphAtlas& atlas) :
+        m_atlas(atlas),
+        m_buffer(GraphicsDevice::CreateBuffer(BufferType::Vertex))
+    {
+
+    }
+
+    void TextBatch::Add(const char* text, const Vector2& position, const float pixelHeight, const Color32& color)
+    {
+        const Font& font = m_atlas.GetFont();
+        const float lineHeight = font.GetLineHeight(pixelHeight);
+        const float invWidth = 1.f / m_atlas.GetWidth();
+        const float invHeight = 1.f / m_atlas.GetHeight();
+
+        // Distance fields are scaled from one size, coverage glyphs are used as is.
+        const bool isField = m_atlas.GetMode() == GlyphMode::DistanceField;
+        const float glyphScale = m_atlas.GetGlyphScale(pixelHeight);
+
+        // Half of the field value change across one pixel, TextMaterial blends the edge over it.
+        const float smoothing = isField ? 0.5f * m_atlas.GetFieldGradient() / glyphScale : 0.f;
+
+        float x = position.x;
+        float baseline = position.y - font.GetAscent(pixelHeight);
+        UInt32 previous = 0u;
+
+        while (const UInt32 codepoint = Font::DecodeUTF8(text))
+        {
+            if (codepoint == '\n')
+            {
+                x = position.x;
+                baseline -= lineHeight;
+                previous = 0u;
+                continue;
+            }
+
+            if (previous != 0u)
+            {
+                x += font.GetKerning(previous, codepoint, pixelHeight);
+            }
+            previous = codepoint;
+
+            const Glyph* glyph = m_atlas.GetGlyph(codepoint, pixelHeight);
+            if (glyph == nullptr)
+            {
+                continue;
+            }
+
+            if (glyph->w != 0u && glyph->h != 0u)
+            {
+                float left = x + glyph->xoff * glyphScale;
+                float top = baseline - glyph->yoff * glyphScale;
+
+                if (!isField)
+                {
+                    // Snapped to whole pixels, glyphs are rasterized at pixel centers.
+                    left = math::Floor(left + 0.5f);
+                    top = math::Floor(baseline + 0.5f) - glyph->yoff;
+                }
+
+                const float right = left + glyph->w * glyphScale;
+                const float bottom = top - glyph->h * glyphScale;
+
+                const float u0 = glyph->x * invWidth;
+                const float u1 = (glyph->x + glyph->w) * invWidth;
+                const float v0 = glyph->y * invHeight;
+                const float v1 = (glyph->y + glyph->h) * invHeight;
+
+                // Two counter-clockwise triangles.
+                const Vertex quad[6] = {
+                    { Vector4(left, bottom, 0, smoothing), Vector2(u0, v1), color },
+                    { Vector4(right, bottom, 0, smoothing), Vector2(u1, v1), color },
+                    { Vector4(right, top, 0, smoothing), Vector2(u1, v0), color },
+                    { Vector4(left, bottom, 0, smoothing), Vector2(u0, v1), color },
+                    { Vector4(right, top, 0, smoothing), Vector2(u1, v0), color },
+                    { Vector4(left, top, 0, smoothing), Vector2(u0, v0), color },
+                };
+                m_vertices.insert(m_vertices.end(), quad, quad + 6);
+            }
+
+            x += glyph->xadvance * glyphScale;
+        }
+    }
+
+    Vector2 TextBatch::Measure(const char* text, const float pixelHeight)
+    {
+        const Font& font = m_atlas.GetFont();
+        const float lineHeight = font.GetLineHeight(pixelHeight);
+
+        float x = 0.f, width = 0.f, height = lineHeight;
+        UInt32 previous = 0u;
+
+        while (const UInt32 codepoint = Font::DecodeUTF8(text))
+        {
+            if (codepoint == '\n')
+            {
+                width = math::Max(width, x);
+                x = 0.f;
+                height += lineHeight;
+                previous = 0u;
+                continue;
+            }
+
+            if (previous != 0u)
+            {
+                x += font.GetKerning(previous, codepoint, pixelHeight);
+            }
+            previous = codepoint;
+
+            if (const Glyph* glyph = m_atlas.GetGlyph(codepoint, pixelHeight))
+            {
+                x += glyph->xadvance * m_atlas.GetGlyphScale(pixelHeight);
+            }
+        }
+        return Vector2(math::Max(width, x), height);
+    }
+
+    void TextBatch::Clear()
+    {
+        m_vertices.clear();
+    }
+
+    void TextBatch::Draw(TextMaterial& material)
+    {
+        if (m_vertices.empty())
+        {
+            return;
+        }
+
+        m_atlas.Update();
+        material->glyphs = m_atlas.GetTexture();
+
+        const UInt32 count = static_cast<UInt32>(m_vertices.size());
+        GraphicsDevice::BufferData(m_buffer, count, m_vertices.data(), BufferUsage::Streaming);
+        GraphicsDevice::SetMaterial(material);
+        GraphicsDevice::Draw(m_buffer, count, 0u);
+    }
+
+    UInt32 TextBatch::GetVertexCount() const
+    {
+        return static_cast<UInt32>(m_vertices.size());
+    }
+
+    const std::vector<Vertex>& TextBatch::GetVertices() const
+    {
+        return m_vertices;
+    }
+
+}
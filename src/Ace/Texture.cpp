@@ -1,5 +1,7 @@
 #include <Ace/Texture.h>
 #include <Ace/GraphicsDevice.h>
+#include <Ace/Log.h>
+#include <Ace/TextureFormat.h>
 
 namespace ace
 {
@@ -13,6 +15,11 @@ namespace ace
 		Create(image);
 	}
 
+	Texture::Texture(const File& file) : Graphics(nullptr), size(), scale(1)
+	{
+		Create(file);
+	}
+
 	Texture::~Texture()
 	{
 
@@ -23,6 +30,79 @@ namespace ace
 		return Create(image.GetPixelData(), image.w, image.h, image.format, image.scale);
 	}
 
+	bool Texture::Create(const File& file)
+	{
+		const File::View view = file.Map();
+		const UInt8* data = view.Get();
+
+		if (view.size < sizeof(TextureFileHeader) || reinterpret_cast<const TextureFileHeader*>(data)->magic != TextureFileMagic)
+		{
+			return Create(Image(file));
+		}
+
+		const TextureFileHeader& header = *reinterpret_cast<const TextureFileHeader*>(data);
+		const TextureFileLevel* levels = reinterpret_cast<const TextureFileLevel*>(data + sizeof(TextureFileHeader));
+		const std::string path = file.path.GetPath();
+
+		if (header.version != TextureFileVersion || header.compression != TextureUncompressed)
+		{
+			Logger::LogError("Texture: Unsupported version or compression: %s", path.c_str());
+			return false;
+		}
+
+		const PixelFormat format = static_cast<PixelFormat>(header.format);
+		const UInt32 bytesPerPixel = header.format;
+
+		if (format < PixelFormat::R || format > PixelFormat::RGBA || header.levelCount == 0u || header.levelCount > TextureFileMaxLevels ||
+			sizeof(TextureFileHeader) + header.levelCount * sizeof(TextureFileLevel) > view.size)
+		{
+			Logger::LogError("Texture: Corrupted header: %s", path.c_str());
+			return false;
+		}
+
+		// Bounds are checked as a > size || b > size - a, sums of untrusted fields may wrap.
+		// Pixel counts in unsigned long long, UInt64 is only 32 bits wide on some platforms.
+		UInt32 width = header.width;
+		UInt32 height = header.height;
+		for (UInt32 i = 0u; i < header.levelCount; ++i)
+		{
+			const TextureFileLevel& level = levels[i];
+			// Sized as the previous level halved, and nothing follows a 1x1 level.
+			if (level.width == 0u || level.height == 0u || level.width != width || level.height != height ||
+				(i != 0u && levels[i - 1u].width == 1u && levels[i - 1u].height == 1u) ||
+				level.offset > view.size || level.size > view.size - level.offset ||
+				level.size < static_cast<unsigned long long>(level.width) * level.height * bytesPerPixel)
+			{
+				Logger::LogError("Texture: Corrupted level %u: %s", i, path.c_str());
+				return false;
+			}
+
+			width = width > 1u ? width >> 1u : 1u;
+			height = height > 1u ? height >> 1u : 1u;
+		}
+
+		if (!(*this) && !(*this = GraphicsDevice::CreateTexture()))
+		{
+			return false;
+		}
+
+		flags.minFiltering = static_cast<FilteringModes>(header.minFiltering);
+		flags.magFiltering = static_cast<FilteringModes>(header.magFiltering);
+		flags.wrapModes = static_cast<WrapModes>(header.wrapModes);
+		// A single level with mipmap filtering would leave the texture incomplete.
+		flags.mipmaps = header.mipmaps != 0u && header.levelCount > 1u;
+
+		for (UInt32 i = 0u; i < header.levelCount; ++i)
+		{
+			GraphicsDevice::UpdateTexture(*this, data + levels[i].offset, levels[i].width, levels[i].height, format, i);
+		}
+
+		scale = header.scale;
+		size.x = header.width;
+		size.y = header.height;
+		return true;
+	}
+
 	bool Texture::Create(const UInt8* pixels, UInt32 w, UInt32 h, PixelFormat format, float pixelScale)
 	{
 		if (!(*this) && !(*this = GraphicsDevice::CreateTexture()))
@@ -36,4 +116,11 @@ namespace ace
         size.y = h;
 		return true;
 	}
+
+	bool Texture::IsBaked(const Path& path)
+	{
+		static const std::string extension(".acetex");
+		const std::string full = path.GetPath();
+		return full.size() > extension.size() && full.compare(full.size() - extension.size(), extension.size(), extension) == 0;
+	}
 }
\ No newline at end of file
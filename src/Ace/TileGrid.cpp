@@ -0,0 +1,356 @@
+#include <Ace/TileGrid.h>
+
+#include <Ace/Log.h>
+#include <Ace/Math.h>
+
+#include <algorithm> // std::min, std::max, std::swap
+#include <limits> // numeric_limits::max()
+
+namespace ace
+{
+
+    // Keeps touching edges from counting as overlap, in cell units.
+    static const float CellEpsilon = 1e-4f;
+
+    static inline Int32 FloorToInt(const float value)
+    {
+        return static_cast<Int32>(math::Floor(value));
+    }
+
+    static inline Int32 CeilToInt(const float value)
+    {
+        return static_cast<Int32>(math::Ceil(value));
+    }
+
+    TileGrid::Hit::Hit() :
+        position(), normal(), distance(0.f), x(0), y(0)
+    {
+
+    }
+
+    TileGrid::TileGrid() :
+        TileGrid(0u, 0u, Vector2(), 1.f)
+    {
+
+    }
+
+    TileGrid::TileGrid(const UInt32 width, const UInt32 height, const Vector2& origin, const float cellSize) :
+        m_bits(),
+        m_width(0u),
+        m_height(0u),
+        m_stride(0u),
+        m_origin(),
+        m_cellSize(1.f),
+        m_inverseCellSize(1.f)
+    {
+        Reset(width, height, origin, cellSize);
+    }
+
+    void TileGrid::Reset(const UInt32 width, const UInt32 height, const Vector2& origin, const float cellSize)
+    {
+        if (math::IsNearEpsilon(cellSize) || cellSize < 0.f)
+        {
+            Logger::LogError("TileGrid: Invalid cell size: %f", cellSize);
+            return;
+        }
+
+        m_width = width;
+        m_height = height;
+        m_stride = (width + 31u) >> 5u;
+        m_origin = origin;
+        m_cellSize = cellSize;
+        m_inverseCellSize = 1.f / cellSize;
+        m_bits.assign(m_stride * m_height, 0u);
+    }
+
+    void TileGrid::SetSolid(const Int32 x, const Int32 y, const bool solid)
+    {
+        if (!IsInside(x, y))
+        {
+            return;
+        }
+
+        if (solid)
+        {
+            m_bits[Word(x, y)] |= Bit(x);
+        }
+        else
+        {
+            m_bits[Word(x, y)] &= ~Bit(x);
+        }
+    }
+
+    bool TileGrid::IsRowSolid(const Int32 y, Int32 x0, Int32 x1) const
+    {
+        x0 = std::max(x0, 0);
+        x1 = std::min(x1, static_cast<Int32>(m_width) - 1);
+
+        if (x0 > x1 || static_cast<UInt32>(y) >= m_height)
+        {
+            return false;
+        }
+
+        // 32 cells per comparison, partial words are masked.
+        const UInt32* row = &m_bits[y * m_stride];
+        const Int32 first = x0 >> 5;
+        const Int32 last = x1 >> 5;
+        for (Int32 word = first; word <= last; ++word)
+        {
+            UInt32 mask = ~0u;
+            if (word == first) mask &= ~0u << (x0 & 31);
+            if (word == last) mask &= ~0u >> (31 - (x1 & 31));
+            if (row[word] & mask)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TileGrid::GetCell(const Vector2& position, Int32& x, Int32& y) const
+    {
+        x = FloorToInt((position.x - m_origin.x) * m_inverseCellSize);
+        y = FloorToInt((position.y - m_origin.y) * m_inverseCellSize);
+    }
+
+    AABB TileGrid::GetCellBounds(const Int32 x, const Int32 y) const
+    {
+        const Vector2 min(m_origin.x + x * m_cellSize, m_origin.y + y * m_cellSize);
+        return AABB(min, Vector2(min.x + m_cellSize, min.y + m_cellSize));
+    }
+
+    bool TileGrid::IsColliding(const Vector2& point) const
+    {
+        Int32 x, y;
+        GetCell(point, x, y);
+        return IsSolid(x, y);
+    }
+
+    bool TileGrid::IsColliding(const AABB& aabb) const
+    {
+        const Int32 x0 = FloorToInt((aabb.min.x - m_origin.x) * m_inverseCellSize + CellEpsilon);
+        const Int32 x1 = CeilToInt((aabb.max.x - m_origin.x) * m_inverseCellSize - CellEpsilon) - 1;
+        const Int32 y0 = std::max(FloorToInt((aabb.min.y - m_origin.y) * m_inverseCellSize + CellEpsilon), 0);
+        const Int32 y1 = std::min(CeilToInt((aabb.max.y - m_origin.y) * m_inverseCellSize - CellEpsilon) - 1, static_cast<Int32>(m_height) - 1);
+
+        for (Int32 y = y0; y <= y1; ++y)
+        {
+            if (IsRowSolid(y, x0, x1))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool TileGrid::Raycast(const ace::Raycast& ray, const float length, Hit& hit) const
+    {
+        const float infinity = std::numeric_limits<float>::max();
+        const Vector2 start((ray.start - m_origin) * m_inverseCellSize);
+        const Vector2& direction = ray.unitDirection;
+        const float maxDistance = length * m_inverseCellSize;
+
+        // Clip to the grid first so a ray from far away doesn't walk empty cells.
+        float enter = 0.f, exit = maxDistance;
+        Int32 enterAxis = -1;
+        const float size[2] = { static_cast<float>(m_width), static_cast<float>(m_height) };
+        for (Int32 axis = 0; axis < 2; ++axis)
+        {
+            const float s = axis == 0 ? start.x : start.y;
+            const float d = axis == 0 ? direction.x : direction.y;
+            if (math::IsNearEpsilon(d))
+            {
+                if (s < 0.f || s > size[axis]) return false;
+                continue;
+            }
+            float t0 = (0.f - s) / d;
+            float t1 = (size[axis] - s) / d;
+            if (t0 > t1) std::swap(t0, t1);
+            if (t0 > enter) { enter = t0; enterAxis = axis; }
+            if (t1 < exit) exit = t1;
+        }
+        if (enter > exit)
+        {
+            return false;
+        }
+
+        Vector2 position(start + direction * enter);
+        Int32 x = std::min(std::max(FloorToInt(position.x), 0), static_cast<Int32>(m_width) - 1);
+        Int32 y = std::min(std::max(FloorToInt(position.y), 0), static_cast<Int32>(m_height) - 1);
+
+        const Int32 stepX = direction.x > 0.f ? 1 : -1;
+        const Int32 stepY = direction.y > 0.f ? 1 : -1;
+        const float deltaX = math::IsNearEpsilon(direction.x) ? infinity : math::Abs(1.f / direction.x);
+        const float deltaY = math::IsNearEpsilon(direction.y) ? infinity : math::Abs(1.f / direction.y);
+        float nextX = math::IsNearEpsilon(direction.x) ? infinity : enter + ((stepX > 0 ? x + 1 : x) - position.x) / direction.x;
+        float nextY = math::IsNearEpsilon(direction.y) ? infinity : enter + ((stepY > 0 ? y + 1 : y) - position.y) / direction.y;
+
+        float distance = enter;
+        Int32 axis = enterAxis;
+
+        while (distance <= exit && IsInside(x, y))
+        {
+            if (IsSolid(x, y))
+            {
+                hit.distance = distance * m_cellSize;
+                hit.position = ray.start + direction * hit.distance;
+                hit.normal = Vector2(
+                    axis == 0 ? static_cast<float>(-stepX) : 0.f,
+                    axis == 1 ? static_cast<float>(-stepY) : 0.f
+                );
+                hit.x = x;
+                hit.y = y;
+                return true;
+            }
+
+            if (nextX < nextY)
+            {
+                x += stepX;
+                distance = nextX;
+                nextX += deltaX;
+                axis = 0;
+            }
+            else
+            {
+                y += stepY;
+                distance = nextY;
+                nextY += deltaY;
+                axis = 1;
+            }
+        }
+        return false;
+    }
+
+    Vector2 TileGrid::Sweep(const AABB& aabb, const Vector2& motion, Vector2* normal) const
+    {
+        // Box and motion in cell units.
+        Vector2 min((aabb.min - m_origin) * m_inverseCellSize);
+        Vector2 max((aabb.max - m_origin) * m_inverseCellSize);
+        Vector2 delta(motion * m_inverseCellSize);
+        Vector2 contact;
+
+        for (Int32 axis = 0; axis < 2; ++axis)
+        {
+            float& move = axis == 0 ? delta.x : delta.y;
+            if (move == 0.f)
+            {
+                continue;
+            }
+
+            const float lowMin = axis == 0 ? min.x : min.y, lowMax = axis == 0 ? max.x : max.y;
+            const float sideMin = axis == 0 ? min.y : min.x, sideMax = axis == 0 ? max.y : max.x;
+
+            // Cells the box covers across the motion.
+            const Int32 side0 = FloorToInt(sideMin + CellEpsilon);
+            const Int32 side1 = CeilToInt(sideMax - CellEpsilon) - 1;
+
+            // Cells entered along the motion, nearest first.
+            Int32 first, last, step;
+            if (move > 0.f)
+            {
+                first = CeilToInt(lowMax - CellEpsilon);
+                last = CeilToInt(lowMax + move - CellEpsilon) - 1;
+                step = 1;
+            }
+            else
+            {
+                first = FloorToInt(lowMin + CellEpsilon) - 1;
+                last = FloorToInt(lowMin + move + CellEpsilon);
+                step = -1;
+            }
+
+            const Int32 limit = axis == 0 ? static_cast<Int32>(m_width) : static_cast<Int32>(m_height);
+            for (Int32 cell = first; step > 0 ? cell <= last : cell >= last; cell += step)
+            {
+                if (static_cast<UInt32>(cell) >= static_cast<UInt32>(limit))
+                {
+                    // Nothing further along this direction can be solid.
+                    if ((step > 0) == (cell >= limit)) break;
+                    continue;
+                }
+
+                bool blocked = false;
+                if (axis == 0)
+                {
+                    for (Int32 y = std::max(side0, 0); y <= side1 && y < static_cast<Int32>(m_height) && !blocked; ++y)
+                    {
+                        blocked = IsSolid(cell, y);
+                    }
+                }
+                else
+                {
+                    blocked = IsRowSolid(cell, side0, side1);
+                }
+
+                if (blocked)
+                {
+                    move = step > 0 ? cell - lowMax : (cell + 1) - lowMin;
+                    (axis == 0 ? contact.x : contact.y) = static_cast<float>(-step);
+                    break;
+                }
+            }
+
+            // Next axis starts from the moved box.
+            if (axis == 0)
+            {
+                min.x += move;
+                max.x += move;
+            }
+        }
+
+        if (normal != nullptr)
+        {
+            *normal = contact;
+        }
+        return delta * m_cellSize;
+    }
+
+    std::vector<AABB> TileGrid::Merge() const
+    {
+        std::vector<AABB> boxes;
+        std::vector<UInt32> remaining(m_bits);
+
+        const auto isRemaining = [&](const Int32 x, const Int32 y)
+        {
+            return (remaining[Word(x, y)] & Bit(x)) != 0u;
+        };
+
+        for (Int32 y = 0; y < static_cast<Int32>(m_height); ++y)
+        {
+            for (Int32 x = 0; x < static_cast<Int32>(m_width); ++x)
+            {
+                if (!isRemaining(x, y))
+                {
+                    continue;
+                }
+
+                // Widest run on this row, then grow up while the rows above cover it.
+                Int32 x1 = x;
+                while (x1 + 1 < static_cast<Int32>(m_width) && isRemaining(x1 + 1, y)) ++x1;
+
+                Int32 y1 = y;
+                for (bool full = true; full && y1 + 1 < static_cast<Int32>(m_height);)
+                {
+                    for (Int32 i = x; i <= x1 && full; ++i)
+                    {
+                        full = isRemaining(i, y1 + 1);
+                    }
+                    if (full) ++y1;
+                }
+
+                for (Int32 j = y; j <= y1; ++j)
+                {
+                    for (Int32 i = x; i <= x1; ++i)
+                    {
+                        remaining[Word(i, j)] &= ~Bit(i);
+                    }
+                }
+
+                boxes.emplace_back(GetCellBounds(x, y).min, GetCellBounds(x1, y1).max);
+                x = x1;
+            }
+        }
+        return boxes;
+    }
+
+}
@@ -1,4 +1,5 @@
 #include <Ace/Time.h>
+#include <Ace/Profiler.h>
 #include <SDL_timer.h>
 
 
@@ -24,30 +25,122 @@ namespace ace
 		return SDL_GetPerformanceFrequency();
 	}
 
+	// SDL's counter type, UInt64 is only 32 bits wide on some platforms.
+	static Uint64 s_frameStart;
+	static bool s_hasFrame = false;
+
 	static float s_deltaTime;
+	static float s_rawDeltaTime;
+
+	static double s_accumulator;
+	static float s_fixedTimeStep = 1.f / 60.f;
+	static float s_frameLimit = 0.f;
+
+	static const float MaxDeltaTime = 0.25f;
+	static const UInt32 MaxFixedSteps = 8u;
+
+	// Weight of the newest frame in the smoothed delta.
+	static const float DeltaSmoothing = 0.2f;
+
+	// SDL_Delay may wake a scheduler tick late, the end of a wait spins instead.
+	static const double SpinTime = 0.002;
+
+	static void WaitUntil(Uint64 target)
+	{
+		ACE_PROFILE_SCOPE("Time::WaitUntil");
+
+		const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+		Uint64 now = SDL_GetPerformanceCounter();
+		while (now < target)
+		{
+			const double remaining = static_cast<double>(target - now) / frequency;
+			if (remaining > SpinTime)
+			{
+				SDL_Delay(static_cast<Uint32>((remaining - SpinTime) * 1000.0));
+			}
+			now = SDL_GetPerformanceCounter();
+		}
+	}
 
 	float Time::DeltaTime()
 	{
 		return s_deltaTime;
 	}
 
+	float Time::RawDeltaTime()
+	{
+		return s_rawDeltaTime;
+	}
+
+	bool Time::FixedUpdate()
+	{
+		if (s_accumulator < s_fixedTimeStep)
+		{
+			return false;
+		}
+
+		s_accumulator -= s_fixedTimeStep;
+		return true;
+	}
+
+	void Time::SetFixedTimeStep(float seconds)
+	{
+		if (seconds > 0.f)
+		{
+			s_fixedTimeStep = seconds;
+		}
+	}
+
+	float Time::GetFixedTimeStep()
+	{
+		return s_fixedTimeStep;
+	}
+
+	float Time::GetAlpha()
+	{
+		return static_cast<float>(s_accumulator / s_fixedTimeStep);
+	}
+
+	void Time::SetFrameLimit(float framesPerSecond)
+	{
+		s_frameLimit = framesPerSecond > 0.f ? framesPerSecond : 0.f;
+	}
+
+	float Time::GetFrameLimit()
+	{
+		return s_frameLimit;
+	}
+
 	void Time::Update()
 	{
-		//static UInt64 s_now = 0;
-		//static UInt64 s_last = 0;
-        //
-		//s_last = s_now;
-		//s_now = GetPerformanceCounter();
-        //
-		//s_deltaTime = static_cast<float>(((s_now - s_last) / GetPerformanceFrequency())) / 1000.0f;
-
-        static UInt32 s_now = 0;
-        static UInt32 s_last = 0;
-        
-        s_last = s_now;
-        s_now = GetTicks();
-        
-        s_deltaTime = static_cast<float>(s_now - s_last) / 1000.0f;
+		const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+		if (s_hasFrame && s_frameLimit > 0.f)
+		{
+			WaitUntil(s_frameStart + static_cast<Uint64>(frequency / s_frameLimit));
+		}
+
+		const Uint64 now = SDL_GetPerformanceCounter();
+		if (!s_hasFrame)
+		{
+			// The first frame has no previous one, it counts as one fixed step.
+			s_frameStart = now - static_cast<Uint64>(s_fixedTimeStep * frequency);
+			s_deltaTime = s_fixedTimeStep;
+			s_hasFrame = true;
+		}
+
+		const double elapsed = static_cast<double>(now - s_frameStart) / frequency;
+		s_frameStart = now;
+
+		s_rawDeltaTime = elapsed < MaxDeltaTime ? static_cast<float>(elapsed) : MaxDeltaTime;
+		s_deltaTime += (s_rawDeltaTime - s_deltaTime) * DeltaSmoothing;
+
+		s_accumulator += s_rawDeltaTime;
+		if (s_accumulator > MaxFixedSteps * s_fixedTimeStep)
+		{
+			s_accumulator = MaxFixedSteps * s_fixedTimeStep;
+		}
 	}
 
 	bool Time::WaitTime::IsDone()
@@ -1,5 +1,6 @@
 #include <Ace/UserInterface.h>
 #include <Ace/Assert.h>
+#include <Ace/GraphicsDevice.h>
 #include <Ace/Macros.h>
 #include <Ace/Platform.h>
 #include <Ace/Window.h>
@@ -533,7 +534,7 @@ namespace ace
     }
 
 
-    void UserInterface::Debug(const Vector2* size, const Vector2* position)
+    void UserInterface::Debug(const Vector2* size, const Vector2* position, bool renderStats)
     {
         //The easiest way is to create a dummy window.
         //Call Begin() with NoTitleBar | NoResize | NoMove | NoScrollbar | NoSavedSettings | NoInputs flag
@@ -542,6 +543,15 @@ namespace ace
 
         BeginGroup(size ? *size : Vector2(60.f, 60.f), position ? *position : Vector2(0.f, 0.f), s_windowFlags | ImGuiWindowFlags_NoCollapse);
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+
+        if (renderStats)
+        {
+            const RenderStats& stats = GraphicsDevice::GetStats();
+            ImGui::Text("Draw calls %u, vertices %u, indices %u", stats.drawCalls, stats.vertices, stats.indices);
+            ImGui::Text("Uploaded %.1f KB", stats.bytesUploaded / 1024.f);
+            ImGui::Text("Binds: programs %u, textures %u, uniforms %u", stats.programBinds, stats.textureBinds, stats.uniformUploads);
+            ImGui::Text("Sprites batched %u, culled %u", stats.spritesBatched, stats.spritesCulled);
+        }
         EndGroup();
     }
 
@@ -63,8 +63,9 @@ namespace ace
 
         Vector2& Vector2::operator*=(const Matrix2& m)
         {
-            x = (m(0, 0) * x) + (m(0, 1) * y);
-            y = (m(1, 0) * x) + (m(1, 1) * y);
+            const float temp = x;
+            x = (m(0, 0) * temp) + (m(0, 1) * y);
+            y = (m(1, 0) * temp) + (m(1, 1) * y);
             return *this;
         }
         Vector2 operator*(Vector2 lhs, const Matrix2& rhs)
@@ -0,0 +1,153 @@
+// acemixbench - measures ace::AudioMixer mix time without an audio device.
+//
+// Usage: acemixbench [-v voices] [-s seconds] [-r rate] [-o output.raw]
+//   -v voices   Playing voices, 256 by default, at most AudioMixer::MaxVoices.
+//   -s seconds  Length of audio mixed, 10 by default.
+//   -r rate     Output sample rate, 44100 by default.
+//   -o file     Also writes the mix as raw 16-bit stereo, to check it by ear.
+//
+// Voices get pseudo-random pitch, gain and position from a fixed seed, so runs are comparable.
+
+#include <Ace/AudioMixer.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ace;
+
+// Deterministic across platforms, unlike rand().
+static UInt32 s_seed = 12345u;
+
+static float Random(const float min, const float max)
+{
+    s_seed = s_seed * 1664525u + 1013904223u;
+    return min + (max - min) * static_cast<float>(s_seed >> 8u) / 16777216.f;
+}
+
+// One second of a decaying tone, stereo buffers are detuned between channels.
+static std::shared_ptr<PCMBuffer> MakeTone(const UInt32 channels, const UInt32 frequency, const float pitch)
+{
+    auto buffer = std::make_shared<PCMBuffer>();
+    buffer->channels = channels;
+    buffer->frequency = frequency;
+    buffer->frames = frequency;
+    buffer->samples.resize(buffer->frames * channels);
+
+    for (UInt32 i = 0u; i < buffer->frames; ++i)
+    {
+        const float t = static_cast<float>(i) / frequency;
+        for (UInt32 c = 0u; c < channels; ++c)
+        {
+            const float tone = std::sin(6.2831853f * pitch * (1.f + 0.01f * c) * t) * std::exp(-3.f * t);
+            buffer->samples[i * channels + c] = static_cast<Int16>(tone * 12000.f);
+        }
+    }
+    return buffer;
+}
+
+int main(int argc, char** argv)
+{
+    UInt32 voices = AudioMixer::MaxVoices;
+    float seconds = 10.f;
+    UInt32 rate = 44100u;
+    std::string output;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 < argc && arg == "-v")
+        {
+            voices = static_cast<UInt32>(std::atoi(argv[++i]));
+        }
+        else if (i + 1 < argc && arg == "-s")
+        {
+            seconds = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (i + 1 < argc && arg == "-r")
+        {
+            rate = static_cast<UInt32>(std::atoi(argv[++i]));
+        }
+        else if (i + 1 < argc && arg == "-o")
+        {
+            output = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: acemixbench [-v voices] [-s seconds] [-r rate] [-o output.raw]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (voices > AudioMixer::MaxVoices || rate == 0u || seconds <= 0.f)
+    {
+        std::cerr << "acemixbench: at most " << AudioMixer::MaxVoices << " voices, rate and seconds must be positive" << std::endl;
+        return 1;
+    }
+
+    // Sources at other rates than the output, so every voice is resampled.
+    const std::shared_ptr<const PCMBuffer> buffers[] = {
+        MakeTone(1u, 22050u, 440.f),
+        MakeTone(1u, 48000u, 660.f),
+        MakeTone(2u, 44100u, 220.f),
+    };
+
+    AudioMixer mixer(rate);
+    const float listener[3] = { 0.f, 0.f, 0.f };
+    const float forward[3] = { 0.f, 0.f, -1.f };
+    const float up[3] = { 0.f, 1.f, 0.f };
+    mixer.SetListener(listener, forward, up);
+    mixer.SetMasterGain(1.f / 16.f);
+
+    for (UInt32 i = 0u; i < voices; ++i)
+    {
+        const Int32 voice = mixer.Play(buffers[i % 3u], Random(0.2f, 1.f), Random(0.5f, 2.f), true);
+        if (i % 2u == 0u)
+        {
+            const float position[3] = { Random(-20.f, 20.f), 0.f, Random(-20.f, 20.f) };
+            mixer.SetPosition(voice, position);
+        }
+    }
+
+    // Blocks the size a 60 Hz update or an OpenAL stream refill would ask for.
+    const UInt32 blockFrames = 1024u;
+    const UInt32 blocks = static_cast<UInt32>(seconds * rate / blockFrames) + 1u;
+    std::vector<Int16> block(blockFrames * 2u);
+
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output.c_str(), std::ios::binary);
+    }
+
+    double total = 0.0, worst = 0.0;
+    for (UInt32 i = 0u; i < blocks; ++i)
+    {
+        // Gain changes every block, so ramps are always active.
+        mixer.SetGain(static_cast<Int32>(i % voices), Random(0.2f, 1.f));
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        mixer.Mix(block.data(), blockFrames);
+        const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        total += elapsed;
+        worst = elapsed > worst ? elapsed : worst;
+
+        if (file)
+        {
+            file.write(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(Int16));
+        }
+    }
+
+    const double audio = static_cast<double>(blocks) * blockFrames / rate * 1000.0;
+    std::cout << voices << " voices, " << blocks << " blocks of " << blockFrames << " frames at " << rate << " Hz" << std::endl;
+    std::cout << "mix time: " << total / blocks << " ms per block, " << worst << " ms worst" << std::endl;
+    std::cout << "load: " << 100.0 * total / audio << "% of real time, " << audio / total << "x faster than real time" << std::endl;
+    return 0;
+}
@@ -0,0 +1,293 @@
+// acepack - packs asset files into an archive for ace::Archive.
+//
+// Usage: acepack [-c] <archive> <root> [files...]
+//   -c       LZ4 compress entries that shrink by at least 1/8.
+//   archive  Output file.
+//   root     Directory the file paths are relative to, usually the directory of the executable.
+//   files    Relative paths of the files to pack. Read from stdin, one per line, if omitted:
+//            cd build/Bin && find assets -type f | acepack -c assets.pak .
+
+#include <Ace/ArchiveFormat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ace;
+
+struct PackedFile
+{
+    std::string name;
+    std::vector<UInt8> data;
+    UInt32 size;
+    UInt32 flags;
+};
+
+static std::string NormalizeName(std::string name)
+{
+    for (auto& itr : name)
+    {
+        if (itr == '\\') itr = '/';
+    }
+    while (name.compare(0u, 2u, "./") == 0)
+    {
+        name.erase(0u, 2u);
+    }
+    return name;
+}
+
+static bool ReadFile(const std::string& path, std::vector<UInt8>& data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    return data.empty() || file.read(reinterpret_cast<char*>(data.data()), data.size()).good();
+}
+
+static void WriteLength(std::vector<UInt8>& out, UInt32 length)
+{
+    while (length >= 255u)
+    {
+        out.push_back(255u);
+        length -= 255u;
+    }
+    out.push_back(static_cast<UInt8>(length));
+}
+
+static void WriteSequence(std::vector<UInt8>& out, const UInt8* literals, const UInt32 literalCount, const UInt32 offset, const UInt32 matchLength)
+{
+    const UInt32 match = matchLength >= 4u ? matchLength - 4u : 0u;
+    out.push_back(static_cast<UInt8>(((literalCount < 15u ? literalCount : 15u) << 4u) | (match < 15u ? match : 15u)));
+
+    if (literalCount >= 15u)
+    {
+        WriteLength(out, literalCount - 15u);
+    }
+    out.insert(out.end(), literals, literals + literalCount);
+
+    if (matchLength == 0u)
+    {
+        return;
+    }
+
+    out.push_back(static_cast<UInt8>(offset & 0xFFu));
+    out.push_back(static_cast<UInt8>(offset >> 8u));
+    if (match >= 15u)
+    {
+        WriteLength(out, match - 15u);
+    }
+}
+
+// Greedy single-probe LZ4 block compressor. Follows the block format end rules:
+// the last 5 bytes are literals and no match starts in the last 12 bytes.
+static std::vector<UInt8> CompressLZ4(const std::vector<UInt8>& source)
+{
+    const UInt32 size = static_cast<UInt32>(source.size());
+    const UInt8* data = source.data();
+
+    std::vector<UInt8> out;
+    out.reserve(size + size / 255u + 16u);
+
+    std::vector<Int32> table(1u << 16u, -1);
+    const auto read32 = [data](const UInt32 position)
+    {
+        UInt32 value;
+        std::memcpy(&value, data + position, sizeof(value));
+        return value;
+    };
+
+    UInt32 anchor = 0u;
+    UInt32 position = 0u;
+    const UInt32 matchLimit = size > 12u ? size - 12u : 0u;
+
+    while (position < matchLimit)
+    {
+        const UInt32 hash = (read32(position) * 2654435761u) >> 16u;
+        const Int32 candidate = table[hash];
+        table[hash] = static_cast<Int32>(position);
+
+        if (candidate < 0 || position - candidate > 65535u || read32(candidate) != read32(position))
+        {
+            ++position;
+            continue;
+        }
+
+        UInt32 length = 4u;
+        while (position + length < size - 5u && data[candidate + length] == data[position + length])
+        {
+            ++length;
+        }
+
+        WriteSequence(out, data + anchor, position - anchor, position - candidate, length);
+        position += length;
+        anchor = position;
+    }
+
+    WriteSequence(out, data + anchor, size - anchor, 0u, 0u);
+    return out;
+}
+
+static UInt32 Align(const UInt32 value)
+{
+    return (value + ArchiveAlignment - 1u) & ~(ArchiveAlignment - 1u);
+}
+
+int main(int argc, char** argv)
+{
+    bool compress = false;
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-c") == 0)
+        {
+            compress = true;
+        }
+        else
+        {
+            args.push_back(argv[i]);
+        }
+    }
+
+    if (args.size() < 2u)
+    {
+        std::cerr << "Usage: acepack [-c] <archive> <root> [files...]\n";
+        return 1;
+    }
+
+    const std::string output = args[0];
+    std::string root = args[1];
+    if (!root.empty() && root.back() != '/' && root.back() != '\\')
+    {
+        root.push_back('/');
+    }
+
+    std::vector<std::string> paths(args.begin() + 2, args.end());
+    if (paths.empty())
+    {
+        for (std::string line; std::getline(std::cin, line);)
+        {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty()) paths.push_back(line);
+        }
+    }
+
+    std::vector<PackedFile> files;
+    files.reserve(paths.size());
+
+    UInt64 totalSize = 0u, totalPacked = 0u;
+
+    for (const auto& itr : paths)
+    {
+        PackedFile file;
+        file.name = NormalizeName(itr);
+        file.flags = ArchiveNone;
+
+        if (!ReadFile(root + file.name, file.data))
+        {
+            std::cerr << "acepack: cannot read " << root + file.name << '\n';
+            return 1;
+        }
+        file.size = static_cast<UInt32>(file.data.size());
+
+        if (compress && file.size > 0u)
+        {
+            std::vector<UInt8> packed = CompressLZ4(file.data);
+            if (packed.size() + packed.size() / 7u < file.data.size())
+            {
+                file.data.swap(packed);
+                file.flags = ArchiveLZ4;
+            }
+        }
+
+        totalSize += file.size;
+        totalPacked += file.data.size();
+        files.push_back(std::move(file));
+    }
+
+    // Hash table at most half full keeps probe sequences short.
+    UInt32 bucketCount = 1u;
+    while (bucketCount <= files.size() * 2u)
+    {
+        bucketCount <<= 1u;
+    }
+
+    ArchiveHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = ArchiveMagic;
+    header.version = ArchiveVersion;
+    header.entryCount = static_cast<UInt32>(files.size());
+    header.bucketCount = bucketCount;
+    header.namesOffset = sizeof(ArchiveHeader) + bucketCount * sizeof(UInt32) + header.entryCount * sizeof(ArchiveEntry);
+
+    std::vector<UInt32> buckets(bucketCount, 0u);
+    std::vector<ArchiveEntry> entries(files.size());
+    std::string nameTable;
+
+    for (UInt32 i = 0u; i < files.size(); ++i)
+    {
+        ArchiveEntry& entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        entry.nameOffset = static_cast<UInt32>(nameTable.size());
+        entry.nameLength = static_cast<UInt32>(files[i].name.size());
+        entry.hash = ArchiveHash(files[i].name.c_str(), entry.nameLength);
+        entry.size = files[i].size;
+        entry.packedSize = static_cast<UInt32>(files[i].data.size());
+        entry.flags = files[i].flags;
+        nameTable += files[i].name;
+
+        UInt32 bucket = entry.hash & (bucketCount - 1u);
+        for (; buckets[bucket] != 0u; bucket = (bucket + 1u) & (bucketCount - 1u))
+        {
+            const ArchiveEntry& other = entries[buckets[bucket] - 1u];
+            if (other.hash == entry.hash && files[buckets[bucket] - 1u].name == files[i].name)
+            {
+                std::cerr << "acepack: duplicate entry " << files[i].name << '\n';
+                return 1;
+            }
+        }
+        buckets[bucket] = i + 1u;
+    }
+
+    header.namesSize = static_cast<UInt32>(nameTable.size());
+
+    UInt32 offset = Align(header.namesOffset + header.namesSize);
+    for (auto& itr : entries)
+    {
+        itr.offset = offset;
+        offset = Align(offset + itr.packedSize);
+    }
+
+    std::ofstream out(output, std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "acepack: cannot write " << output << '\n';
+        return 1;
+    }
+
+    const char padding[ArchiveAlignment] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(buckets.data()), buckets.size() * sizeof(UInt32));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ArchiveEntry));
+    out.write(nameTable.data(), nameTable.size());
+
+    UInt32 written = header.namesOffset + header.namesSize;
+    for (UInt32 i = 0u; i < files.size(); ++i)
+    {
+        out.write(padding, entries[i].offset - written);
+        out.write(reinterpret_cast<const char*>(files[i].data.data()), files[i].data.size());
+        written = entries[i].offset + entries[i].packedSize;
+    }
+
+    std::printf("acepack: %u files, %lu bytes -> %lu bytes\n", header.entryCount,
+        static_cast<unsigned long>(totalSize), static_cast<unsigned long>(totalPacked));
+    return out.good() ? 0 : 1;
+}
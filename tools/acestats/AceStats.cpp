@@ -0,0 +1,105 @@
+// acestats - checks ace::RenderStats counting against a stub GraphicsDevice backend, without a GPU.
+//
+// Usage: acestats
+//
+// The stub backend counts through the same RenderStats.cpp helpers as the OpenGL backend and replays
+// the calls SpriteManager makes for its batches. Prints each mismatch, exits with 1 if there was one.
+
+#include <Ace/GraphicsDevice.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace ace;
+
+// Stub backend, only what the checks below call. Buffers never get an implementation.
+namespace ace
+{
+    static void DestroyBuffer(BufferImpl*)
+    {
+
+    }
+
+    template<> GraphicsObject<BufferImpl>::DestructorFunc GraphicsObject<BufferImpl>::s_destructor = DestroyBuffer;
+
+    void Buffer::Init() const
+    {
+
+    }
+
+    void GraphicsDevice::Present(Window&)
+    {
+        EndStatsFrame();
+    }
+
+    void GraphicsDevice::BufferData(Buffer&, UInt32 count, const Vertex*, BufferUsage, UInt32 instances)
+    {
+        CountUpload(count * sizeof(Vertex) * (instances > 0u ? instances : 1u));
+    }
+
+    void GraphicsDevice::Draw(UInt32 elements, UInt32 indicies, const UInt32*)
+    {
+        ++CountStats().programBinds;
+        CountDraw(elements, indicies);
+    }
+}
+
+static UInt32 s_failures = 0u;
+
+static void Check(const char* what, const UInt32 value, const UInt32 expected)
+{
+    if (value != expected)
+    {
+        std::cerr << what << ": " << value << ", expected " << expected << std::endl;
+        ++s_failures;
+    }
+}
+
+// Batches of at most 64 sprites, as SpriteManager::Draw issues them.
+static void DrawBatch(Buffer& buffer, const std::vector<Vertex>& vertices, const UInt32* indexTable)
+{
+    const UInt32 sprites = static_cast<UInt32>(vertices.size() / 4u);
+    GraphicsDevice::BufferData(buffer, sprites * 4u, vertices.data(), BufferUsage::Streaming);
+
+    for (UInt32 first = 0u; first < sprites; first += 64u)
+    {
+        const UInt32 elementsCount = sprites - first < 64u ? sprites - first : 64u;
+        GraphicsDevice::Draw(elementsCount * 4u, elementsCount * 6u, indexTable);
+    }
+}
+
+int main()
+{
+    Window* window = nullptr;
+    VertexBuffer buffer;
+    const std::vector<Vertex> vertices(150u * 4u);
+    const std::vector<UInt32> indexTable(64u * 6u);
+
+    DrawBatch(buffer, vertices, indexTable.data());
+
+    // Non-indexed, as a Mesh without an index buffer.
+    GraphicsDevice::Draw(3u, 0u);
+
+    const RenderStats& frame = GraphicsDevice::GetFrameStats();
+    Check("draw calls", frame.drawCalls, 4u);
+    Check("vertices", frame.vertices, 150u * 4u + 3u);
+    Check("indices", frame.indices, 150u * 6u);
+    Check("bytes uploaded", frame.bytesUploaded, static_cast<UInt32>(150u * 4u * sizeof(Vertex)));
+    Check("program binds", frame.programBinds, 4u);
+
+    GraphicsDevice::Present(*window);
+
+    const RenderStats& last = GraphicsDevice::GetStats();
+    Check("presented draw calls", last.drawCalls, 4u);
+    Check("presented vertices", last.vertices, 150u * 4u + 3u);
+    Check("new frame draw calls", GraphicsDevice::GetFrameStats().drawCalls, 0u);
+    Check("new frame bytes uploaded", GraphicsDevice::GetFrameStats().bytesUploaded, 0u);
+
+    if (s_failures != 0u)
+    {
+        std::cerr << s_failures << " render statistics checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "Render statistics match" << std::endl;
+    return 0;
+}
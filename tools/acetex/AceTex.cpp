@@ -0,0 +1,166 @@
+// acetex - bakes an image into a texture that ace::Texture uploads without decoding.
+//
+// Usage: acetex [-m] [-l] [-c] [-s scale] <input> <output.acetex>
+//   -m        Generate the full mip chain, down to 1x1.
+//   -l        Linear filtering, nearest by default.
+//   -c        Clamp UVs, repeat by default.
+//   -s scale  Pixels per unit, 1000 by default like Image.
+//   input     Any image stb_image decodes, e.g. PNG.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <Ace/TextureFormat.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ace;
+
+struct Level
+{
+    UInt32 width;
+    UInt32 height;
+    std::vector<UInt8> pixels;
+};
+
+// 2x2 box filter, the last row or column is repeated for odd sizes.
+static Level Downsample(const Level& source, const UInt32 components)
+{
+    Level level;
+    level.width = source.width > 1u ? source.width / 2u : 1u;
+    level.height = source.height > 1u ? source.height / 2u : 1u;
+    level.pixels.resize(level.width * level.height * components);
+
+    for (UInt32 y = 0u; y < level.height; ++y)
+    {
+        const UInt32 y0 = std::min(y * 2u, source.height - 1u);
+        const UInt32 y1 = std::min(y * 2u + 1u, source.height - 1u);
+
+        for (UInt32 x = 0u; x < level.width; ++x)
+        {
+            const UInt32 x0 = std::min(x * 2u, source.width - 1u);
+            const UInt32 x1 = std::min(x * 2u + 1u, source.width - 1u);
+
+            for (UInt32 c = 0u; c < components; ++c)
+            {
+                const UInt32 sum =
+                    source.pixels[(y0 * source.width + x0) * components + c] +
+                    source.pixels[(y0 * source.width + x1) * components + c] +
+                    source.pixels[(y1 * source.width + x0) * components + c] +
+                    source.pixels[(y1 * source.width + x1) * components + c];
+                level.pixels[(y * level.width + x) * components + c] = static_cast<UInt8>((sum + 2u) / 4u);
+            }
+        }
+    }
+    return level;
+}
+
+static UInt32 Align(const UInt32 value)
+{
+    return (value + TextureFileAlignment - 1u) & ~(TextureFileAlignment - 1u);
+}
+
+int main(int argc, char** argv)
+{
+    bool mipmaps = false, linear = false, clamp = false;
+    float scale = 1000.f;
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-m") == 0) mipmaps = true;
+        else if (std::strcmp(argv[i], "-l") == 0) linear = true;
+        else if (std::strcmp(argv[i], "-c") == 0) clamp = true;
+        else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) scale = static_cast<float>(std::atof(argv[++i]));
+        else args.push_back(argv[i]);
+    }
+
+    if (args.size() != 2u)
+    {
+        std::cerr << "Usage: acetex [-m] [-l] [-c] [-s scale] <input> <output.acetex>\n";
+        return 1;
+    }
+
+    int width = 0, height = 0, components = 0;
+    UInt8* pixels = stbi_load(args[0].c_str(), &width, &height, &components, 0);
+    if (pixels == nullptr)
+    {
+        std::cerr << "acetex: cannot decode " << args[0] << ": " << stbi_failure_reason() << '\n';
+        return 1;
+    }
+
+    std::vector<Level> levels(1u);
+    levels[0].width = static_cast<UInt32>(width);
+    levels[0].height = static_cast<UInt32>(height);
+    levels[0].pixels.assign(pixels, pixels + width * height * components);
+    stbi_image_free(pixels);
+
+    while (mipmaps && levels.size() < TextureFileMaxLevels && (levels.back().width > 1u || levels.back().height > 1u))
+    {
+        levels.push_back(Downsample(levels.back(), static_cast<UInt32>(components)));
+    }
+
+    if (mipmaps && (levels.back().width > 1u || levels.back().height > 1u))
+    {
+        std::cerr << "acetex: image too large for a full mip chain\n";
+        return 1;
+    }
+
+    TextureFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = TextureFileMagic;
+    header.version = TextureFileVersion;
+    header.width = levels[0].width;
+    header.height = levels[0].height;
+    header.format = static_cast<UInt32>(components); // PixelFormat R = 1 ... RGBA = 4, same as stb_image.
+    header.compression = TextureUncompressed;
+    header.levelCount = static_cast<UInt32>(levels.size());
+    header.scale = scale;
+    header.minFiltering = linear ? 1u : 0u;
+    header.magFiltering = linear ? 1u : 0u;
+    header.wrapModes = clamp ? 1u : 0u;
+    header.mipmaps = mipmaps ? 1u : 0u;
+
+    std::vector<TextureFileLevel> table(levels.size());
+    UInt32 offset = Align(sizeof(TextureFileHeader) + header.levelCount * sizeof(TextureFileLevel));
+    UInt32 total = 0u;
+
+    for (UInt32 i = 0u; i < levels.size(); ++i)
+    {
+        table[i].offset = offset;
+        table[i].size = static_cast<UInt32>(levels[i].pixels.size());
+        table[i].width = levels[i].width;
+        table[i].height = levels[i].height;
+        offset = Align(offset + table[i].size);
+        total += table[i].size;
+    }
+
+    std::ofstream out(args[1], std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "acetex: cannot write " << args[1] << '\n';
+        return 1;
+    }
+
+    const char padding[TextureFileAlignment] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(TextureFileLevel));
+
+    UInt32 written = sizeof(TextureFileHeader) + header.levelCount * sizeof(TextureFileLevel);
+    for (UInt32 i = 0u; i < levels.size(); ++i)
+    {
+        out.write(padding, table[i].offset - written);
+        out.write(reinterpret_cast<const char*>(levels[i].pixels.data()), levels[i].pixels.size());
+        written = table[i].offset + table[i].size;
+    }
+
+    std::cout << "acetex: " << width << 'x' << height << ", " << components << " channels, "
+        << levels.size() << " levels, " << total << " bytes\n";
+    return out.good() ? 0 : 1;
+}